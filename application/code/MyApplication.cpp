@@ -9,6 +9,7 @@
 #include <xos/filesystem.h>
 #include <xos/info.h>
 
+#include <cstddef>
 #include <iostream>
 
 #include "light.h"
@@ -54,8 +55,12 @@ MyApplication::MyApplication( )
         .with<DeviceFeatureFlags>(
             DeviceFeatureFlags::SWAPCHAIN_EXT | DeviceFeatureFlags::ANISOTROPIC_SAMPLING |
             DeviceFeatureFlags::DYNAMIC_RENDERING_EXT | DeviceFeatureFlags::SYNCHRONIZATION_2_EXT |
-            DeviceFeatureFlags::SHADER_IMAGE_ARRAY_NON_UNIFORM_INDEXING )
-        .with<ValidationLayers>( ValidationFlags::KHRONOS_VALIDATION, ::debug::debug_callback )
+            DeviceFeatureFlags::SHADER_IMAGE_ARRAY_NON_UNIFORM_INDEXING | DeviceFeatureFlags::MULTI_DRAW_INDIRECT |
+            DeviceFeatureFlags::DRAW_INDIRECT_COUNT )
+        // Without block compression the model textures are decoded from their sources.
+        .with<OptionalDeviceFeatures>( OptionalDeviceFeatures{ DeviceFeatureFlags::TEXTURE_COMPRESSION_BC } )
+        .with<ValidationLayers>( ValidationFlags::KHRONOS_VALIDATION | ValidationFlags::SYNCHRONIZATION_VALIDATION,
+                                 ::debug::debug_callback )
     );
 
     // 3. Set the proper root directory to find shader modules and textures.
@@ -83,7 +88,8 @@ MyApplication::MyApplication( )
         .device = &context_->device( ),
         .cmd_pool = command_pool_.get( ),
         .swapchain = swapchain_.get( ),
-        .max_frames_in_flight = MAX_FRAMES_IN_FLIGHT_
+        .max_frames_in_flight = MAX_FRAMES_IN_FLIGHT_,
+        .deletion_queue = &CVK.deletion_queue( )
     } );
     renderer_->set_record_command_buffer_fn(
         std::bind( &MyApplication::record_command_buffer, this,
@@ -111,10 +117,33 @@ MyApplication::MyApplication( )
     create_shadow_map_images( SHADOW_MAP_SIZE_ );
 
     // 8. Graphic pipelines
+    shader_library_ = CVK.create_resource<shader::ShaderLibrary>( context_->device( ) );
+    pipeline_cache_ = CVK.create_resource<PipelineCache>( context_->device( ), PIPELINE_CACHE_PATH_ );
     create_pipelines( );
 
-    // 9. Model
-    model_ = CVK.create_resource<Model>( context_->device( ), *command_pool_, loader::AssimpModelLoader{ MODEL_PATH_ } );
+    // 9. Model, imported on a loader thread. Materials point at the fallback texture until it is published.
+    model_ = CVK.create_resource<AsyncModel>( context_->device( ), std::make_unique<loader::BakedModelLoader>( MODEL_PATH_ ),
+                                              ModelCreateInfo{
+                                                  .vertex_layout = VERTEX_LAYOUT_,
+                                                  .streaming = { .frames_in_flight = MAX_FRAMES_IN_FLIGHT_ },
+                                                  .draw_view_count = MAX_FRAMES_IN_FLIGHT_ + LIGHT_COUNT_
+                                              } );
+    model_->on_loaded.bind( this, &MyApplication::model_loaded );
+
+    fallback_texture_ = CVK.create_resource<TextureImage>(
+        context_->device( ), *command_pool_,
+        TextureImageCreateInfo{ .path_to_img = FALLBACK_TEXTURE_PATH_, .image_format = VK_FORMAT_R8G8B8A8_SRGB } );
+
+    fallback_surface_buffer_ = CVK.create_resource<Buffer>(
+        context_->device( ), sizeof( SurfaceMap ), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+    {
+        SurfaceMap fallback_surface{};
+        fallback_surface.base.indices  = glm::uvec4{ 0u };
+        fallback_surface.extra.indices = glm::uvec4{ 0u };
+        fallback_surface_buffer_->map_memory( );
+        fallback_surface_buffer_->write( &fallback_surface, sizeof( SurfaceMap ) );
+    }
 
     // 10. Buffers
     create_uniform_buffers( );
@@ -162,14 +191,17 @@ void MyApplication::run( )
             continue;
         }
 
-        // 3.4 Render
+        // 3.4 Publish the model once its loader thread is done
+        model_->poll( );
+
+        // 3.5 Render
         if ( auto const render_result = renderer_->render( );
             render_result == VK_ERROR_OUT_OF_DATE_KHR || render_result == VK_SUBOPTIMAL_KHR )
         {
             window_->force_framebuffer_resize( );
         }
 
-        // 3.5 Check if the window should close
+        // 3.6 Check if the window should close
         running_ = not window_->should_close( );
     }
 }
@@ -193,6 +225,9 @@ void MyApplication::create_descriptor_allocator( )
 
                 // Lights Buffer
                 { VK_SHADER_STAGE_FRAGMENT_BIT, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER },
+
+                // Irradiance SH Buffer
+                { VK_SHADER_STAGE_FRAGMENT_BIT, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER },
             } )
         .define(
             "l_textures",
@@ -241,10 +276,22 @@ void MyApplication::create_descriptor_allocator( )
                      // Shadow Map Depth Images
                      { VK_SHADER_STAGE_FRAGMENT_BIT, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, LIGHT_COUNT_ }
                  } )
+        .define( "l_cull",
+                 {
+                     // Mesh Cull Buffer
+                     { VK_SHADER_STAGE_COMPUTE_BIT, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER },
+
+                     // Draw Buffer
+                     { VK_SHADER_STAGE_COMPUTE_BIT, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER },
+
+                     // Draw Count Buffer
+                     { VK_SHADER_STAGE_COMPUTE_BIT, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER }
+                 } )
         .alloc( "buffer", "l_buffer", MAX_FRAMES_IN_FLIGHT_ )
         .alloc( "textures", "l_textures", MAX_FRAMES_IN_FLIGHT_ )
         .alloc( "cube_textures", "l_cube_textures", 1u )
-        .alloc( "shadow_textures", "l_shadow_textures", 1u ) );
+        .alloc( "shadow_textures", "l_shadow_textures", 1u )
+        .alloc( "cull", "l_cull", 1u ) );
 }
 
 
@@ -308,18 +355,28 @@ void MyApplication::create_uniform_buffers( )
     }
 
     // lights
-    {
-        // Calculate light views and projections
-        auto const [aabb_min, aabb_max] = model_->aabb( );
-        for ( LightData& light : lights_ )
-        {
-            light::populate_directional_shadow_map_data( light, aabb_min, aabb_max );
-        }
+    lights_buffer_ = CVK.create_resource<Buffer>(
+        buffer::make_uniform_buffer( context_->device( ), sizeof( LightData ) * lights_.size( ) ) );
+    write_lights_data( );
+
+    // irradiance sh, black until the environment is projected
+    irradiance_sh_buffer_ = CVK.create_resource<Buffer>(
+        buffer::make_uniform_buffer( context_->device( ), sizeof( image::SH9Irradiance ) ) );
+    image::SH9Irradiance const black_irradiance{};
+    irradiance_sh_buffer_->write( &black_irradiance, sizeof( image::SH9Irradiance ) );
+}
 
-        lights_buffer_ = CVK.create_resource<Buffer>(
-            buffer::make_uniform_buffer( context_->device( ), sizeof( LightData ) * lights_.size( ) ) );
-        lights_buffer_->write( lights_.data( ), sizeof( LightData ) * lights_.size( ) );
+
+void MyApplication::write_lights_data( )
+{
+    // Calculate light views and projections, the shadow maps are fitted to a placeholder volume until the model is loaded.
+    auto const [aabb_min, aabb_max] =
+            model_->is_ready( ) ? model_->model( ).aabb( ) : std::pair{ glm::vec3{ -1.f }, glm::vec3{ 1.f } };
+    for ( LightData& light : lights_ )
+    {
+        light::populate_directional_shadow_map_data( light, aabb_min, aabb_max );
     }
+    lights_buffer_->write( lights_.data( ), sizeof( LightData ) * lights_.size( ) );
 }
 
 
@@ -331,6 +388,7 @@ void MyApplication::create_pipelines( )
         DescriptorSet const* const texes_set        = &descriptor_allocator_->set_at( "textures" );
         DescriptorSet const* const cube_texes_set   = &descriptor_allocator_->set_at( "cube_textures" );
         DescriptorSet const* const shadow_texes_set = &descriptor_allocator_->set_at( "shadow_textures" );
+        DescriptorSet const* const cull_set         = &descriptor_allocator_->set_at( "cull" );
 
         cubemap_sampling_pipeline_layout_ = CVK.create_resource<PipelineLayout>(
             context_->device( ), std::array{ cube_texes_set },
@@ -343,16 +401,9 @@ void MyApplication::create_pipelines( )
                 },
             } );
 
+        // The surface ID arrives as the first instance of every indirect draw.
         sampling_pipeline_layout_ = CVK.create_resource<PipelineLayout>(
-            context_->device( ), std::array{ buffer_set, texes_set },
-            std::array{
-                // Surface ID
-                VkPushConstantRange{
-                    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-                    .offset = 0u,
-                    .size = sizeof( uint32_t )
-                },
-            } );
+            context_->device( ), std::array{ buffer_set, texes_set } );
 
         processing_pipeline_layout_ = CVK.create_resource<PipelineLayout>(
             context_->device( ), std::array{ buffer_set, texes_set, cube_texes_set, shadow_texes_set },
@@ -364,6 +415,17 @@ void MyApplication::create_pipelines( )
                     .size = sizeof( glm::vec3 )
                 }
             } );
+
+        cull_pipeline_layout_ = CVK.create_resource<PipelineLayout>(
+            context_->device( ), std::array{ cull_set },
+            std::array{
+                // Frustum and level of detail parameters of the view
+                VkPushConstantRange{
+                    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                    .offset = 0u,
+                    .size = sizeof( DrawCullConstants )
+                }
+            } );
     }
 
     // Specialization infos
@@ -374,89 +436,123 @@ void MyApplication::create_pipelines( )
         .pData = &TEXTURE_COUNT_
     };
 
+    struct LightingSpecialization
+    {
+        uint32_t light_count;
+        VkBool32 sh_irradiance;
+    };
+    LightingSpecialization constexpr lighting_spec_data{
+        .light_count = LIGHT_COUNT_,
+        .sh_irradiance = IRRADIANCE_MODE_ == IrradianceMode::SPHERICAL_HARMONICS ? VK_TRUE : VK_FALSE
+    };
+    std::array constexpr lighting_spec_entries{
+        UINT32_SPEC_ENTRY,
+        VkSpecializationMapEntry{
+            .constantID = 1u,
+            .offset = offsetof( LightingSpecialization, sh_irradiance ),
+            .size = sizeof( VkBool32 ),
+        },
+    };
     VkSpecializationInfo const light_spec{
-        .mapEntryCount = 1u,
-        .pMapEntries = &UINT32_SPEC_ENTRY,
-        .dataSize = sizeof( LIGHT_COUNT_ ),
-        .pData = &LIGHT_COUNT_
+        .mapEntryCount = static_cast<uint32_t>( lighting_spec_entries.size( ) ),
+        .pMapEntries = lighting_spec_entries.data( ),
+        .dataSize = sizeof( LightingSpecialization ),
+        .pData = &lighting_spec_data
     };
 
-    // Depth pre-pass pipeline
-    {
-        depth_prepass_pipeline_ = CVK.create_resource<Pipeline>(
-            builder::GraphicsPipelineBuilder{}
-            .add_shader_module( { context_->device( ), "shaders/transform.vert.spv", VK_SHADER_STAGE_VERTEX_BIT } )
-            .add_shader_module( { context_->device( ), "shaders/alpha_discard.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT },
-                                &tex_spec )
-            .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
-            .set_binding_description( Vertex::get_binding_description( ), Vertex::get_attribute_descriptions( ) )
-            .set_depth_stencil_mode( VK_TRUE, VK_TRUE, VK_COMPARE_OP_LESS )
-            .set_depth_image_description( swapchain_->depth_image( ).format( ) )
-            .build( context_->device( ), *sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS ) );
-    }
+    // The vertex input has to match the layout the model is uploaded with.
+    constexpr bool packed_vertices = VERTEX_LAYOUT_ == VertexLayout::PACKED;
+    constexpr VkVertexInputBindingDescription vertex_binding =
+            packed_vertices ? PackedVertex::get_binding_description( ) : Vertex::get_binding_description( );
+    std::vector const vertex_attributes =
+            packed_vertices ? PackedVertex::get_attribute_descriptions( ) : Vertex::get_attribute_descriptions( );
+    std::string_view const transform_shader =
+            packed_vertices ? "shaders/packed_transform.vert.spv" : "shaders/transform.vert.spv";
+
+    // Builders, the shared modules are loaded once from the library.
+    shader::ShaderModule const& transform_vert = shader_library_->load( transform_shader, VK_SHADER_STAGE_VERTEX_BIT );
+    shader::ShaderModule const& quad_vert      = shader_library_->load( "shaders/quad.vert.spv", VK_SHADER_STAGE_VERTEX_BIT );
+
+    builder::GraphicsPipelineBuilder depth_prepass_builder{};
+    depth_prepass_builder
+        .add_shader_module( transform_vert )
+        .add_shader_module( shader_library_->load( "shaders/alpha_discard.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT ),
+                            &tex_spec )
+        .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
+        .set_binding_description( vertex_binding, vertex_attributes )
+        .set_depth_stencil_mode( VK_TRUE, VK_TRUE, VK_COMPARE_OP_LESS )
+        .set_depth_image_description( swapchain_->depth_image( ).format( ) );
 
-    // G-Buffer generation pipeline
-    {
-        gbuffer_pass_pipeline_ = CVK.create_resource<Pipeline>(
-            builder::GraphicsPipelineBuilder{}
-            .add_shader_module( { context_->device( ), "shaders/transform.vert.spv", VK_SHADER_STAGE_VERTEX_BIT } )
-            .add_shader_module( { context_->device( ), "shaders/gbuffer_gen.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT },
-                                &tex_spec )
-            .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
-            .set_binding_description( Vertex::get_binding_description( ), Vertex::get_attribute_descriptions( ) )
-            .set_depth_stencil_mode( VK_TRUE, VK_FALSE, VK_COMPARE_OP_EQUAL )
-            .set_depth_image_description( swapchain_->depth_image( ).format( ) )
-            .add_color_attachment_description(
-                VkPipelineColorBlendAttachmentState{
-                    .blendEnable = VK_FALSE,
-                    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
-                                      VK_COLOR_COMPONENT_A_BIT,
-                }, albedo_images_->image_format( ) )
-            .add_color_attachment_description(
-                VkPipelineColorBlendAttachmentState{
-                    .blendEnable = VK_FALSE,
-                    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
-                                      VK_COLOR_COMPONENT_A_BIT,
-                }, material_images_->image_format( ) )
-            .build( context_->device( ), *sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS ) );
-    }
+    builder::GraphicsPipelineBuilder gbuffer_pass_builder{};
+    gbuffer_pass_builder
+        .add_shader_module( transform_vert )
+        .add_shader_module( shader_library_->load( "shaders/gbuffer_gen.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT ),
+                            &tex_spec )
+        .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
+        .set_binding_description( vertex_binding, vertex_attributes )
+        .set_depth_stencil_mode( VK_TRUE, VK_FALSE, VK_COMPARE_OP_EQUAL )
+        .set_depth_image_description( swapchain_->depth_image( ).format( ) )
+        .add_color_attachment_description(
+            VkPipelineColorBlendAttachmentState{
+                .blendEnable = VK_FALSE,
+                .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                                  VK_COLOR_COMPONENT_A_BIT,
+            }, albedo_images_->image_format( ) )
+        .add_color_attachment_description(
+            VkPipelineColorBlendAttachmentState{
+                .blendEnable = VK_FALSE,
+                .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                                  VK_COLOR_COMPONENT_A_BIT,
+            }, material_images_->image_format( ) );
 
-    // Lighting pass pipeline
-    {
-        lighting_pass_pipeline_ = CVK.create_resource<Pipeline>(
-            builder::GraphicsPipelineBuilder{}
-            .add_shader_module( { context_->device( ), "shaders/quad.vert.spv", VK_SHADER_STAGE_VERTEX_BIT } )
-            .add_shader_module( { context_->device( ), "shaders/lighting.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT },
-                                &light_spec )
-            .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
-            .set_depth_stencil_mode( VK_FALSE, VK_FALSE )
-            .set_cull_mode( VK_CULL_MODE_NONE )
-            .add_color_attachment_description(
-                VkPipelineColorBlendAttachmentState{
-                    .blendEnable = VK_FALSE,
-                    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
-                                      VK_COLOR_COMPONENT_A_BIT,
-                }, post_processing_images_->image_format( ) )
-            .build( context_->device( ), *processing_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS ) );
-    }
+    builder::GraphicsPipelineBuilder lighting_pass_builder{};
+    lighting_pass_builder
+        .add_shader_module( quad_vert )
+        .add_shader_module( shader_library_->load( "shaders/lighting.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT ),
+                            &light_spec )
+        .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
+        .set_depth_stencil_mode( VK_FALSE, VK_FALSE )
+        .set_cull_mode( VK_CULL_MODE_NONE )
+        .add_color_attachment_description(
+            VkPipelineColorBlendAttachmentState{
+                .blendEnable = VK_FALSE,
+                .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                                  VK_COLOR_COMPONENT_A_BIT,
+            }, post_processing_images_->image_format( ) );
 
-    // Post-processing pass pipeline
-    {
-        post_processing_pass_pipeline_ = CVK.create_resource<Pipeline>(
-            builder::GraphicsPipelineBuilder{}
-            .add_shader_module( { context_->device( ), "shaders/quad.vert.spv", VK_SHADER_STAGE_VERTEX_BIT } )
-            .add_shader_module( { context_->device( ), "shaders/tone_mapping.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT } )
-            .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
-            .set_depth_stencil_mode( VK_FALSE, VK_FALSE )
-            .set_cull_mode( VK_CULL_MODE_NONE )
-            .add_color_attachment_description(
-                VkPipelineColorBlendAttachmentState{
-                    .blendEnable = VK_FALSE,
-                    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
-                                      VK_COLOR_COMPONENT_A_BIT,
-                }, swapchain_->image_format( ) )
-            .build( context_->device( ), *processing_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS ) );
-    }
+    builder::GraphicsPipelineBuilder post_processing_pass_builder{};
+    post_processing_pass_builder
+        .add_shader_module( quad_vert )
+        .add_shader_module( shader_library_->load( "shaders/tone_mapping.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT ) )
+        .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
+        .set_depth_stencil_mode( VK_FALSE, VK_FALSE )
+        .set_cull_mode( VK_CULL_MODE_NONE )
+        .add_color_attachment_description(
+            VkPipelineColorBlendAttachmentState{
+                .blendEnable = VK_FALSE,
+                .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                                  VK_COLOR_COMPONENT_A_BIT,
+            }, swapchain_->image_format( ) );
+
+    // Compile the pipelines side by side, a warm pipeline cache turns most of this into lookups.
+    std::vector pipelines = builder::build_pipelines(
+        context_->device( ),
+        std::array{
+            builder::GraphicsPipelineBuild{ depth_prepass_builder, *sampling_pipeline_layout_ },
+            builder::GraphicsPipelineBuild{ gbuffer_pass_builder, *sampling_pipeline_layout_ },
+            builder::GraphicsPipelineBuild{ lighting_pass_builder, *processing_pipeline_layout_ },
+            builder::GraphicsPipelineBuild{ post_processing_pass_builder, *processing_pipeline_layout_ },
+        }, pipeline_cache_.get( ) );
+
+    depth_prepass_pipeline_        = CVK.create_resource<Pipeline>( std::move( pipelines[0] ) );
+    gbuffer_pass_pipeline_         = CVK.create_resource<Pipeline>( std::move( pipelines[1] ) );
+    lighting_pass_pipeline_        = CVK.create_resource<Pipeline>( std::move( pipelines[2] ) );
+    post_processing_pass_pipeline_ = CVK.create_resource<Pipeline>( std::move( pipelines[3] ) );
+
+    cull_pipeline_ = CVK.create_resource<Pipeline>(
+        builder::ComputePipelineBuilder{}
+        .set_shader_module( shader_library_->load( "shaders/cull_draws.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT ) )
+        .build( context_->device( ), *cull_pipeline_layout_, pipeline_cache_.get( ) ) );
 }
 
 
@@ -480,10 +576,12 @@ void MyApplication::write_textures_descriptor_sets( )
                 VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
                 [this]( uint32_t ) -> VkDescriptorBufferInfo
                     {
+                        Buffer const& surface_buffer =
+                                model_->is_ready( ) ? model_->model( ).surface_buffer( ) : *fallback_surface_buffer_;
                         return {
-                            .buffer = model_->surface_buffer( ).handle( ),
+                            .buffer = surface_buffer.handle( ),
                             .offset = 0u,
-                            .range = model_->surface_buffer( ).buffer_size( )
+                            .range = surface_buffer.buffer_size( )
                         };
                     }
             },
@@ -498,82 +596,102 @@ void MyApplication::write_textures_descriptor_sets( )
                         };
                     }
             },
-        };
-        descriptor_allocator_->set_at( "buffer" ).update( write_ops );
-    }
-
-    // Textures descriptors
-    {
-        std::array write_ops{
-            WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLER,
-                [this]( uint32_t ) -> VkDescriptorImageInfo
-                    {
-                        return {
-                            .sampler = texture_sampler_->handle( )
-                        };
-                    },
-            },
-            WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                [this]( uint32_t ) -> std::vector<VkDescriptorImageInfo>
-                    {
-                        auto const texture_images = model_->textures( );
-                        std::vector<VkDescriptorImageInfo> infos;
-                        infos.reserve( texture_images.size( ) );
-                        for ( auto const& tex : texture_images )
-                        {
-                            infos.push_back( {
-                                .imageView = tex.image( ).view( ).handle( ),
-                                .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-                            } );
-                        }
-                        return infos;
-                    }
-            },
-            WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                [this]( uint32_t ) -> VkDescriptorImageInfo
-                    {
-                        return {
-                            .imageView = swapchain_->depth_image( ).view( ).handle( ),
-                            .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
-                        };
-                    }
-            },
-            WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                [this]( uint32_t const frame_index ) -> VkDescriptorImageInfo
-                    {
-                        return {
-                            .imageView = albedo_images_->image_at( frame_index ).view( ).handle( ),
-                            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-                        };
-                    }
-            },
             WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                [this]( uint32_t const frame_index ) -> VkDescriptorImageInfo
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                [this]( uint32_t ) -> VkDescriptorBufferInfo
                     {
                         return {
-                            .imageView = material_images_->image_at( frame_index ).view( ).handle( ),
-                            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                            .buffer = irradiance_sh_buffer_->handle( ),
+                            .offset = 0u,
+                            .range = irradiance_sh_buffer_->buffer_size( )
                         };
                     }
             },
-            WriteDescription{
-                VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                [this]( uint32_t const frame_index ) -> VkDescriptorImageInfo
+        };
+        descriptor_allocator_->set_at( "buffer" ).update( write_ops );
+    }
+
+    // Textures descriptors
+    for ( uint32_t frame_index{}; frame_index < MAX_FRAMES_IN_FLIGHT_; ++frame_index )
+    {
+        write_frame_textures_descriptor_set( frame_index );
+    }
+}
+
+
+void MyApplication::write_frame_textures_descriptor_set( uint32_t const frame_index )
+{
+    std::array write_ops{
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLER,
+            [this]( uint32_t ) -> VkDescriptorImageInfo
+                {
+                    return {
+                        .sampler = texture_sampler_->handle( )
+                    };
+                },
+        },
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            [this]( uint32_t ) -> std::vector<VkDescriptorImageInfo>
+                {
+                    auto const texture_images = model_->is_ready( )
+                                                    ? model_->model( ).textures( )
+                                                    : std::span<TextureImage const>{ &*fallback_texture_, 1u };
+                    std::vector<VkDescriptorImageInfo> infos;
+                    infos.reserve( texture_images.size( ) );
+                    for ( auto const& tex : texture_images )
                     {
-                        return {
-                            .imageView = post_processing_images_->image_at( frame_index ).view( ).handle( ),
+                        infos.push_back( {
+                            .imageView = tex.image( ).view( ).handle( ),
                             .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-                        };
+                        } );
                     }
-            },
-        };
-        descriptor_allocator_->set_at( "textures" ).update( write_ops );
-    }
+                    return infos;
+                }
+        },
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            [this]( uint32_t ) -> VkDescriptorImageInfo
+                {
+                    return {
+                        .imageView = swapchain_->depth_image( ).view( ).handle( ),
+                        .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                    };
+                }
+        },
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            [this]( uint32_t const index ) -> VkDescriptorImageInfo
+                {
+                    return {
+                        .imageView = albedo_images_->image_at( index ).view( ).handle( ),
+                        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                    };
+                }
+        },
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            [this]( uint32_t const index ) -> VkDescriptorImageInfo
+                {
+                    return {
+                        .imageView = material_images_->image_at( index ).view( ).handle( ),
+                        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                    };
+                }
+        },
+        WriteDescription{
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            [this]( uint32_t const index ) -> VkDescriptorImageInfo
+                {
+                    return {
+                        .imageView = post_processing_images_->image_at( index ).view( ).handle( ),
+                        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                    };
+                }
+        },
+    };
+    descriptor_allocator_->set_at( "textures" ).update_at( write_ops, frame_index );
 }
 
 
@@ -664,11 +782,51 @@ void MyApplication::write_shadow_map_textures_descriptor_sets( )
 }
 
 
+void MyApplication::write_cull_descriptor_set( )
+{
+    // Only the culling pass binds it, which runs once the model is ready.
+    auto const make_buffer_write = []( Buffer const& buffer )
+        {
+            return WriteDescription{
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                [&buffer]( uint32_t ) -> VkDescriptorBufferInfo
+                    {
+                        return {
+                            .buffer = buffer.handle( ),
+                            .offset = 0u,
+                            .range = buffer.buffer_size( )
+                        };
+                    }
+            };
+        };
+
+    Model const& model = model_->model( );
+    std::array write_ops{
+        make_buffer_write( model.mesh_cull_buffer( ) ),
+        make_buffer_write( model.draw_buffer( ) ),
+        make_buffer_write( model.draw_count_buffer( ) ),
+    };
+    descriptor_allocator_->set_at( "cull" ).update( write_ops );
+}
+
+
 void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchain& swapchain,
                                            uint32_t const image_index, uint32_t const frame_index )
 {
     buffer.reset( );
 
+    // The frame has been waited for, so its texture descriptors can take the streamed levels that finished uploading, or
+    // the render images recreated since it was last recorded.
+    bool const levels_streamed =
+            model_->is_ready( ) &&
+            model_->model( ).update_texture_streaming( camera_ptr_->camera_to_world( ), camera_ptr_->projection( ),
+                                                       swapchain.extent( ), frame_index );
+    if ( bool const render_images_stale = std::exchange( stale_frame_textures_[frame_index], false );
+         levels_streamed || render_images_stale )
+    {
+        write_frame_textures_descriptor_set( frame_index );
+    }
+
     CommandOperator command_op = buffer.command_operator( 0 );
 
     command_op.store_render_area( VkRect2D{ .offset = { 0u, 0u }, .extent = swapchain.extent( ) } );
@@ -684,6 +842,17 @@ void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchai
     Image& hdr_image      = post_processing_images_->image_at( frame_index );
     Image& swap_image     = swapchain.image_at( image_index );
 
+    // The depth pre-pass and the g-buffer pass must draw the same triangles for their depths to match, so they share the
+    // frame's draws, which the culling rewrites here every frame.
+    if ( model_->is_ready( ) )
+    {
+        LodSelector const lod_selector{ camera_ptr_->camera_to_world( ), camera_ptr_->projection( ),
+                                        static_cast<float>( swapchain.extent( ).height ), LOD_PIXEL_ERROR_ };
+        command_op.bind_pipeline( *cull_pipeline_, frame_index );
+        model_->model( ).record_draw_culling( command_op, *cull_pipeline_, frame_index,
+                                              camera_ptr_->projection( ) * camera_ptr_->camera_to_world( ), lod_selector );
+    }
+
     // 1. Depth Pre-Pass: render geometry to depth only, no color attachment
     {
         // DEPTH STENCIL READONLY OPTIMAL -> DEPTH STENCIL ATTACHMENT OPTIMAL
@@ -703,16 +872,7 @@ void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchai
         command_op.set_viewport( );
         command_op.set_scissor( );
 
-        command_op.bind_pipeline( *depth_prepass_pipeline_, frame_index );
-        command_op.bind_vertex_buffers( model_->vertex_buffer( ), 0 );
-        command_op.bind_index_buffer( model_->index_buffer( ), 0 );
-
-        for ( auto const& [index_count, index_offset, vertex_offset, material_index] : model_->meshes( ) )
-        {
-            command_op.push_constants( *depth_prepass_pipeline_, VK_SHADER_STAGE_FRAGMENT_BIT, 0u, sizeof( uint32_t ),
-                                       &material_index );
-            command_op.draw_indexed( index_count, 1, index_offset, vertex_offset );
-        }
+        record_model_draws( command_op, *depth_prepass_pipeline_, frame_index, frame_index );
 
         command_op.end_rendering( );
 
@@ -756,16 +916,7 @@ void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchai
         command_op.set_viewport( );
         command_op.set_scissor( );
 
-        command_op.bind_pipeline( *gbuffer_pass_pipeline_, frame_index );
-        command_op.bind_vertex_buffers( model_->vertex_buffer( ), 0 );
-        command_op.bind_index_buffer( model_->index_buffer( ), 0 );
-
-        for ( auto const& [index_count, index_offset, vertex_offset, material_index] : model_->meshes( ) )
-        {
-            command_op.push_constants( *gbuffer_pass_pipeline_, VK_SHADER_STAGE_FRAGMENT_BIT, 0u, sizeof( uint32_t ),
-                                       &material_index );
-            command_op.draw_indexed( index_count, 1, index_offset, vertex_offset );
-        }
+        record_model_draws( command_op, *gbuffer_pass_pipeline_, frame_index, frame_index );
 
         command_op.end_rendering( );
 
@@ -791,10 +942,10 @@ void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchai
         // SHADER READONLY OPTIMAL -> COLOR ATTACHMENT OPTIMAL
         hdr_image.transition_layout(
             ImageLayoutTransition{ VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }
-            .from_stage( VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT )
-            .to_stage( VK_PIPELINE_STAGE_2_TRANSFER_BIT )
-            .from_access( VK_ACCESS_2_NONE )
-            .to_access( VK_ACCESS_2_TRANSFER_WRITE_BIT ), command_op );
+            .from_stage( VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT )
+            .to_stage( VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT )
+            .from_access( VK_ACCESS_2_SHADER_SAMPLED_READ_BIT )
+            .to_access( VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT ), command_op );
 
         VkRenderingAttachmentInfo const color_attachment =
                 hdr_image.view( ).make_color_attachment( VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE );
@@ -856,13 +1007,38 @@ void MyApplication::record_command_buffer( CommandBuffer const& buffer, Swapchai
 }
 
 
-void MyApplication::render_to_cubemap( Image& attachment, shader::ShaderModule vert, shader::ShaderModule frag )
+void MyApplication::record_model_draws( CommandOperator const& command_op, Pipeline const& pipeline,
+                                        uint32_t const frame_index, uint32_t const draw_view ) const
+{
+    // Nothing is drawn until the model has been published, the passes still run so their images stay valid.
+    if ( not model_->is_ready( ) )
+    {
+        return;
+    }
+    Model const& model = model_->model( );
+
+    command_op.bind_pipeline( pipeline, frame_index );
+    command_op.bind_vertex_buffers( model.vertex_buffer( ), 0 );
+
+    // One indirect draw per batch however many meshes the model has, issuing as many draws as survived the view's culling.
+    for ( size_t batch_index{}; batch_index < model.draw_batches( ).size( ); ++batch_index )
+    {
+        DrawBatch const& batch = model.draw_batches( )[batch_index];
+        command_op.bind_index_buffer( model.index_buffer( ), 0, batch.index_type );
+        command_op.draw_indexed_indirect_count(
+            model.draw_buffer( ), model.draw_offset( draw_view ) + batch.first_draw * sizeof( VkDrawIndexedIndirectCommand ),
+            model.draw_count_buffer( ), model.draw_count_offset( draw_view, batch_index ), batch.draw_count );
+    }
+}
+
+
+void MyApplication::render_to_cubemap( Image& attachment, shader::ShaderModule const& vert, shader::ShaderModule const& frag )
 {
     // Create Cubemap Pipeline
     Pipeline const cubemap_pipeline{
         builder::GraphicsPipelineBuilder{}
-        .add_shader_module( std::move( vert ) )
-        .add_shader_module( std::move( frag ) )
+        .add_shader_module( vert )
+        .add_shader_module( frag )
         .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
         .set_depth_stencil_mode( VK_FALSE, VK_FALSE )
         .set_cull_mode( VK_CULL_MODE_NONE )
@@ -872,7 +1048,8 @@ void MyApplication::render_to_cubemap( Image& attachment, shader::ShaderModule v
                 .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
                                   VK_COLOR_COMPONENT_A_BIT,
             }, attachment.format( ) )
-        .build( context_->device( ), *cubemap_sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS )
+        .build( context_->device( ), *cubemap_sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                pipeline_cache_.get( ) )
     };
 
     // Render pass
@@ -973,10 +1150,23 @@ void MyApplication::render_to_cubemap( Image& attachment, shader::ShaderModule v
 
 void MyApplication::render_skybox_map( )
 {
-    // Load skybox HDR image
+    // 1. A cached cubemap is keyed on everything it is rendered from, the source image and both shaders.
+    skybox_cache_key_ = io::hash_combine(
+        io::hash_combine( io::hash_file( SKYBOX_PATH_ ), io::hash_file( CUBEMAP_VERT_PATH_ ) ),
+        io::hash_file( SPHERICAL_SAMPLING_FRAG_PATH_ ) );
+
+    if ( auto cached = image::load_cubemap( context_->device( ), *command_pool_, SKYBOX_CACHE_PATH_, skybox_cache_key_ ) )
+    {
+        cube_skybox_image_ = CVK.create_resource<Image>( std::move( *cached ) );
+        return;
+    }
+
+    // 2. Load skybox HDR image
     TextureImage const skybox_hdr{
         context_->device( ), *command_pool_,
-        TextureImageCreateInfo{ .path_to_img = SKYBOX_PATH_, .image_format = VK_FORMAT_R32G32B32A32_SFLOAT }
+        TextureImageCreateInfo{
+            .path_to_img = SKYBOX_PATH_, .image_format = VK_FORMAT_R32G32B32A32_SFLOAT, .generate_mips = false
+        }
     };
 
     // Create cubemap image
@@ -986,7 +1176,7 @@ void MyApplication::render_skybox_map( )
             .extent = { skybox_hdr.image( ).extent( ).width / 4u, skybox_hdr.image( ).extent( ).height / 2u },
             .format = VK_FORMAT_R32G32B32A32_SFLOAT,
             .tiling = VK_IMAGE_TILING_OPTIMAL,
-            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
             .properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             .create_flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
             .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -994,27 +1184,48 @@ void MyApplication::render_skybox_map( )
             .view_type = VK_IMAGE_VIEW_TYPE_CUBE,
         } );
 
-    // Update descriptor sets
+    // 3. Update descriptor sets
     write_cube_textures_descriptor_sets( skybox_hdr.image( ) );
 
-    // Render the skybox to cubemap
+    // 4. Render the skybox to cubemap and cache it for the next launch
     render_to_cubemap(
         *cube_skybox_image_,
-        shader::ShaderModule{ context_->device( ), "shaders/cubemap.vert.spv", VK_SHADER_STAGE_VERTEX_BIT },
-        shader::ShaderModule{ context_->device( ), "shaders/spherical_sampling.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT } );
+        shader_library_->load( CUBEMAP_VERT_PATH_, VK_SHADER_STAGE_VERTEX_BIT ),
+        shader_library_->load( SPHERICAL_SAMPLING_FRAG_PATH_, VK_SHADER_STAGE_FRAGMENT_BIT ) );
+    image::store_cubemap( context_->device( ), *command_pool_, *cube_skybox_image_, SKYBOX_CACHE_PATH_, skybox_cache_key_ );
 }
 
 
 void MyApplication::render_irradiance_map( )
 {
-    // Create cubemap image
+    // The SH mode replaces the cubemap altogether, the irradiance binding keeps pointing at the skybox.
+    if constexpr ( IRRADIANCE_MODE_ == IrradianceMode::SPHERICAL_HARMONICS )
+    {
+        image::SH9Irradiance const irradiance = image::project_irradiance_sh9( SKYBOX_PATH_ );
+        irradiance_sh_buffer_->write( &irradiance, sizeof( image::SH9Irradiance ) );
+        write_cube_textures_descriptor_sets( *cube_skybox_image_ );
+        return;
+    }
+
+    // 1. The irradiance is derived from the skybox, so its key extends the skybox key.
+    uint64_t const irradiance_cache_key = io::hash_combine( skybox_cache_key_, io::hash_file( IRRADIANCE_SAMPLING_FRAG_PATH_ ) );
+
+    if ( auto cached = image::load_cubemap( context_->device( ), *command_pool_, IRRADIANCE_CACHE_PATH_,
+                                            irradiance_cache_key ) )
+    {
+        cube_diffuse_irradiance_image_ = CVK.create_resource<Image>( std::move( *cached ) );
+        write_cube_textures_descriptor_sets( *cube_skybox_image_ );
+        return;
+    }
+
+    // 2. Create cubemap image
     cube_diffuse_irradiance_image_ = CVK.create_resource<Image>(
         context_->device( ),
         ImageCreateInfo{
             .extent = { 512u, 512u },
             .format = VK_FORMAT_R32G32B32A32_SFLOAT,
             .tiling = VK_IMAGE_TILING_OPTIMAL,
-            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
             .properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             .create_flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
             .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -1022,14 +1233,16 @@ void MyApplication::render_irradiance_map( )
             .view_type = VK_IMAGE_VIEW_TYPE_CUBE,
         } );
 
-    // Update descriptor sets
+    // 3. Update descriptor sets
     write_cube_textures_descriptor_sets( *cube_skybox_image_ );
 
-    // Sample the skybox cubemap to diffuse irradiance cubemap
+    // 4. Sample the skybox cubemap to diffuse irradiance cubemap and cache it for the next launch
     render_to_cubemap(
         *cube_diffuse_irradiance_image_,
-        shader::ShaderModule{ context_->device( ), "shaders/cubemap.vert.spv", VK_SHADER_STAGE_VERTEX_BIT },
-        shader::ShaderModule{ context_->device( ), "shaders/irradiance_sampling.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT } );
+        shader_library_->load( CUBEMAP_VERT_PATH_, VK_SHADER_STAGE_VERTEX_BIT ),
+        shader_library_->load( IRRADIANCE_SAMPLING_FRAG_PATH_, VK_SHADER_STAGE_FRAGMENT_BIT ) );
+    image::store_cubemap( context_->device( ), *command_pool_, *cube_diffuse_irradiance_image_, IRRADIANCE_CACHE_PATH_,
+                          irradiance_cache_key );
 }
 
 
@@ -1043,17 +1256,25 @@ void MyApplication::render_shadow_maps( )
         .pData = &TEXTURE_COUNT_
     };
 
+    constexpr bool packed_vertices = VERTEX_LAYOUT_ == VertexLayout::PACKED;
+    constexpr VkVertexInputBindingDescription vertex_binding =
+            packed_vertices ? PackedVertex::get_binding_description( ) : Vertex::get_binding_description( );
+    std::vector const vertex_attributes =
+            packed_vertices ? PackedVertex::get_attribute_descriptions( ) : Vertex::get_attribute_descriptions( );
+    std::string_view const transform_shader =
+            packed_vertices ? "shaders/packed_simple_transform.vert.spv" : "shaders/simple_transform.vert.spv";
+
     Pipeline const shadow_mapping_pipeline{
         builder::GraphicsPipelineBuilder{}
-        .add_shader_module( { context_->device( ), "shaders/simple_transform.vert.spv", VK_SHADER_STAGE_VERTEX_BIT } )
-        .add_shader_module( { context_->device( ), "shaders/alpha_discard.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT },
+        .add_shader_module( shader_library_->load( transform_shader, VK_SHADER_STAGE_VERTEX_BIT ) )
+        .add_shader_module( shader_library_->load( "shaders/alpha_discard.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT ),
                             &tex_spec )
         .set_dynamic_state( std::array{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR } )
-        .set_binding_description( Vertex::get_binding_description( ), Vertex::get_attribute_descriptions( ) )
+        .set_binding_description( vertex_binding, vertex_attributes )
         .set_depth_stencil_mode( VK_TRUE, VK_TRUE, VK_COMPARE_OP_LESS )
         .set_depth_bias( 1.25f, 0.f, 1.75f )
         .set_depth_image_description( shadow_map_depth_images_->image_format( ) )
-        .build( context_->device( ), *sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS )
+        .build( context_->device( ), *sampling_pipeline_layout_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_cache_.get( ) )
     };
 
     // Render pass
@@ -1095,6 +1316,17 @@ void MyApplication::render_shadow_maps( )
             };
             camera_uniform_buffers_[0]->write( &ubo, sizeof( ubo ) );
 
+            // Every light draws from its own view, past the ones of the frames in flight.
+            uint32_t const draw_view = MAX_FRAMES_IN_FLIGHT_ + image_index;
+            if ( model_->is_ready( ) )
+            {
+                LodSelector const lod_selector{ ubo.view, ubo.proj, static_cast<float>( SHADOW_MAP_SIZE_ ), LOD_PIXEL_ERROR_,
+                                                SHADOW_LOD_BIAS_ };
+                command_op.bind_pipeline( *cull_pipeline_, 0u );
+                model_->model( ).record_draw_culling( command_op, *cull_pipeline_, draw_view, ubo.proj * ubo.view,
+                                                      lod_selector );
+            }
+
             // UNDEFINED -> DEPTH STENCIL ATTACHMENT OPTIMAL
             image.transition_layout(
                 ImageLayoutTransition{ VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL }
@@ -1111,17 +1343,7 @@ void MyApplication::render_shadow_maps( )
             command_op.set_viewport( );
             command_op.set_scissor( );
 
-            command_op.bind_pipeline( shadow_mapping_pipeline, 0u );
-
-            command_op.bind_vertex_buffers( model_->vertex_buffer( ), 0 );
-            command_op.bind_index_buffer( model_->index_buffer( ), 0 );
-
-            for ( auto const& [index_count, index_offset, vertex_offset, material_index] : model_->meshes( ) )
-            {
-                command_op.push_constants( shadow_mapping_pipeline, VK_SHADER_STAGE_FRAGMENT_BIT,  0u, sizeof( uint32_t ),
-                                           &material_index );
-                command_op.draw_indexed( index_count, 1, index_offset, vertex_offset );
-            }
+            record_model_draws( command_op, shadow_mapping_pipeline, 0u, draw_view );
 
             command_op.end_rendering( );
 
@@ -1157,11 +1379,25 @@ void MyApplication::update_camera_data( uint32_t const current_image ) const
 }
 
 
+void MyApplication::model_loaded( Model& )
+{
+    // Frames in flight still sample the fallback bindings, the swap happens once they completed. The texture streamer the
+    // load just started keeps uploading meanwhile, only the frames are waited for.
+    renderer_->wait_frames_in_flight( );
+
+    write_lights_data( );
+    write_textures_descriptor_sets( );
+    write_cull_descriptor_set( );
+    render_shadow_maps( );
+}
+
+
 void MyApplication::viewport_changed( VkExtent2D const extent )
 {
+    // The previous images are retired until the frames in flight are done with them, and each frame picks the new ones up
+    // in its texture descriptors the next time it is recorded, the sets of the other frame may still be in use.
     create_render_images( extent );
-    context_->device( ).wait_idle( );
-    write_textures_descriptor_sets( );
+    stale_frame_textures_.fill( true );
 }
 
 
@@ -4,6 +4,8 @@
 #include "UniformBufferObject.h"
 
 #include <cobalt_vk/handle.h>
+#include <__enum/IrradianceMode.h>
+#include <__enum/VertexLayout.h>
 #include <vulkan/vulkan_core.h>
 
 #include <array>
@@ -22,6 +24,9 @@ namespace cobalt::shader
 namespace cobalt
 {
     class CommandBuffer;
+    class CommandOperator;
+    class Model;
+    class Pipeline;
     class Swapchain;
     class Image;
 }
@@ -57,6 +62,19 @@ namespace dae
         static constexpr uint32_t SHADOW_MAP_SIZE_{ 1024u * 4 };
 
         static constexpr std::string_view MODEL_PATH_{ "resources/Sponza.gltf" };
+        static constexpr std::string_view FALLBACK_TEXTURE_PATH_{ "resources/missing_texture_256x256.png" };
+        static constexpr std::string_view PIPELINE_CACHE_PATH_{ "pipeline_cache.bin" };
+        static constexpr std::string_view SKYBOX_CACHE_PATH_{ "skybox_cache.bin" };
+        static constexpr std::string_view IRRADIANCE_CACHE_PATH_{ "irradiance_cache.bin" };
+        static constexpr std::string_view CUBEMAP_VERT_PATH_{ "shaders/cubemap.vert.spv" };
+        static constexpr std::string_view SPHERICAL_SAMPLING_FRAG_PATH_{ "shaders/spherical_sampling.frag.spv" };
+        static constexpr std::string_view IRRADIANCE_SAMPLING_FRAG_PATH_{ "shaders/irradiance_sampling.frag.spv" };
+        static constexpr cobalt::VertexLayout VERTEX_LAYOUT_{ cobalt::VertexLayout::PACKED };
+        static constexpr cobalt::IrradianceMode IRRADIANCE_MODE_{ cobalt::IrradianceMode::SPHERICAL_HARMONICS };
+
+        // Meshes switch to a coarser level once its error covers less than this many pixels, shadow maps skip finer levels.
+        static constexpr float LOD_PIXEL_ERROR_{ 1.f };
+        static constexpr uint32_t SHADOW_LOD_BIAS_{ 1u };
 
 #if defined( SCENE_1 )
         static constexpr std::string_view SKYBOX_PATH_{ "resources/skybox_4k.hdr" };
@@ -108,13 +126,17 @@ namespace dae
         cobalt::CommandPoolHandle command_pool_{};
         cobalt::DescriptorAllocatorHandle descriptor_allocator_{};
 
+        cobalt::ShaderLibraryHandle shader_library_{};
+        cobalt::PipelineCacheHandle pipeline_cache_{};
         cobalt::PipelineLayoutHandle cubemap_sampling_pipeline_layout_{};
         cobalt::PipelineLayoutHandle sampling_pipeline_layout_{};
         cobalt::PipelineLayoutHandle processing_pipeline_layout_{};
+        cobalt::PipelineLayoutHandle cull_pipeline_layout_{};
         cobalt::PipelineHandle depth_prepass_pipeline_{};
         cobalt::PipelineHandle gbuffer_pass_pipeline_{};
         cobalt::PipelineHandle lighting_pass_pipeline_{};
         cobalt::PipelineHandle post_processing_pass_pipeline_{};
+        cobalt::PipelineHandle cull_pipeline_{};
 
         cobalt::RendererHandle renderer_{};
 
@@ -123,12 +145,17 @@ namespace dae
         cobalt::ImageCollectionHandle albedo_images_{};
         cobalt::ImageCollectionHandle material_images_{};
         cobalt::ImageCollectionHandle post_processing_images_{};
+        std::array<bool, MAX_FRAMES_IN_FLIGHT_> stale_frame_textures_{};
         cobalt::ImageCollectionHandle shadow_map_depth_images_{};
         cobalt::ImageHandle cube_skybox_image_{};
         cobalt::ImageHandle cube_diffuse_irradiance_image_{};
-        cobalt::ModelHandle model_{};
+        uint64_t skybox_cache_key_{ 0u };
+        cobalt::AsyncModelHandle model_{};
+        cobalt::TextureImageHandle fallback_texture_{};
+        cobalt::BufferHandle fallback_surface_buffer_{};
 
         cobalt::BufferHandle lights_buffer_{};
+        cobalt::BufferHandle irradiance_sh_buffer_{};
         std::vector<cobalt::BufferHandle> camera_uniform_buffers_{};
 
         // .CREATION
@@ -138,20 +165,28 @@ namespace dae
         void create_uniform_buffers( );
         void create_pipelines( );
 
+        void write_lights_data( );
+
         void write_textures_descriptor_sets( );
+        void write_frame_textures_descriptor_set( uint32_t frame_index );
         void write_cube_textures_descriptor_sets( cobalt::Image const& temp_image );
         void write_shadow_map_textures_descriptor_sets( );
+        void write_cull_descriptor_set( );
 
         // .RENDERING
         void record_command_buffer(
             cobalt::CommandBuffer const&, cobalt::Swapchain&, uint32_t image_index, uint32_t frame_index );
-        void render_to_cubemap( cobalt::Image& attachment, cobalt::shader::ShaderModule vert, cobalt::shader::ShaderModule frag );
+        void record_model_draws( cobalt::CommandOperator const&, cobalt::Pipeline const&, uint32_t frame_index,
+                                 uint32_t draw_view ) const;
+        void render_to_cubemap( cobalt::Image& attachment, cobalt::shader::ShaderModule const& vert,
+                                cobalt::shader::ShaderModule const& frag );
         void render_skybox_map( );
         void render_irradiance_map( );
         void render_shadow_maps( );
         void update_camera_data( uint32_t current_image ) const;
 
         // .UTILITIES
+        void model_loaded( cobalt::Model& model );
         void viewport_changed( VkExtent2D extent );
 
         static void configure_relative_path( );
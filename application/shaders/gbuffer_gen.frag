@@ -8,6 +8,7 @@
 // INPUT
 layout ( location = 0 ) in vec2 in_uv;
 layout ( location = 1 ) in mat3 in_TBN;
+layout ( location = 4 ) flat in uint in_surface_id;
 
 
 // OUTPUT
@@ -16,7 +17,6 @@ layout ( location = 1 ) out vec4 out_material;
 
 
 // BINDINGS
-layout ( push_constant ) uniform SurfaceDescription { uint surface_id; } SD;
 layout ( set = 0, binding = 1 ) readonly buffer SurfaceBufferData { SurfaceMap maps[]; } surface_buffer;
 
 layout ( constant_id = 0 ) const uint TEXTURE_COUNT = 1u;
@@ -27,15 +27,18 @@ layout ( set = 1, binding = 1 ) uniform texture2D textures[TEXTURE_COUNT];
 // SHADER ENTRY POINT
 void main( )
 {
-    SurfaceMap map = surface_buffer.maps[SD.surface_id];
+    SurfaceMap map = surface_buffer.maps[in_surface_id];
 
     const vec3 albedo = texture( sampler2D( textures[nonuniformEXT( map.base_color_id )], shared_sampler ), in_uv ).rgb;
     const float metalness = texture( sampler2D( textures[nonuniformEXT( map.metalness_id )], shared_sampler ), in_uv ).b;
     const float roughness = texture( sampler2D( textures[nonuniformEXT( map.roughness_id )], shared_sampler ), in_uv ).g;
     const float ao = texture( sampler2D( textures[nonuniformEXT( map.ao_id )], shared_sampler ), in_uv ).r;
 
-    vec3 normal = texture( sampler2D( textures[nonuniformEXT( map.normal_id )], shared_sampler ), in_uv ).rgb;
-    normal = normalize( in_TBN * ( normal * 2.f - vec3( 1.f, 1.f, 1.f ) ) );
+    // Normal maps may be stored as two channels (BC5), z is rebuilt from the unit length of the tangent space normal.
+    vec3 normal;
+    normal.xy = texture( sampler2D( textures[nonuniformEXT( map.normal_id )], shared_sampler ), in_uv ).rg * 2.f - 1.f;
+    normal.z = sqrt( max( 1.f - dot( normal.xy, normal.xy ), 0.f ) );
+    normal = normalize( in_TBN * normal );
 
     out_albedo = vec4( albedo, ao );
     out_material = vec4( encode16( normal ).rg, metalness, roughness );
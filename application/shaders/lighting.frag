@@ -36,6 +36,8 @@ layout ( set = 2, binding = 3 ) uniform textureCube diffuse_irradiance_map;
 
 layout ( constant_id = 0 ) const uint LIGHT_COUNT = 1u;
 layout ( set = 0, binding = 2 ) uniform LightBufferData { Light lights[LIGHT_COUNT]; } light_buffer;
+layout ( constant_id = 1 ) const bool SH_IRRADIANCE = false;
+layout ( set = 0, binding = 3 ) uniform IrradianceSH { vec4 coefficients[9]; } irradiance_sh;
 layout ( set = 3, binding = 0 ) uniform sampler shadow_sampler;
 layout ( set = 3, binding = 1 ) uniform texture2D shadow_map_texures[LIGHT_COUNT];
 
@@ -106,10 +108,33 @@ in vec3 N, in vec3 V, in vec3 L, in vec3 H, in vec3 albedo, in float metallic, i
 }
 
 
+// SH9 IRRADIANCE
+// the coefficients are projected from the equirectangular skybox, whose directions relate to the cube ones as in
+// spherical_sampling.frag. the cosine convolution is already folded in.
+vec3 evaluate_sh_irradiance( in vec3 cube_direction )
+{
+    const vec3 d = vec3( cube_direction.z, cube_direction.y, -cube_direction.x );
+
+    vec3 E = irradiance_sh.coefficients[0].rgb * 0.282095f;
+    E += irradiance_sh.coefficients[1].rgb * 0.488603f * d.y;
+    E += irradiance_sh.coefficients[2].rgb * 0.488603f * d.z;
+    E += irradiance_sh.coefficients[3].rgb * 0.488603f * d.x;
+    E += irradiance_sh.coefficients[4].rgb * 1.092548f * d.x * d.y;
+    E += irradiance_sh.coefficients[5].rgb * 1.092548f * d.y * d.z;
+    E += irradiance_sh.coefficients[6].rgb * 0.315392f * ( 3.f * d.z * d.z - 1.f );
+    E += irradiance_sh.coefficients[7].rgb * 1.092548f * d.x * d.z;
+    E += irradiance_sh.coefficients[8].rgb * 0.546274f * ( d.x * d.x - d.y * d.y );
+    return max( E, vec3( 0.f ) );
+}
+
+
 vec3 calculate_ambient_light( in vec3 N, in vec3 V, in vec3 albedo, in float metallic, in float roughness, in vec3 F0 )
 {
     const vec3 F = fresnel_schlick_roughness( max( dot( V, N ), 0.f ), F0, roughness );
-    const vec3 prefiltered_diffuse_E = texture( samplerCube( diffuse_irradiance_map, shared_sampler ), vec3( N.x, -N.y, N.z ) ).rgb;
+    const vec3 irradiance_direction = vec3( N.x, -N.y, N.z );
+    const vec3 prefiltered_diffuse_E = SH_IRRADIANCE
+        ? evaluate_sh_irradiance( irradiance_direction )
+        : texture( samplerCube( diffuse_irradiance_map, shared_sampler ), irradiance_direction ).rgb;
     const vec3 kD = ( 1.f - F ) * ( 1.f - metallic );
     return kD * prefiltered_diffuse_E * albedo.rgb;
 }
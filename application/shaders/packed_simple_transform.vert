@@ -0,0 +1,30 @@
+#version 450
+
+
+// BINDING
+layout ( set = 0, binding = 0 ) uniform ModelViewProj {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} mvp;
+
+
+// INPUT
+layout ( location = 0 ) in vec3 in_position;
+layout ( location = 1 ) in vec2 in_uv;
+
+
+// OUTPUT
+layout ( location = 0 ) out vec2 out_uv;
+layout ( location = 4 ) flat out uint out_surface_id;
+
+
+// SHADER ENTRY POINT
+void main( )
+{
+    gl_Position = mvp.proj * mvp.view * vec4( in_position, 1.0 );
+    out_uv = in_uv;
+
+    // Indirect draws pass the material of their mesh as the first instance.
+    out_surface_id = gl_InstanceIndex;
+}
@@ -0,0 +1,45 @@
+#version 450
+
+#include "common.transcode.glsl"
+
+
+// BINDING
+layout ( set = 0, binding = 0 ) uniform ModelViewProj {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} mvp;
+
+
+// INPUT
+layout ( location = 0 ) in vec3 in_position;
+layout ( location = 1 ) in vec2 in_uv;
+layout ( location = 2 ) in vec2 in_normal;
+layout ( location = 3 ) in vec4 in_tangent;
+
+
+// OUTPUT
+layout ( location = 0 ) out vec2 out_uv;
+layout ( location = 1 ) out mat3 out_TBN;
+layout ( location = 4 ) flat out uint out_surface_id;
+
+
+// SHADER ENTRY POINT
+void main( )
+{
+    // Octahedral directions arrive in [-1, 1], decode16 expects the [0, 1] range.
+    const vec3 normal = decode16( in_normal * .5f + .5f );
+    const vec3 tangent = decode16( in_tangent.xy * .5f + .5f );
+    const vec3 bitangent = cross( normal, tangent ) * in_tangent.z;
+
+    const vec3 T = normalize( vec3( mvp.model * vec4( tangent, 0.0 ) ) );
+    const vec3 B = normalize( vec3( mvp.model * vec4( bitangent, 0.0 ) ) );
+    const vec3 N = normalize( vec3( mvp.model * vec4( normal, 0.0 ) ) );
+    out_TBN = mat3( T, B, N );
+
+    gl_Position = mvp.proj * mvp.view * mvp.model * vec4( in_position, 1.0 );
+    out_uv = in_uv;
+
+    // Indirect draws pass the material of their mesh as the first instance.
+    out_surface_id = gl_InstanceIndex;
+}
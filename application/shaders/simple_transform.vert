@@ -1 +1 @@
-#version 450// BINDINGlayout ( set = 0, binding = 0 ) uniform ModelViewProj {    mat4 model;    mat4 view;    mat4 proj;} mvp;// INPUTlayout ( location = 0 ) in vec3 in_position;layout ( location = 1 ) in vec2 in_uv;layout ( location = 2 ) in vec3 in_normal;layout ( location = 3 ) in vec3 in_tangent;layout ( location = 4 ) in vec3 in_bitangent;// OUTPUTlayout ( location = 0 ) out vec2 out_uv;// SHADER ENTRY POINTvoid main( ){    gl_Position = mvp.proj * mvp.view * vec4( in_position, 1.0 );    out_uv = in_uv;}
\ No newline at end of file
+#version 450// BINDINGlayout ( set = 0, binding = 0 ) uniform ModelViewProj {    mat4 model;    mat4 view;    mat4 proj;} mvp;// INPUTlayout ( location = 0 ) in vec3 in_position;layout ( location = 1 ) in vec2 in_uv;layout ( location = 2 ) in vec3 in_normal;layout ( location = 3 ) in vec3 in_tangent;layout ( location = 4 ) in vec3 in_bitangent;// OUTPUTlayout ( location = 0 ) out vec2 out_uv;layout ( location = 4 ) flat out uint out_surface_id;// SHADER ENTRY POINTvoid main( ){    gl_Position = mvp.proj * mvp.view * vec4( in_position, 1.0 );    out_uv = in_uv;    // Indirect draws pass the material of their mesh as the first instance.    out_surface_id = gl_InstanceIndex;}
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Cold and warm page cache loads of asset files: the former stream read against MappedFile, and StbImageLoader for images.
+// ShaderModule reads its .spv through MappedFile, which is what the mapped column measures for shader binaries. Cold loads
+// evict the file from the page cache first, which is only supported on Linux.
+#include "bench_timer.h"
+
+#include <__image/StbImageLoader.h>
+#include <__io/MappedFile.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+    using namespace cobalt;
+    using namespace cobalt::bench;
+
+    constexpr int WARM_RUN_COUNT{ 10 };
+    constexpr size_t PAGE_SIZE{ 4096u };
+
+
+    // Drops the clean pages of the file, the next read comes from the disk again.
+    bool evict_from_page_cache( std::filesystem::path const& path )
+    {
+#ifdef __linux__
+        int const fd = ::open( path.c_str( ), O_RDONLY );
+        if ( fd < 0 )
+        {
+            return false;
+        }
+        bool const evicted = ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED ) == 0;
+        ::close( fd );
+        return evicted;
+#else
+        static_cast<void>( path );
+        return false;
+#endif
+    }
+
+
+    // How shader binaries were read before they were mapped: a full copy through a stream.
+    void stream_read( std::filesystem::path const& path )
+    {
+        std::ifstream file{ path, std::ios::ate | std::ios::binary };
+        std::vector<char> buffer( static_cast<size_t>( file.tellg( ) ) );
+        file.seekg( 0 );
+        file.read( buffer.data( ), static_cast<std::streamsize>( buffer.size( ) ) );
+        do_not_optimize( buffer.data( ) );
+    }
+
+
+    // Mapping alone does not read anything, every page is touched as a consumer would.
+    void mapped_read( std::filesystem::path const& path )
+    {
+        io::MappedFile const file{ path };
+        uint64_t sum{ 0u };
+        for ( size_t offset{}; offset < file.size( ); offset += PAGE_SIZE )
+        {
+            sum += static_cast<uint64_t>( file.data( )[offset] );
+        }
+        do_not_optimize( sum );
+    }
+
+
+    void stb_decode( std::filesystem::path const& path )
+    {
+        bool const is_hdr = path.extension( ) == ".hdr";
+        StbImageLoader const image{ path, 4u, is_hdr };
+        do_not_optimize( image.pixels( ) );
+    }
+
+
+    [[nodiscard]] bool is_image( std::filesystem::path const& path )
+    {
+        constexpr std::array extensions{ ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".hdr" };
+        return std::ranges::find( extensions, path.extension( ).string( ) ) != extensions.end( );
+    }
+
+
+    template <typename fn_t>
+    void bench_load( char const* name, std::filesystem::path const& path, fn_t&& load )
+    {
+        std::optional<double> cold_ms{};
+        if ( evict_from_page_cache( path ) )
+        {
+            cold_ms = best_of( 1, [&] { load( path ); } );
+        }
+        double const warm_ms = best_of( WARM_RUN_COUNT, [&] { load( path ); } );
+
+        if ( cold_ms )
+        {
+            std::printf( "  %-16s cold %10.3f ms   warm %10.3f ms\n", name, *cold_ms, warm_ms );
+        }
+        else
+        {
+            std::printf( "  %-16s cold        n/a      warm %10.3f ms\n", name, warm_ms );
+        }
+    }
+
+}
+
+
+int main( int const argc, char** argv )
+{
+    if ( argc < 2 )
+    {
+        std::printf( "usage: %s <file>...\n", argv[0] );
+        return 1;
+    }
+
+    for ( int i{ 1 }; i < argc; ++i )
+    {
+        std::filesystem::path const path{ argv[i] };
+        if ( not std::filesystem::is_regular_file( path ) )
+        {
+            std::printf( "%s: not a file, skipped.\n", argv[i] );
+            continue;
+        }
+
+        std::printf( "%s (%ju bytes)\n", argv[i], static_cast<uintmax_t>( std::filesystem::file_size( path ) ) );
+        bench_load( "stream read", path, stream_read );
+        bench_load( "mapped read", path, mapped_read );
+        if ( is_image( path ) )
+        {
+            bench_load( "stb decode", path, stb_decode );
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Cost of a handle dereference against raw and shared pointers. Built twice, with and without handle validation, build in
+// Release as Debug builds of the library always validate.
+#include "bench_timer.h"
+
+#include <__memory/handle/ResourceHandle.h>
+#include <__memory/handle/ResourcePool.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+    using namespace cobalt::bench;
+
+    constexpr size_t DEREFERENCE_COUNT{ 20'000'000u };
+    constexpr int RUN_COUNT{ 5 };
+
+
+    struct Payload
+    {
+        explicit Payload( uint64_t const value )
+            : value{ value } { }
+
+        uint64_t value{ 0u };
+    };
+
+
+    // Visits the resources in a fixed random order, so large sets do not get a free ride from the prefetcher.
+    std::vector<uint32_t> make_order( size_t const count )
+    {
+        std::vector<uint32_t> order( count );
+        std::iota( order.begin( ), order.end( ), 0u );
+        std::ranges::shuffle( order, std::mt19937{ 7u } );
+        return order;
+    }
+
+
+    template <typename pointer_t>
+    double dereference_all( std::vector<pointer_t>& pointers, std::vector<uint32_t> const& order )
+    {
+        return best_of( RUN_COUNT, [&]
+        {
+            uint64_t sum{ 0u };
+            for ( size_t i{}; i < DEREFERENCE_COUNT; )
+            {
+                for ( size_t j{}; j < order.size( ) && i < DEREFERENCE_COUNT; ++j, ++i )
+                {
+                    sum += pointers[order[j]]->value;
+                }
+            }
+            do_not_optimize( sum );
+        } );
+    }
+
+
+    void bench_resource_count( size_t const count )
+    {
+        std::printf( "%zu resources, %zu dereferences\n", count, DEREFERENCE_COUNT );
+        std::vector<uint32_t> const order = make_order( count );
+
+        // Raw pointers into separate allocations, the floor of any indirection.
+        std::vector<std::unique_ptr<Payload>> owners{};
+        std::vector<Payload*> raw_pointers{};
+        std::vector<std::shared_ptr<Payload>> shared_pointers{};
+        for ( size_t i{}; i < count; ++i )
+        {
+            raw_pointers.push_back( owners.emplace_back( std::make_unique<Payload>( i ) ).get( ) );
+            shared_pointers.push_back( std::make_shared<Payload>( i ) );
+        }
+
+        memory::ResourcePool<Payload> pool{};
+        std::vector<ResourceHandle<Payload>> handles{};
+        for ( size_t i{}; i < count; ++i )
+        {
+            handles.emplace_back( pool, pool.emplace( i, i ) );
+        }
+
+        report( "raw pointer", dereference_all( raw_pointers, order ), DEREFERENCE_COUNT );
+        report( "shared_ptr", dereference_all( shared_pointers, order ), DEREFERENCE_COUNT );
+        report( "handle", dereference_all( handles, order ), DEREFERENCE_COUNT );
+    }
+
+}
+
+
+int main( )
+{
+    std::printf( "handle validation %s\n", memory::ENABLE_HANDLE_VALIDATION ? "on" : "off" );
+    bench_resource_count( 64u );
+    bench_resource_count( 100'000u );
+    return 0;
+}
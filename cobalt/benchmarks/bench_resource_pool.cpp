@@ -0,0 +1,160 @@
+// Creation, dereference and destruction of 100k resources through CVK, against shared pointers as a baseline.
+#include "bench_timer.h"
+
+#include <__memory/Resource.h>
+#include <__singleton/CobaltVK.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+    using namespace cobalt::bench;
+
+    constexpr size_t RESOURCE_COUNT{ 100'000u };
+    constexpr int RUN_COUNT{ 10 };
+
+
+    class DummyResource final : public memory::Resource
+    {
+    public:
+        explicit DummyResource( uint64_t const value )
+            : value_{ value } { }
+
+        [[nodiscard]] uint64_t value( ) const
+        {
+            return value_;
+        }
+
+    private:
+        uint64_t value_{ 0u };
+
+    };
+
+
+    void bench_handles( )
+    {
+        std::vector<ResourceHandle<DummyResource>> handles{};
+        handles.reserve( RESOURCE_COUNT );
+
+        double create_ms{ 0. };
+        double read_ms{ 0. };
+        double destroy_ms{ 0. };
+        for ( int run{}; run < RUN_COUNT; ++run )
+        {
+            // 1. Create, the pool grows by chunks on the first run and reuses its slots afterwards.
+            double const create = best_of( 1, [&]
+            {
+                for ( size_t i{}; i < RESOURCE_COUNT; ++i )
+                {
+                    handles.push_back( CVK.create_resource<DummyResource>( i ) );
+                }
+            } );
+
+            // 2. Dereference every handle once.
+            double const read = best_of( 1, [&]
+            {
+                uint64_t sum{ 0u };
+                for ( auto& handle : handles )
+                {
+                    sum += handle->value( );
+                }
+                do_not_optimize( sum );
+            } );
+
+            // 3. Drop the last owners, which retires the resources, and destroy them as if their frame had completed.
+            double const destroy = best_of( 1, [&]
+            {
+                handles.clear( );
+                CVK.deletion_queue( ).flush( );
+            } );
+
+            create_ms  = run == 0 ? create : std::min( create_ms, create );
+            read_ms    = run == 0 ? read : std::min( read_ms, read );
+            destroy_ms = run == 0 ? destroy : std::min( destroy_ms, destroy );
+        }
+
+        report( "handle create", create_ms, RESOURCE_COUNT );
+        report( "handle dereference", read_ms, RESOURCE_COUNT );
+        report( "handle destroy", destroy_ms, RESOURCE_COUNT );
+    }
+
+
+    void bench_shared_pointers( )
+    {
+        std::vector<std::shared_ptr<DummyResource>> pointers{};
+        pointers.reserve( RESOURCE_COUNT );
+
+        double create_ms{ 0. };
+        double read_ms{ 0. };
+        double destroy_ms{ 0. };
+        for ( int run{}; run < RUN_COUNT; ++run )
+        {
+            double const create = best_of( 1, [&]
+            {
+                for ( size_t i{}; i < RESOURCE_COUNT; ++i )
+                {
+                    pointers.push_back( std::make_shared<DummyResource>( i ) );
+                }
+            } );
+
+            double const read = best_of( 1, [&]
+            {
+                uint64_t sum{ 0u };
+                for ( auto const& pointer : pointers )
+                {
+                    sum += pointer->value( );
+                }
+                do_not_optimize( sum );
+            } );
+
+            double const destroy = best_of( 1, [&] { pointers.clear( ); } );
+
+            create_ms  = run == 0 ? create : std::min( create_ms, create );
+            read_ms    = run == 0 ? read : std::min( read_ms, read );
+            destroy_ms = run == 0 ? destroy : std::min( destroy_ms, destroy );
+        }
+
+        report( "shared_ptr create", create_ms, RESOURCE_COUNT );
+        report( "shared_ptr dereference", read_ms, RESOURCE_COUNT );
+        report( "shared_ptr destroy", destroy_ms, RESOURCE_COUNT );
+    }
+
+
+    // Create and drop one resource at a time, with a frame collected every 64 resources like a streaming workload.
+    void bench_churn( )
+    {
+        double const churn_ms = best_of( RUN_COUNT, [&]
+        {
+            auto& queue = CVK.deletion_queue( );
+            for ( size_t i{}; i < RESOURCE_COUNT; ++i )
+            {
+                auto handle = CVK.create_resource<DummyResource>( i );
+                do_not_optimize( handle->value( ) );
+                if ( i % 64u == 63u )
+                {
+                    queue.advance( queue.current_frame( ) + 1u );
+                    queue.collect( queue.current_frame( ) - 1u );
+                }
+            }
+            queue.flush( );
+        } );
+        report( "handle churn", churn_ms, RESOURCE_COUNT );
+    }
+
+}
+
+
+int main( )
+{
+    bench_handles( );
+    bench_shared_pointers( );
+    bench_churn( );
+
+    CVK.reset_instance( );
+    return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef COBALT_BENCH_TIMER_H
+#define COBALT_BENCH_TIMER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+
+namespace cobalt::bench
+{
+    // Keeps the optimizer from dropping work whose result is otherwise unused.
+    template <typename value_t>
+    void do_not_optimize( value_t const& value )
+    {
+#if defined( _MSC_VER )
+        static_cast<void>( *static_cast<value_t const volatile*>( &value ) );
+#else
+        asm volatile( "" : : "r,m"( value ) : "memory" );
+#endif
+    }
+
+
+    // Best of a few runs in milliseconds, the minimum is the least disturbed by the rest of the system.
+    template <typename fn_t>
+    double best_of( int const runs, fn_t&& fn )
+    {
+        double best{ std::numeric_limits<double>::max( ) };
+        for ( int run{}; run < runs; ++run )
+        {
+            auto const start = std::chrono::steady_clock::now( );
+            fn( );
+            auto const end = std::chrono::steady_clock::now( );
+            best = std::min( best, std::chrono::duration<double, std::milli>( end - start ).count( ) );
+        }
+        return best;
+    }
+
+
+    inline void report( char const* name, double const ms, size_t const operations )
+    {
+        std::printf( "%-40s %10.3f ms %10.2f ns/op\n", name, ms, ms * 1e6 / static_cast<double>( operations ) );
+    }
+
+}
+
+
+#endif //!COBALT_BENCH_TIMER_H
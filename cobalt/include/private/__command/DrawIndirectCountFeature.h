@@ -0,0 +1,34 @@
+#ifndef DRAWINDIRECTCOUNTFEATURE_H
+#define DRAWINDIRECTCOUNTFEATURE_H
+
+#include "FeatureCommand.h"
+
+
+namespace cobalt::exe
+{
+    // Indirect draws reading their draw count from a buffer, e.g. one written by a culling pass.
+    class DrawIndirectCountFeature final : public FeatureCommand
+    {
+    public:
+        bool validate( ValidationData const& data ) const override
+        {
+            // Core since Vulkan 1.2, its support is reported in the 1.2 features only.
+            VkPhysicalDeviceVulkan12Features features12{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+            VkPhysicalDeviceFeatures2 features{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &features12 };
+            vkGetPhysicalDeviceFeatures2( data.device, &features );
+            return features12.drawIndirectCount;
+        }
+
+
+        void enable( EnableData& data ) override
+        {
+            data.features12.drawIndirectCount = VK_TRUE;
+        }
+
+    };
+
+
+}
+
+
+#endif //!DRAWINDIRECTCOUNTFEATURE_H
@@ -0,0 +1,31 @@
+#ifndef MULTIDRAWINDIRECTFEATURE_H
+#define MULTIDRAWINDIRECTFEATURE_H
+
+#include "FeatureCommand.h"
+
+
+namespace cobalt::exe
+{
+    // Several draws per indirect call, each passing its own first instance to the shaders.
+    class MultiDrawIndirectFeature final : public FeatureCommand
+    {
+    public:
+        bool validate( ValidationData const& data ) const override
+        {
+            return data.features.features.multiDrawIndirect && data.features.features.drawIndirectFirstInstance;
+        }
+
+
+        void enable( EnableData& data ) override
+        {
+            data.features.features.multiDrawIndirect         = VK_TRUE;
+            data.features.features.drawIndirectFirstInstance = VK_TRUE;
+        }
+
+    };
+
+
+}
+
+
+#endif //!MULTIDRAWINDIRECTFEATURE_H
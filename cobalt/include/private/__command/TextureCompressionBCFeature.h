@@ -0,0 +1,28 @@
+#ifndef TEXTURECOMPRESSIONBCFEATURE_H
+#define TEXTURECOMPRESSIONBCFEATURE_H
+
+#include "FeatureCommand.h"
+
+
+namespace cobalt::exe
+{
+    class TextureCompressionBCFeature final : public FeatureCommand
+    {
+    public:
+        bool validate( ValidationData const& data ) const override
+        {
+            return data.features.features.textureCompressionBC;
+        }
+
+
+        void enable( EnableData& data ) override
+        {
+            data.features.features.textureCompressionBC = VK_TRUE;
+        }
+
+    };
+
+}
+
+
+#endif //!TEXTURECOMPRESSIONBCFEATURE_H
@@ -0,0 +1,19 @@
+#ifndef QUEUE_LOCK_H
+#define QUEUE_LOCK_H
+
+#include <mutex>
+
+
+namespace cobalt::sync
+{
+    /**
+     * Queues must be externally synchronized. Uploads and streamed textures are submitted from background threads and the
+     * graphics and present queues may alias the same VkQueue, so every queue operation goes through this one lock. Waiting
+     * for the whole device has to hold it as well, it synchronizes every queue of the device.
+     */
+    [[nodiscard]] std::mutex& queue_mutex( );
+
+}
+
+
+#endif //!QUEUE_LOCK_H
@@ -0,0 +1,104 @@
+#ifndef KTX2IMAGELOADER_H
+#define KTX2IMAGELOADER_H
+
+#include <__io/MappedFile.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+
+namespace cobalt::image
+{
+    static constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER{
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+
+
+    struct Ktx2Header
+    {
+        std::array<uint8_t, 12> identifier{};
+        uint32_t vk_format{};
+        uint32_t type_size{};
+        uint32_t pixel_width{};
+        uint32_t pixel_height{};
+        uint32_t pixel_depth{};
+        uint32_t layer_count{};
+        uint32_t face_count{};
+        uint32_t level_count{};
+        uint32_t supercompression_scheme{};
+
+        uint32_t dfd_byte_offset{};
+        uint32_t dfd_byte_length{};
+        uint32_t kvd_byte_offset{};
+        uint32_t kvd_byte_length{};
+        uint64_t sgd_byte_offset{};
+        uint64_t sgd_byte_length{};
+    };
+
+
+    struct Ktx2LevelIndex
+    {
+        uint64_t byte_offset{};
+        uint64_t byte_length{};
+        uint64_t uncompressed_byte_length{};
+    };
+
+
+    static_assert( sizeof( Ktx2Header ) == 80u && sizeof( Ktx2LevelIndex ) == 24u, "KTX2 tables are read as raw bytes" );
+}
+
+namespace cobalt
+{
+    /**
+     * Maps a KTX2 file holding a single, not supercompressed 2D texture. The level payloads are read in place from the mapping
+     * so they can be staged without an intermediate copy. Unsupported or malformed files leave the loader invalid.
+     */
+    class Ktx2ImageLoader final
+    {
+    public:
+        explicit Ktx2ImageLoader( std::filesystem::path const& path );
+        ~Ktx2ImageLoader( ) noexcept = default;
+
+        Ktx2ImageLoader( const Ktx2ImageLoader& )                = delete;
+        Ktx2ImageLoader( Ktx2ImageLoader&& ) noexcept            = delete;
+        Ktx2ImageLoader& operator=( const Ktx2ImageLoader& )     = delete;
+        Ktx2ImageLoader& operator=( Ktx2ImageLoader&& ) noexcept = delete;
+
+        [[nodiscard]] bool is_valid( ) const noexcept;
+
+        [[nodiscard]] VkFormat format( ) const noexcept;
+        [[nodiscard]] VkComponentMapping swizzle( ) const noexcept;
+
+        [[nodiscard]] uint32_t img_width( ) const noexcept;
+        [[nodiscard]] uint32_t img_height( ) const noexcept;
+        [[nodiscard]] uint32_t mip_levels( ) const noexcept;
+
+        // Every level lies in one contiguous range of the file, the offsets are relative to its start.
+        [[nodiscard]] std::span<std::byte const> level_data( ) const noexcept;
+        [[nodiscard]] uint64_t level_offset( uint32_t level ) const;
+        [[nodiscard]] uint64_t level_size( uint32_t level ) const;
+
+    private:
+        io::MappedFile file_;
+        bool valid_{ false };
+
+        image::Ktx2Header header_{};
+        std::vector<image::Ktx2LevelIndex> levels_{};
+        VkComponentMapping swizzle_{};
+
+        uint64_t data_begin_{ 0u };
+        uint64_t data_end_{ 0u };
+
+        [[nodiscard]] bool parse( );
+        void parse_key_values( );
+
+    };
+
+}
+
+
+#endif //!KTX2IMAGELOADER_H
@@ -16,7 +16,7 @@ namespace cobalt
 {
     class StbImageLoader final
     {
-        using load_fn_t = void* ( * )( char const*, int*, int*, int*, int );
+        using load_fn_t = void* ( * )( unsigned char const*, int, int*, int*, int*, int );
     public:
         explicit StbImageLoader( std::filesystem::path const& path, uint32_t channels, bool f_load = false );
         ~StbImageLoader( ) noexcept;
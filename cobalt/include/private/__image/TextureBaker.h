@@ -0,0 +1,39 @@
+#ifndef TEXTUREBAKER_H
+#define TEXTUREBAKER_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <filesystem>
+
+
+namespace cobalt::image
+{
+    struct TextureBakeInfo
+    {
+        // One of BC4_UNORM, BC5_UNORM, BC7_UNORM or BC7_SRGB.
+        VkFormat format{ VK_FORMAT_UNDEFINED };
+
+        // BC4 only: the source channel to keep and whether its values are sRGB encoded and must be linearized first.
+        uint32_t source_channel{ 0u };
+        bool linearize_source{ false };
+    };
+
+
+    // Where the baked texture of a source image lives, next to the source and tagged with the bake settings.
+    [[nodiscard]] std::filesystem::path baked_texture_path( std::filesystem::path const& source, TextureBakeInfo const& );
+
+    // Whether the baked texture is missing or older than its source.
+    [[nodiscard]] bool is_bake_outdated( std::filesystem::path const& source, std::filesystem::path const& baked );
+
+    /**
+     * Decodes the source image, builds the full mip chain on the CPU, block compresses every level and writes the result as
+     * a KTX2 file. Single channel formats store a KTXswizzle that broadcasts red, so shaders reading any color channel
+     * keep working. Returns false if the source cannot be decoded or the file cannot be written.
+     */
+    [[nodiscard]] bool bake_texture( std::filesystem::path const& source, std::filesystem::path const& destination,
+                                     TextureBakeInfo const& );
+
+}
+
+
+#endif //!TEXTUREBAKER_H
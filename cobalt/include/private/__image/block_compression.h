@@ -0,0 +1,39 @@
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace cobalt::image
+{
+    // Texel footprint of every BC format.
+    static constexpr uint32_t BC_BLOCK_DIMENSION{ 4u };
+
+
+    [[nodiscard]] constexpr uint32_t block_count( uint32_t const texels ) noexcept
+    {
+        return ( texels + BC_BLOCK_DIMENSION - 1u ) / BC_BLOCK_DIMENSION;
+    }
+
+
+    /**
+     * CPU block encoders. The input is tightly packed RGBA8, partial edge blocks repeat the last row/column. The output holds
+     * one block per 4x4 footprint in row-major order, ready to be copied into a compressed image.
+     */
+    // Single channel, 8 bytes per block.
+    [[nodiscard]] std::vector<std::byte> encode_bc4( std::span<uint8_t const> rgba, uint32_t width, uint32_t height,
+                                                     uint32_t channel );
+
+    // Red and green channels as two BC4 blocks, 16 bytes per block.
+    [[nodiscard]] std::vector<std::byte> encode_bc5( std::span<uint8_t const> rgba, uint32_t width, uint32_t height );
+
+    // RGBA in single-subset mode 6, 16 bytes per block.
+    [[nodiscard]] std::vector<std::byte> encode_bc7( std::span<uint8_t const> rgba, uint32_t width, uint32_t height );
+
+}
+
+
+#endif //!BLOCK_COMPRESSION_H
@@ -0,0 +1,48 @@
+#ifndef BUDDYALLOCATOR_H
+#define BUDDYALLOCATOR_H
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+namespace cobalt::memory
+{
+    /**
+     * Offset-only buddy allocator over a power of two range. Requests are rounded up to a power of two node, which is
+     * aligned to its own size, so any power of two alignment up to the node size comes for free. Freed nodes merge with
+     * their buddy as soon as both halves are free, keeping long-lived allocations from fragmenting the range. Pure CPU
+     * bookkeeping, the memory itself is owned by the caller.
+     */
+    class BuddyAllocator final
+    {
+    public:
+        explicit BuddyAllocator( uint64_t capacity, uint64_t min_node_size );
+
+        [[nodiscard]] std::optional<uint64_t> allocate( uint64_t size, uint64_t alignment );
+        void free( uint64_t offset );
+
+        [[nodiscard]] uint64_t capacity( ) const;
+        [[nodiscard]] uint64_t used( ) const;
+        [[nodiscard]] bool empty( ) const;
+
+    private:
+        uint64_t const capacity_;
+        uint64_t const min_node_size_;
+        uint32_t const max_order_;
+
+        // Free node offsets per order, order 0 being min_node_size_. Sets hand out the lowest offset first.
+        std::vector<std::set<uint64_t>> free_nodes_{};
+        std::unordered_map<uint64_t, uint32_t> allocated_orders_{};
+        uint64_t used_{ 0u };
+
+        [[nodiscard]] uint64_t node_size( uint32_t order ) const;
+
+    };
+
+}
+
+
+#endif //!BUDDYALLOCATOR_H
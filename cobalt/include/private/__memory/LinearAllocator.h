@@ -0,0 +1,38 @@
+#ifndef LINEARALLOCATOR_H
+#define LINEARALLOCATOR_H
+
+#include <cstdint>
+#include <optional>
+
+
+namespace cobalt::memory
+{
+    /**
+     * Bump allocator for short-lived memory such as staging data. Frees only count down the live allocations, the whole
+     * range is reclaimed at once when the last one is released. Pure CPU bookkeeping, the memory itself is owned by the
+     * caller.
+     */
+    class LinearAllocator final
+    {
+    public:
+        explicit LinearAllocator( uint64_t capacity );
+
+        [[nodiscard]] std::optional<uint64_t> allocate( uint64_t size, uint64_t alignment );
+        void free( );
+
+        [[nodiscard]] uint64_t capacity( ) const;
+        [[nodiscard]] uint64_t used( ) const;
+        [[nodiscard]] bool empty( ) const;
+
+    private:
+        uint64_t const capacity_;
+
+        uint64_t head_{ 0u };
+        uint32_t live_count_{ 0u };
+
+    };
+
+}
+
+
+#endif //!LINEARALLOCATOR_H
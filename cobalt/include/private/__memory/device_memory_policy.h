@@ -0,0 +1,34 @@
+#ifndef DEVICE_MEMORY_POLICY_H
+#define DEVICE_MEMORY_POLICY_H
+
+#include <__memory/DeviceAllocator.h>
+
+#include <cstdint>
+
+
+namespace cobalt::memory
+{
+    // Placement decisions of the DeviceAllocator. They only depend on the memory properties of the device, not on the device
+    // itself.
+
+    /**
+     * First memory type allowed by the filter that has every requested property.
+     * @throws std::runtime_error if there is none.
+     */
+    [[nodiscard]] uint32_t find_memory_type( VkPhysicalDeviceMemoryProperties const&, uint32_t type_filter,
+                                             VkMemoryPropertyFlags properties );
+
+    // Block size of the pools of a memory type, clamped to an eighth of its heap and never below the allocation granularity.
+    [[nodiscard]] VkDeviceSize pool_block_size( VkPhysicalDeviceMemoryProperties const&, DeviceAllocatorCreateInfo const&,
+                                                uint32_t memory_type, AllocationLifetime );
+
+    // Pool of a request within DeviceAllocator::POOLS_PER_MEMORY_TYPE pools per memory type.
+    [[nodiscard]] uint32_t pool_index( uint32_t memory_type, AllocationRequest const& );
+
+    // Whether the request would waste most of a block and gets memory of its own instead.
+    [[nodiscard]] bool requires_dedicated( VkDeviceSize size, VkDeviceSize block_size );
+
+}
+
+
+#endif //!DEVICE_MEMORY_POLICY_H
@@ -0,0 +1,56 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace cobalt::mesh
+{
+    // Post-transform cache size the optimizer targets and the ACMR is measured against.
+    static constexpr uint32_t VERTEX_CACHE_SIZE{ 32u };
+
+    // Sentinel of the fetch remap for vertices no triangle references.
+    static constexpr uint32_t UNUSED_VERTEX{ UINT32_MAX };
+
+    // Most vertices a mesh can have with 16-bit indices. The largest value is kept free as it doubles as the primitive
+    // restart index.
+    static constexpr uint32_t MAX_SHORT_INDEX_VERTEX_COUNT{ UINT16_MAX };
+
+
+    /**
+     * Reorders the triangles of an indexed triangle list for post-transform cache hits, following Forsyth's linear-speed
+     * algorithm. Indices are local to the mesh and must be below vertex_count.
+     */
+    void optimize_vertex_cache( std::span<uint32_t> indices, uint32_t vertex_count );
+
+    /**
+     * Renumbers the vertices in the order the triangles first reference them, so the vertex fetch walks memory forward. The
+     * indices are rewritten in place and the returned remap maps every old vertex to its new slot, or UNUSED_VERTEX.
+     */
+    [[nodiscard]] std::vector<uint32_t> optimize_vertex_fetch( std::span<uint32_t> indices, uint32_t vertex_count );
+
+    /**
+     * Simplifies a triangle list by vertex clustering: vertices are snapped to a grid of cubic cells, each cell keeps the
+     * vertex closest to its average position and triangles collapsing to fewer than three cells are removed. The output
+     * indexes the same vertices, so a level of detail only costs an extra index range. Vertices facing different directions
+     * are clustered apart to keep hard edges.
+     */
+    [[nodiscard]] std::vector<uint32_t> simplify_clustered( std::span<uint32_t const> indices,
+                                                            std::span<glm::vec3 const> positions,
+                                                            std::span<glm::vec3 const> normals, float cell_size );
+
+    // Whether indices relative to the mesh's first vertex fit in 16 bits.
+    [[nodiscard]] bool fits_short_indices( uint32_t vertex_count );
+
+    // Average cache miss ratio: transformed vertices per triangle on a FIFO cache, 0.5 is ideal and 3.0 the worst case.
+    [[nodiscard]] float calculate_acmr( std::span<uint32_t const> indices, uint32_t vertex_count,
+                                        uint32_t cache_size = VERTEX_CACHE_SIZE );
+
+}
+
+
+#endif //!MESH_OPTIMIZER_H
@@ -12,6 +12,7 @@ namespace cobalt::query
 
     [[nodiscard]] VkFormat find_depth_format( VkPhysicalDevice );
     [[nodiscard]] VkFormat select_format( std::vector<VkFormat> const&, VkPhysicalDevice, VkImageTiling, VkFormatFeatureFlags );
+    [[nodiscard]] bool supports_format_features( VkPhysicalDevice, VkFormat, VkImageTiling, VkFormatFeatureFlags );
 
     [[nodiscard]] bool has_stencil_component( VkFormat format );
 }
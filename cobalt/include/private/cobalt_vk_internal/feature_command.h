@@ -3,12 +3,15 @@
 
 
 #include "../__command/AnisotropySamplingFeature.h"
+#include "../__command/DrawIndirectCountFeature.h"
 #include "../__command/DynamicRenderingFeature.h"
 #include "../__command/FamilyIndicesFeature.h"
 #include "../__command/FeatureCommand.h"
+#include "../__command/MultiDrawIndirectFeature.h"
 #include "../__command/ShaderImgArrNonUniIdxFeature.h"
 #include "../__command/SwapchainAdequateFeature.h"
 #include "../__command/Synchronization2Feature.h"
+#include "../__command/TextureCompressionBCFeature.h"
 
 
 #endif //!FEATURE_COMMAND_PCH_H
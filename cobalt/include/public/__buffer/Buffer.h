@@ -4,6 +4,7 @@
 #include <__memory/Resource.h>
 
 #include <__enum/BufferContentType.h>
+#include <__memory/DeviceAllocator.h>
 
 #include <vulkan/vulkan_core.h>
 
@@ -15,6 +16,7 @@ namespace cobalt
     class DeviceSet;
     class CommandPool;
     class Image;
+    class UploadContext;
 }
 
 namespace cobalt
@@ -23,7 +25,8 @@ namespace cobalt
     {
     public:
         explicit Buffer( DeviceSet const&, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
-                         buffer::BufferContentType content_type = buffer::BufferContentType::ANY );
+                         buffer::BufferContentType content_type = buffer::BufferContentType::ANY,
+                         memory::AllocationLifetime lifetime = memory::AllocationLifetime::PERSISTENT );
         ~Buffer( ) noexcept override;
 
         Buffer( Buffer&& ) noexcept;
@@ -33,13 +36,18 @@ namespace cobalt
 
         [[nodiscard]] VkBuffer handle( ) const;
         [[nodiscard]] VkDeviceMemory memory( ) const;
+        [[nodiscard]] VkDeviceSize memory_offset( ) const;
 
         [[nodiscard]] buffer::BufferContentType content_type( ) const;
         [[nodiscard]] VkDeviceSize buffer_size( ) const;
         [[nodiscard]] VkDeviceSize memory_size( ) const;
 
+        // Host pointer to the mapped range, null while unmapped.
+        [[nodiscard]] void* data( ) const;
+
         void write( void const* data, size_t size ) const;
-        void map_memory( VkDeviceSize offset = 0, VkMemoryMapFlags flags = 0 );
+        void read( void* data, size_t size ) const;
+        void map_memory( VkDeviceSize offset = 0 );
         void unmap_memory( );
 
         void copy_to( Buffer const& dst, CommandPool& cmd_pool ) const;
@@ -51,10 +59,9 @@ namespace cobalt
         buffer::BufferContentType const content_type_;
 
         VkDeviceSize const buffer_size_{};
-        VkDeviceSize memory_size_{};
 
         VkBuffer buffer_{ VK_NULL_HANDLE };
-        VkDeviceMemory buffer_memory_{ VK_NULL_HANDLE };
+        memory::DeviceAllocation allocation_{};
         void* memory_map_ptr_{ nullptr };
 
         // todo: might want to upgrade to VkMemoryRequirements2
@@ -68,9 +75,12 @@ namespace cobalt
         {
             [[nodiscard]] Buffer allocate_data_buffer( DeviceSet const&, CommandPool&, void const* data, VkDeviceSize size,
                                                        VkBufferUsageFlags main_usage_bit, BufferContentType content_type );
+            [[nodiscard]] Buffer allocate_data_buffer( UploadContext&, void const* data, VkDeviceSize size,
+                                                       VkBufferUsageFlags main_usage_bit, BufferContentType content_type );
         }
 
         [[nodiscard]] Buffer make_staging_buffer( DeviceSet const&, VkDeviceSize size );
+        [[nodiscard]] Buffer make_readback_buffer( DeviceSet const&, VkDeviceSize size );
         [[nodiscard]] Buffer make_uniform_buffer( DeviceSet const&, VkDeviceSize size );
 
 
@@ -91,6 +101,24 @@ namespace cobalt
                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT, to_buffer_content_type<i_t>( ) );
         }
 
+
+        template <typename v_t>
+        [[nodiscard]] Buffer make_vertex_buffer( UploadContext& upload_context, std::span<v_t const> vertices )
+        {
+            return internal::allocate_data_buffer(
+                upload_context, vertices.data( ), vertices.size_bytes( ),
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, BufferContentType::VERTEX );
+        }
+
+
+        template <typename i_t>
+        [[nodiscard]] Buffer make_index_buffer( UploadContext& upload_context, std::span<i_t const> indices )
+        {
+            return internal::allocate_data_buffer(
+                upload_context, indices.data( ), indices.size_bytes( ),
+                VK_BUFFER_USAGE_INDEX_BUFFER_BIT, to_buffer_content_type<i_t>( ) );
+        }
+
     }
 
 }
@@ -48,6 +48,7 @@ namespace cobalt
 
         void bind_vertex_buffers( Buffer const&, VkDeviceSize offset ) const;
         void bind_index_buffer( Buffer const&, VkDeviceSize offset ) const;
+        void bind_index_buffer( Buffer const&, VkDeviceSize offset, VkIndexType ) const;
 
         void push_constants( Pipeline const&, VkShaderStageFlags, uint32_t offset, uint32_t size, void const* data ) const;
 
@@ -56,8 +57,24 @@ namespace cobalt
         void draw_indexed( uint32_t index_count, uint32_t instance_count, uint32_t index_offset = 0u,
                            int32_t vertex_offset = 0u, uint32_t instance_offset = 0u ) const;
 
+        // Draws are read from tightly packed VkDrawIndexedIndirectCommand unless another stride is given.
+        void draw_indexed_indirect( Buffer const& commands, VkDeviceSize offset, uint32_t draw_count,
+                                    uint32_t stride = sizeof( VkDrawIndexedIndirectCommand ) ) const;
+        void draw_indexed_indirect_count( Buffer const& commands, VkDeviceSize offset, Buffer const& count,
+                                          VkDeviceSize count_offset, uint32_t max_draw_count,
+                                          uint32_t stride = sizeof( VkDrawIndexedIndirectCommand ) ) const;
+
+        void dispatch( uint32_t group_count_x, uint32_t group_count_y = 1u, uint32_t group_count_z = 1u ) const;
+
+        // Repeats the 4 byte value over the range, offset and size must be multiples of 4.
+        void fill_buffer( Buffer const&, VkDeviceSize offset, VkDeviceSize size, uint32_t data ) const;
+
         void copy_buffer_to_image( Buffer const& src, Image const& dst, VkBufferImageCopy const& ) const;
+        void copy_buffer_to_image( Buffer const& src, Image const& dst, std::span<VkBufferImageCopy const> ) const;
+        void copy_image_to_buffer( Image const& src, Buffer const& dst, std::span<VkBufferImageCopy const> ) const;
         void copy_buffer( Buffer const& src, Buffer const& dst ) const;
+        void copy_buffer( Buffer const& src, Buffer const& dst, VkBufferCopy const& ) const;
+        void blit_image( Image const& src, Image const& dst, VkImageBlit const&, VkFilter ) const;
 
     private:
         VkCommandBuffer const command_buffer_{ VK_NULL_HANDLE };
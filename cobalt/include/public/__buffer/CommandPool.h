@@ -13,6 +13,7 @@
 
 namespace cobalt
 {
+    class DeviceSet;
     class VkContext;
 }
 
@@ -22,6 +23,7 @@ namespace cobalt
     {
     public:
         explicit CommandPool( VkContext const&, VkCommandPoolCreateFlags pool_type );
+        explicit CommandPool( DeviceSet const&, VkCommandPoolCreateFlags pool_type );
         ~CommandPool( ) noexcept override;
 
         CommandPool( const CommandPool& )                = delete;
@@ -35,7 +37,7 @@ namespace cobalt
         void release( size_t index );
 
     private:
-        VkContext const& context_ref_;
+        DeviceSet const& device_ref_;
 
         VkCommandPoolCreateFlags const pool_type_{ VK_COMMAND_POOL_CREATE_FLAG_BITS_MAX_ENUM };
         VkCommandPool command_pool_{ VK_NULL_HANDLE };
@@ -0,0 +1,95 @@
+#ifndef STAGINGRING_H
+#define STAGINGRING_H
+
+#include <__buffer/Buffer.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+}
+
+namespace cobalt
+{
+    struct StagingRegion
+    {
+        Buffer const* buffer_ptr{ nullptr };
+        VkDeviceSize offset{ 0u };
+        VkDeviceSize size{ 0u };
+        void* data_ptr{ nullptr };
+
+        uint64_t sequence{ UINT64_MAX };
+    };
+
+
+    /**
+     * Persistently mapped, host coherent ring that all staging data is written through. Regions are handed out in order and
+     * given back once the GPU is done reading them: upload batches release theirs when their fence signals, per-frame
+     * streaming ties regions to a frame in flight and retires them after that frame's fence has been waited on. Regions can
+     * be released out of order, the space is only reclaimed up to the oldest region still in flight. Thread safe.
+     */
+    class StagingRing final
+    {
+    public:
+        // Satisfies the bufferOffset rules of buffer to image copies for every format this renderer stages.
+        static constexpr VkDeviceSize DEFAULT_ALIGNMENT{ 16u };
+
+        explicit StagingRing( DeviceSet const&, VkDeviceSize capacity );
+        ~StagingRing( ) noexcept;
+
+        StagingRing( const StagingRing& )                = delete;
+        StagingRing( StagingRing&& ) noexcept            = delete;
+        StagingRing& operator=( const StagingRing& )     = delete;
+        StagingRing& operator=( StagingRing&& ) noexcept = delete;
+
+        [[nodiscard]] Buffer const& buffer( ) const;
+        [[nodiscard]] VkDeviceSize capacity( ) const;
+
+        // Nullopt when the payload exceeds the ring or the regions still in flight leave no room, the caller falls back to a
+        // dedicated staging buffer.
+        [[nodiscard]] std::optional<StagingRegion> allocate( VkDeviceSize size, VkDeviceSize alignment = DEFAULT_ALIGNMENT );
+        void release( StagingRegion const& );
+
+        // Per-frame streaming, the region is released by retire_frame once the frame has been waited on.
+        [[nodiscard]] std::optional<StagingRegion> allocate_for_frame( uint32_t frame_index, VkDeviceSize size,
+                                                                       VkDeviceSize alignment = DEFAULT_ALIGNMENT );
+        void retire_frame( uint32_t frame_index );
+
+    private:
+        struct InFlightSpan
+        {
+            VkDeviceSize begin{ 0u };
+            VkDeviceSize end{ 0u };
+            bool released{ false };
+        };
+
+        Buffer buffer_;
+        VkDeviceSize const capacity_;
+
+        std::mutex mutex_{};
+
+        // Oldest region first, the sequence of the front span is front_sequence_.
+        std::deque<InFlightSpan> in_flight_{};
+        uint64_t front_sequence_{ 0u };
+
+        VkDeviceSize head_{ 0u };
+        VkDeviceSize tail_{ 0u };
+
+        std::vector<std::vector<StagingRegion>> frame_regions_{};
+
+        [[nodiscard]] std::optional<StagingRegion> allocate_locked( VkDeviceSize size, VkDeviceSize alignment );
+        void release_locked( StagingRegion const& );
+
+    };
+
+}
+
+
+#endif //!STAGINGRING_H
@@ -0,0 +1,107 @@
+#ifndef UPLOADCONTEXT_H
+#define UPLOADCONTEXT_H
+
+#include <__buffer/Buffer.h>
+#include <__buffer/CommandOperator.h>
+#include <__buffer/StagingRing.h>
+#include <__synchronization/Fence.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+    class CommandPool;
+    class CommandBuffer;
+    class Image;
+}
+
+namespace cobalt
+{
+    /**
+     * Handed out by UploadContext::submit. It owns the fence of the batch together with the staging memory, which is handed
+     * back to the ring as soon as the fence is observed to be signaled. A pending ticket blocks on destruction.
+     */
+    class UploadTicket final
+    {
+        friend class UploadContext;
+
+    public:
+        UploadTicket( ) = default;
+        ~UploadTicket( ) noexcept;
+
+        UploadTicket( UploadTicket&& ) noexcept;
+        UploadTicket& operator=( UploadTicket&& ) noexcept;
+        UploadTicket( const UploadTicket& )            = delete;
+        UploadTicket& operator=( const UploadTicket& ) = delete;
+
+        [[nodiscard]] bool ready( );
+        void wait( );
+
+    private:
+        CommandBuffer const* cmd_buffer_ptr_{ nullptr };
+        std::unique_ptr<sync::Fence> fence_ptr_{ nullptr };
+
+        StagingRing* staging_ring_ptr_{ nullptr };
+        std::vector<StagingRegion> staging_regions_{};
+        std::vector<Buffer> staging_buffers_{};
+
+        explicit UploadTicket( CommandBuffer const&, std::unique_ptr<sync::Fence> fence, StagingRing&,
+                               std::vector<StagingRegion>&& staging_regions, std::vector<Buffer>&& staging_buffers );
+
+        void release( ) noexcept;
+
+    };
+
+
+    /**
+     * Records every staging copy and layout transition of a batch of uploads into a single command buffer. Nothing reaches the
+     * queue until submit, which issues one submission guarded by one fence instead of one submit_and_wait per resource. Data
+     * is staged through the device's staging ring, only payloads the ring cannot take get a staging buffer of their own.
+     */
+    class UploadContext final
+    {
+    public:
+        explicit UploadContext( DeviceSet const&, CommandPool& );
+        ~UploadContext( ) noexcept;
+
+        UploadContext( const UploadContext& )                = delete;
+        UploadContext( UploadContext&& ) noexcept            = delete;
+        UploadContext& operator=( const UploadContext& )     = delete;
+        UploadContext& operator=( UploadContext&& ) noexcept = delete;
+
+        [[nodiscard]] DeviceSet const& device( ) const;
+        [[nodiscard]] CommandOperator const& command_operator( ) const;
+
+        void upload( Buffer const& dst, void const* data, VkDeviceSize size );
+        void upload( Image& dst, void const* data, VkDeviceSize size );
+
+        // Uploads pre-built levels (e.g. block compressed mip chains), the regions index into the staged data.
+        void upload( Image& dst, void const* data, VkDeviceSize size, std::span<VkBufferImageCopy const> regions );
+
+        [[nodiscard]] UploadTicket submit( );
+
+    private:
+        DeviceSet const& device_ref_;
+        CommandBuffer const& cmd_buffer_ref_;
+
+        std::optional<CommandOperator> cmd_operator_{};
+        std::vector<StagingRegion> staging_regions_{};
+        std::vector<Buffer> staging_buffers_{};
+
+        bool submitted_{ false };
+
+        [[nodiscard]] StagingRegion stage( void const* data, VkDeviceSize size );
+
+    };
+
+}
+
+
+#endif //!UPLOADCONTEXT_H
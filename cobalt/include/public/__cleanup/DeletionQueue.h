@@ -1,12 +1,27 @@
 #ifndef DELETIONQUEUE_H
 #define DELETIONQUEUE_H
 
-#include <functional>
-#include <stack>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 
 namespace cobalt::cleanup
 {
+    // Plain function pointer and payload, queueing one never allocates.
+    struct Deleter
+    {
+        void ( *fn )( void* context, uint64_t payload ){ nullptr };
+        void* context{ nullptr };
+        uint64_t payload{ 0u };
+    };
+
+
+    /**
+     * Deleters keyed by the frame they were pushed in. Whoever submits frames advances the queue to the frame being recorded
+     * and collects the frames whose fence has signalled, so nothing is destroyed while the GPU may still use it and nobody
+     * waits on the device. Frames complete in submission order, collecting a frame collects every earlier one as well.
+     */
     class DeletionQueue final
     {
     public:
@@ -18,12 +33,34 @@ namespace cobalt::cleanup
         DeletionQueue& operator=( DeletionQueue const& )     = delete;
         DeletionQueue& operator=( DeletionQueue&& ) noexcept = delete;
 
-        void push( std::function<void( )>&& deleter );
+        [[nodiscard]] uint64_t current_frame( ) const;
+
+        // Deleters pushed from now on run once the given frame has completed.
+        void advance( uint64_t frame );
+
+        void push( Deleter const& deleter );
+
+        // Runs the deleters of every frame up to and including the completed one, oldest first.
+        void collect( uint64_t completed_frame );
+
+        // Runs everything, the caller guarantees the device is idle.
         void flush( );
-        [[nodiscard]] bool is_flushed() const;
+        [[nodiscard]] bool is_flushed( ) const;
 
     private:
-        std::stack<std::function<void( )>> deleters_{};
+        struct Entry
+        {
+            uint64_t frame{ 0u };
+            Deleter deleter{};
+        };
+
+        // Pushed in frame order, so this is a FIFO. Drained entries are compacted away and the capacity is kept.
+        std::vector<Entry> entries_{};
+        size_t head_{ 0u };
+
+        uint64_t current_frame_{ 0u };
+
+        void run_front( size_t count );
 
     };
 
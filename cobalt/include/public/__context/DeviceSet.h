@@ -5,6 +5,7 @@
 
 #include <__context/Queue.h>
 #include <__enum/DeviceFeatureFlags.h>
+#include <__memory/DeviceAllocator.h>
 
 #include <vulkan/vulkan_core.h>
 
@@ -16,11 +17,20 @@ namespace cobalt
 {
     class ValidationLayers;
     class InstanceBundle;
+    class StagingRing;
+
+    // Features enabled only if the picked device supports them, has_feature tells which ones were.
+    struct OptionalDeviceFeatures
+    {
+        DeviceFeatureFlags flags{ DeviceFeatureFlags::NONE };
+    };
+
 
     class DeviceSet final : public memory::Resource
     {
     public:
         explicit DeviceSet( InstanceBundle const& instance, DeviceFeatureFlags features,
+                            OptionalDeviceFeatures optional_features = {},
                             ValidationLayers const* validation_layers = nullptr );
         ~DeviceSet( ) override;
 
@@ -33,7 +43,10 @@ namespace cobalt
         [[nodiscard]] VkPhysicalDevice physical( ) const;
         [[nodiscard]] Queue& graphics_queue( ) const;
         [[nodiscard]] Queue& present_queue( ) const;
+        [[nodiscard]] memory::DeviceAllocator& allocator( ) const;
+        [[nodiscard]] StagingRing& staging_ring( ) const;
 
+        // Whether the feature is enabled on the logical device, required or optional.
         [[nodiscard]] bool has_feature( DeviceFeatureFlags feature ) const;
         [[nodiscard]] uint32_t device_index( ) const;
 
@@ -53,8 +66,10 @@ namespace cobalt
 
         std::unique_ptr<Queue> graphics_queue_ptr_{ nullptr };
         std::unique_ptr<Queue> present_queue_ptr_{ nullptr };
+        std::unique_ptr<memory::DeviceAllocator> allocator_ptr_{ nullptr };
+        std::unique_ptr<StagingRing> staging_ring_ptr_{ nullptr };
 
-        void pick_physical_device( );
+        void pick_physical_device( DeviceFeatureFlags optional_features );
         void create_logical_device( ValidationLayers const* validation_layers );
 
     };
@@ -17,7 +17,8 @@
 
 namespace cobalt
 {
-    using ContextWizard = InitWizard<struct ContextCreateInfo>::WithFeatures<DeviceFeatureFlags, ValidationLayers>;
+    using ContextWizard =
+            InitWizard<struct ContextCreateInfo>::WithFeatures<DeviceFeatureFlags, OptionalDeviceFeatures, ValidationLayers>;
 }
 
 namespace cobalt
@@ -48,7 +49,7 @@ namespace cobalt
         std::unique_ptr<InstanceBundle> instance_bundle_ptr_{};
         std::unique_ptr<DeviceSet> device_set_ptr_{};
 
-        void create_device( DeviceFeatureFlags features );
+        void create_device( DeviceFeatureFlags features, OptionalDeviceFeatures optional_features );
 
     };
 
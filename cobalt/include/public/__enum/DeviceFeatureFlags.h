@@ -17,6 +17,9 @@ namespace cobalt
         DYNAMIC_RENDERING_EXT                   = 1 << 3,
         SYNCHRONIZATION_2_EXT                   = 1 << 4,
         SHADER_IMAGE_ARRAY_NON_UNIFORM_INDEXING = 1 << 5,
+        TEXTURE_COMPRESSION_BC                  = 1 << 6,
+        MULTI_DRAW_INDIRECT                     = 1 << 7,
+        DRAW_INDIRECT_COUNT                     = 1 << 8,
     };
 
     template <>
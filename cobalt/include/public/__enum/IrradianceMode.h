@@ -0,0 +1,20 @@
+#ifndef IRRADIANCEMODE_H
+#define IRRADIANCEMODE_H
+
+#include <cstdint>
+
+
+namespace cobalt
+{
+    enum class IrradianceMode : uint8_t
+    {
+        // Brute-force hemisphere integration into a 512x512 RGBA32F cubemap, sampled per pixel.
+        CUBEMAP,
+        // 9 spherical harmonics coefficients projected on the CPU, evaluated per pixel from a uniform buffer.
+        SPHERICAL_HARMONICS,
+    };
+
+}
+
+
+#endif //!IRRADIANCEMODE_H
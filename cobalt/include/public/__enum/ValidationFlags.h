@@ -10,8 +10,10 @@ namespace cobalt
 {
     enum class ValidationFlags : uint32_t
     {
-        NONE               = 0,
-        KHRONOS_VALIDATION = 1 << 0
+        NONE                       = 0,
+        KHRONOS_VALIDATION         = 1 << 0,
+        // Hazards between commands and submissions, off by default in the Khronos layer. Loads the Khronos layer as well.
+        SYNCHRONIZATION_VALIDATION = 1 << 1
     };
 
     template <>
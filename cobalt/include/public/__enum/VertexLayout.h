@@ -0,0 +1,20 @@
+#ifndef VERTEXLAYOUT_H
+#define VERTEXLAYOUT_H
+
+#include <cstdint>
+
+
+namespace cobalt
+{
+    enum class VertexLayout : uint8_t
+    {
+        // Vertex: every attribute as full floats, 56 bytes.
+        FULL,
+        // PackedVertex: quantized uv, normal and tangent, 24 bytes.
+        PACKED,
+    };
+
+}
+
+
+#endif //!VERTEXLAYOUT_H
@@ -0,0 +1,37 @@
+#ifndef CUBEMAPCACHE_H
+#define CUBEMAPCACHE_H
+
+#include <__image/Image.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <filesystem>
+#include <optional>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+    class CommandPool;
+}
+
+namespace cobalt::image
+{
+    /**
+     * Uploads a cubemap written by store_cubemap. The key identifies the inputs the cubemap was rendered from (e.g. the source
+     * image and shader hashes), a missing file, another key or a malformed blob all result in nullopt, and the caller renders
+     * the cubemap as usual. The image is created with the given usage plus TRANSFER_DST and ends up in SHADER_READ_ONLY.
+     */
+    [[nodiscard]] std::optional<Image> load_cubemap( DeviceSet const&, CommandPool&, std::filesystem::path const& path,
+                                                     uint64_t key, VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT );
+
+    /**
+     * Reads every face of the cubemap back from the GPU and writes it to disk under the key. The cubemap must be in
+     * SHADER_READ_ONLY layout and created with TRANSFER_SRC usage, it is left in SHADER_READ_ONLY layout.
+     */
+    void store_cubemap( DeviceSet const&, CommandPool&, Image& cubemap, std::filesystem::path const& path, uint64_t key );
+
+}
+
+
+#endif //!CUBEMAPCACHE_H
@@ -5,6 +5,8 @@
 
 #include <__image/ImageLayoutTransition.h>
 #include <__image/ImageView.h>
+#include <__image/SubresourceLayouts.h>
+#include <__memory/DeviceAllocator.h>
 
 #include <vulkan/vulkan_core.h>
 
@@ -30,8 +32,10 @@ namespace cobalt
         VkMemoryPropertyFlags properties{ VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
         VkImageCreateFlags create_flags{ 0 };
         VkImageAspectFlags aspect_flags{ VK_IMAGE_ASPECT_NONE };
+        uint32_t mip_levels{ 1 };
         uint32_t layers{ 1 };
         VkImageViewType view_type{ VK_IMAGE_VIEW_TYPE_2D };
+        VkComponentMapping components{};
     };
 
 
@@ -53,9 +57,19 @@ namespace cobalt
         [[nodiscard]] uint32_t view_count( ) const;
         [[nodiscard]] VkFormat format( ) const;
         [[nodiscard]] VkExtent2D extent( ) const;
+        [[nodiscard]] uint32_t mip_levels( ) const;
+        [[nodiscard]] uint32_t layers( ) const;
+        [[nodiscard]] VkImageLayout layout( uint32_t mip_level = 0u ) const;
 
         void transition_layout( ImageLayoutTransition const&, CommandPool& cmd_pool );
-        void transition_layout( ImageLayoutTransition, CommandOperator const& cmd_operator );
+        void transition_layout( ImageLayoutTransition const&, CommandOperator const& cmd_operator, uint32_t base_mip_level = 0u,
+                                uint32_t mip_level_count = VK_REMAINING_MIP_LEVELS );
+
+        /**
+         * Fills mip levels 1..n by blitting each level from the one above it. Level 0 must hold the image contents in
+         * TRANSFER_DST layout, the whole chain ends up in SHADER_READ_ONLY layout.
+         */
+        void generate_mipmaps( CommandOperator const& cmd_operator );
 
     private:
         DeviceSet const& device_ref_;
@@ -63,11 +77,12 @@ namespace cobalt
         VkFormat const format_;
         VkExtent2D const extent_;
         uint32_t const layers_;
+        uint32_t const mip_levels_;
 
-        VkImageLayout layout_{ VK_IMAGE_LAYOUT_UNDEFINED };
+        SubresourceLayouts layouts_;
 
         VkImage image_{ VK_NULL_HANDLE };
-        VkDeviceMemory image_memory_{ VK_NULL_HANDLE };
+        memory::DeviceAllocation allocation_{};
 
         std::unique_ptr<ImageView> view_ptr_{};
 
@@ -76,6 +91,16 @@ namespace cobalt
 
     };
 
+
+    namespace image
+    {
+        // Number of levels in a full mip chain down to 1x1.
+        [[nodiscard]] uint32_t calculate_mip_levels( VkExtent2D extent );
+
+        // Extent of a mip level, halved per level and rounded down, never below 1x1.
+        [[nodiscard]] VkExtent2D calculate_mip_extent( VkExtent2D extent, uint32_t mip_level );
+    }
+
 }
 
 
@@ -22,6 +22,9 @@ namespace cobalt
         bool unnormalized_coordinates{ false };
         bool compare_enable{ false };
         VkCompareOp compare_op{ VK_COMPARE_OP_MAX_ENUM };
+        float mip_lod_bias{ 0.f };
+        float min_lod{ 0.f };
+        float max_lod{ VK_LOD_CLAMP_NONE };
 
     };
 
@@ -19,7 +19,9 @@ namespace cobalt
         VkFormat format{ VK_FORMAT_UNDEFINED };
         VkImageAspectFlags aspect_flags{ VK_IMAGE_ASPECT_NONE };
         uint32_t base_layer{ 0 };
+        uint32_t mip_levels{ 1 };
         VkImageViewType view_type{ VK_IMAGE_VIEW_TYPE_2D };
+        VkComponentMapping components{};
 
         ImageViewCreateInfo clone( uint32_t layer ) const;
 
@@ -0,0 +1,45 @@
+#ifndef SPHERICALHARMONICS_H
+#define SPHERICALHARMONICS_H
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <filesystem>
+#include <span>
+
+
+namespace cobalt::image
+{
+    static constexpr uint32_t SH9_COEFFICIENT_COUNT{ 9u };
+
+
+    /**
+     * Diffuse irradiance of an environment as 9 RGB spherical harmonics coefficients (bands 0 to 2). The cosine lobe
+     * convolution and the 1/PI of a lambertian surface are folded into the coefficients, so evaluating them gives the same
+     * quantity an irradiance cubemap stores. Padded to vec4 to match the std140 layout of a uniform array.
+     */
+    struct SH9Irradiance
+    {
+        std::array<glm::vec4, SH9_COEFFICIENT_COUNT> coefficients{};
+    };
+
+
+    /**
+     * Projects an equirectangular RGBA32F environment onto SH9. Rows are reduced on a worker pool, 0 threads picks the
+     * hardware concurrency. Directions follow sample_spherical_map in the shaders: u is the azimuth atan(z, x), v the
+     * elevation asin(y), both remapped to [0, 1].
+     */
+    [[nodiscard]] SH9Irradiance project_irradiance_sh9( std::span<float const> rgba, uint32_t width, uint32_t height,
+                                                        uint32_t thread_count = 0u );
+
+    // Decodes the HDR image and projects it, see above.
+    [[nodiscard]] SH9Irradiance project_irradiance_sh9( std::filesystem::path const& equirect_path,
+                                                        uint32_t thread_count = 0u );
+
+    // Reconstructs the irradiance in the (normalized) direction, the CPU twin of the shader evaluation.
+    [[nodiscard]] glm::vec3 evaluate_irradiance_sh9( SH9Irradiance const&, glm::vec3 const& direction );
+
+}
+
+
+#endif //!SPHERICALHARMONICS_H
@@ -0,0 +1,51 @@
+#ifndef SUBRESOURCELAYOUTS_H
+#define SUBRESOURCELAYOUTS_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace cobalt
+{
+    // Consecutive mip levels leaving the same layout, covered by one barrier.
+    struct LayoutRun
+    {
+        uint32_t base_mip_level{ 0u };
+        uint32_t level_count{ 0u };
+        VkImageLayout old_layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+    };
+
+
+    /**
+     * Last recorded layout of every mip level of an image. Levels can sit in different layouts (e.g. halfway through mip
+     * generation), so a transition is split into runs of levels sharing the same old layout.
+     */
+    class SubresourceLayouts final
+    {
+    public:
+        explicit SubresourceLayouts( uint32_t mip_levels );
+
+        [[nodiscard]] uint32_t mip_levels( ) const;
+        [[nodiscard]] VkImageLayout layout( uint32_t mip_level ) const;
+
+        /**
+         * Records the levels in their new layout.
+         * @return the runs that change layout, levels already in it are left out.
+         */
+        [[nodiscard]] std::vector<LayoutRun> transition( uint32_t base_mip_level, uint32_t mip_level_count,
+                                                         VkImageLayout to_layout );
+
+        // Every level goes back to UNDEFINED.
+        void reset( );
+
+    private:
+        std::vector<VkImageLayout> layouts_{};
+
+    };
+
+}
+
+
+#endif //!SUBRESOURCELAYOUTS_H
@@ -15,6 +15,9 @@ namespace cobalt
     class DeviceSet;
     class CommandPool;
     class Image;
+    class StbImageLoader;
+    class Ktx2ImageLoader;
+    class UploadContext;
 }
 
 namespace cobalt
@@ -23,12 +26,18 @@ namespace cobalt
     {
         std::filesystem::path const& path_to_img{};
         VkFormat image_format{ VK_FORMAT_UNDEFINED };
+        bool generate_mips{ true };
     };
 
     class TextureImage final : public memory::Resource
     {
     public:
         explicit TextureImage( DeviceSet const&, CommandPool&, TextureImageCreateInfo const& );
+        explicit TextureImage( UploadContext&, TextureImageCreateInfo const& );
+        explicit TextureImage( UploadContext&, StbImageLoader const& decoded_image, VkFormat image_format,
+                               bool generate_mips = true );
+        // Uploads the levels from base_level down, the image then starts at that level of the baked chain.
+        explicit TextureImage( UploadContext&, Ktx2ImageLoader const& baked_image, uint32_t base_level = 0u );
         ~TextureImage( ) noexcept override = default;
 
         TextureImage( TextureImage&& ) noexcept;
@@ -39,9 +48,16 @@ namespace cobalt
         [[nodiscard]] Image const& image( ) const;
         [[nodiscard]] VkSampler sampler( ) const;
 
+        // Exchanges the backing images, e.g. to replace a texture with a more detailed upload of itself.
+        void swap( TextureImage& other ) noexcept;
+
     private:
         std::unique_ptr<Image> texture_image_ptr_{ nullptr };
 
+        void load_image( UploadContext&, TextureImageCreateInfo const& );
+        void upload_image( UploadContext&, StbImageLoader const&, VkFormat image_format, bool generate_mips );
+        void upload_image( UploadContext&, Ktx2ImageLoader const&, uint32_t base_level );
+
     };
 
 }
@@ -0,0 +1,126 @@
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include <__memory/Resource.h>
+
+#include <__buffer/CommandPool.h>
+#include <__image/TextureImage.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+    class Ktx2ImageLoader;
+    class UploadContext;
+}
+
+namespace cobalt
+{
+    struct TextureStreamerCreateInfo
+    {
+        // Levels whose longest side is at most this many texels are uploaded up front, rendering can start on them.
+        uint32_t resident_tail_size{ 64u };
+
+        // Device memory the streamed textures may take up together. Past it, the textures covering the least screen area
+        // drop their finer levels first.
+        VkDeviceSize memory_budget{ 256ull * 1024ull * 1024ull };
+
+        // Replaced images are kept alive until no frame in flight can sample them anymore.
+        uint32_t frames_in_flight{ 2u };
+    };
+
+
+    /**
+     * Keeps the levels of baked textures resident on demand. Every texture starts out with its smallest levels only, a
+     * background thread then uploads finer ranges of levels as separate images, the texture with the largest screen area
+     * first. Finished uploads are swapped into the textures on the render thread, so their descriptor indices never change.
+     */
+    class TextureStreamer final : public memory::Resource
+    {
+    public:
+        explicit TextureStreamer( DeviceSet const&, TextureStreamerCreateInfo const& create_info = {} );
+        ~TextureStreamer( ) noexcept override;
+
+        TextureStreamer( const TextureStreamer& )                = delete;
+        TextureStreamer( TextureStreamer&& ) noexcept            = delete;
+        TextureStreamer& operator=( const TextureStreamer& )     = delete;
+        TextureStreamer& operator=( TextureStreamer&& ) noexcept = delete;
+
+        // Takes over a baked texture stored at texture_index, only its tail levels are recorded into the batch.
+        [[nodiscard]] TextureImage add( UploadContext&, uint32_t texture_index, std::unique_ptr<Ktx2ImageLoader> baked_image );
+
+        // Screen area in pixels each texture covers from the current view, indexed like the textures. Zero keeps the levels
+        // that are resident, but makes them the first to go when the budget runs out.
+        void request( std::span<float const> texture_areas );
+
+        /**
+         * Swaps the finished uploads into the textures. Call it on the render thread once the frame has been waited for.
+         * Returns true if the descriptors of that frame still reference replaced images and must be rewritten.
+         */
+        [[nodiscard]] bool update( std::span<TextureImage> textures, uint32_t frame_index );
+
+        [[nodiscard]] VkDeviceSize resident_size( ) const;
+
+    private:
+        struct StreamedTexture
+        {
+            uint32_t texture_index{ UINT32_MAX };
+            std::unique_ptr<Ktx2ImageLoader> image_ptr{ nullptr };
+
+            uint32_t tail_level{ 0u };
+            uint32_t resident_level{ 0u };
+            uint32_t wanted_level{ 0u };
+            float screen_area{ 0.f };
+        };
+
+        struct StreamedUpload
+        {
+            size_t streamed_index{ SIZE_MAX };
+            uint32_t base_level{ 0u };
+        };
+
+        struct RetiredTexture
+        {
+            uint64_t release_update{ 0u };
+            std::unique_ptr<TextureImage> texture_ptr{ nullptr };
+        };
+
+        DeviceSet const& device_ref_;
+        TextureStreamerCreateInfo const create_info_;
+
+        // Only ever used by the worker thread.
+        CommandPool cmd_pool_;
+
+        mutable std::mutex mutex_{};
+        std::condition_variable wake_condition_{};
+        std::vector<StreamedTexture> textures_{};
+        std::vector<std::pair<uint32_t, std::unique_ptr<TextureImage>>> completed_{};
+        bool stop_{ false };
+
+        // Render thread only.
+        std::vector<RetiredTexture> retired_{};
+        std::vector<bool> stale_frames_{};
+        uint64_t update_count_{ 0u };
+
+        std::thread worker_{};
+
+        void run_worker( );
+        [[nodiscard]] std::optional<StreamedUpload> plan_upload( ) const;
+        [[nodiscard]] static uint64_t chain_size( StreamedTexture const&, uint32_t base_level );
+
+    };
+
+}
+
+
+#endif //!TEXTURESTREAMER_H
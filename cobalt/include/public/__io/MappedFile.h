@@ -0,0 +1,55 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+
+namespace cobalt::io
+{
+    /**
+     * Read-only memory mapping of a whole file. The contents are paged in by the OS on first access instead of being copied
+     * through a stream. A file that cannot be opened results in a closed mapping rather than an error, callers decide whether
+     * that is fatal.
+     */
+    class MappedFile final
+    {
+    public:
+        explicit MappedFile( std::filesystem::path const& path );
+        ~MappedFile( ) noexcept;
+
+        MappedFile( MappedFile&& ) noexcept;
+        MappedFile( const MappedFile& )                = delete;
+        MappedFile& operator=( const MappedFile& )     = delete;
+        MappedFile& operator=( MappedFile&& ) noexcept = delete;
+
+        [[nodiscard]] bool is_open( ) const noexcept;
+
+        [[nodiscard]] std::byte const* data( ) const noexcept;
+        [[nodiscard]] size_t size( ) const noexcept;
+        [[nodiscard]] std::span<std::byte const> bytes( ) const noexcept;
+
+    private:
+        std::byte const* data_ptr_{ nullptr };
+        size_t size_{ 0u };
+        bool open_{ false };
+
+#ifdef _WIN32
+        void* file_handle_{ nullptr };
+        void* mapping_handle_{ nullptr };
+#endif
+
+        void unmap( ) noexcept;
+
+    };
+
+
+    // FNV-1a of the whole file contents, the hash of an empty input for a file that cannot be opened.
+    [[nodiscard]] uint64_t hash_file( std::filesystem::path const& path );
+
+}
+
+
+#endif //!MAPPEDFILE_H
@@ -0,0 +1,53 @@
+#ifndef IO_HASH_H
+#define IO_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+namespace cobalt::io
+{
+    // FNV-1a, used to key on-disk caches on file contents. Not meant to be collision resistant against crafted input.
+    static constexpr uint64_t FNV_OFFSET_BASIS{ 14695981039346656037ull };
+    static constexpr uint64_t FNV_PRIME{ 1099511628211ull };
+
+
+    [[nodiscard]] constexpr uint64_t hash_bytes( std::span<std::byte const> const bytes, uint64_t seed = FNV_OFFSET_BASIS ) noexcept
+    {
+        for ( std::byte const byte : bytes )
+        {
+            seed ^= static_cast<uint64_t>( byte );
+            seed *= FNV_PRIME;
+        }
+        return seed;
+    }
+
+
+    [[nodiscard]] constexpr uint64_t hash_string( std::string_view const str, uint64_t seed = FNV_OFFSET_BASIS ) noexcept
+    {
+        for ( char const c : str )
+        {
+            seed ^= static_cast<uint64_t>( static_cast<unsigned char>( c ) );
+            seed *= FNV_PRIME;
+        }
+        return seed;
+    }
+
+
+    [[nodiscard]] constexpr uint64_t hash_combine( uint64_t const seed, uint64_t const value ) noexcept
+    {
+        uint64_t hash = seed;
+        for ( uint32_t shift{}; shift < 64u; shift += 8u )
+        {
+            hash ^= ( value >> shift ) & 0xffu;
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+}
+
+
+#endif //!IO_HASH_H
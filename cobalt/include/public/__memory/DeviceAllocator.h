@@ -0,0 +1,131 @@
+#ifndef DEVICEALLOCATOR_H
+#define DEVICEALLOCATOR_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace cobalt::memory
+{
+    class DeviceMemoryBlock;
+}
+
+namespace cobalt::memory
+{
+    enum class AllocationLifetime : uint8_t
+    {
+        // Lives for a level or the whole application, e.g. vertex buffers, textures and attachments.
+        PERSISTENT,
+        // Released shortly after it was created, e.g. staging and readback buffers.
+        TRANSIENT,
+    };
+
+
+    struct AllocationRequest
+    {
+        VkMemoryRequirements requirements{};
+        VkMemoryPropertyFlags properties{ VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
+
+        // Buffers and linearly tiled images are linear, optimally tiled images are not. The two never share a block, which
+        // keeps them bufferImageGranularity apart without padding every allocation.
+        bool linear_resource{ true };
+        AllocationLifetime lifetime{ AllocationLifetime::PERSISTENT };
+    };
+
+
+    struct DeviceAllocation
+    {
+        static constexpr uint32_t DEDICATED_POOL{ UINT32_MAX };
+
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        VkDeviceSize offset{ 0u };
+        VkDeviceSize size{ 0u };
+
+        uint32_t pool_index{ DEDICATED_POOL };
+        uint32_t block_index{ 0u };
+
+        [[nodiscard]] bool dedicated( ) const { return pool_index == DEDICATED_POOL; }
+        [[nodiscard]] bool valid( ) const { return memory != VK_NULL_HANDLE; }
+    };
+
+
+    struct DeviceAllocatorStats
+    {
+        uint32_t block_count{ 0u };
+        uint32_t dedicated_count{ 0u };
+        uint32_t allocation_count{ 0u };
+
+        // Memory taken from the driver, and the part of it handed out (rounded up to the allocator granularity).
+        VkDeviceSize reserved_bytes{ 0u };
+        VkDeviceSize used_bytes{ 0u };
+    };
+
+
+    struct DeviceAllocatorCreateInfo
+    {
+        // Powers of two, clamped to an eighth of the heap they are taken from.
+        VkDeviceSize block_size{ 64ull << 20u };
+        VkDeviceSize transient_block_size{ 16ull << 20u };
+
+        // Granularity of the persistent blocks, smaller requests are rounded up to it.
+        VkDeviceSize min_allocation_size{ 256u };
+    };
+
+
+    /**
+     * Sub-allocates buffers and images out of large VkDeviceMemory blocks, keeping the allocation count far below
+     * maxMemoryAllocationCount and the driver out of the hot path. Blocks are pooled per memory type, resource kind and
+     * lifetime: persistent pools use a buddy allocator, transient pools a linear one that resets once drained. Requests larger
+     * than half a block get dedicated memory. Host visible blocks are mapped once and stay mapped. Thread safe, resources
+     * are created from the loader threads too.
+     */
+    class DeviceAllocator final
+    {
+    public:
+        // Linear and optimal resources, each persistent and transient.
+        static constexpr uint32_t POOLS_PER_MEMORY_TYPE{ 4u };
+
+        explicit DeviceAllocator( VkDevice device, VkPhysicalDevice physical_device, DeviceAllocatorCreateInfo const& = {} );
+        ~DeviceAllocator( ) noexcept;
+
+        DeviceAllocator( const DeviceAllocator& )                = delete;
+        DeviceAllocator( DeviceAllocator&& ) noexcept            = delete;
+        DeviceAllocator& operator=( const DeviceAllocator& )     = delete;
+        DeviceAllocator& operator=( DeviceAllocator&& ) noexcept = delete;
+
+        [[nodiscard]] DeviceAllocation allocate( AllocationRequest const& );
+        void free( DeviceAllocation const& );
+
+        // Host pointer to the start of the allocation, the memory must be host visible.
+        [[nodiscard]] void* map( DeviceAllocation const& );
+
+        [[nodiscard]] DeviceAllocatorStats stats( ) const;
+
+    private:
+        VkDevice const device_;
+        VkPhysicalDeviceMemoryProperties memory_properties_{};
+        DeviceAllocatorCreateInfo const create_info_;
+
+        mutable std::mutex mutex_{};
+
+        // Indexed by memory type * POOLS_PER_MEMORY_TYPE + linear * 2 + transient. Freed blocks leave a null slot behind so
+        // the block index of live allocations stays valid.
+        std::array<std::vector<std::unique_ptr<DeviceMemoryBlock>>, VK_MAX_MEMORY_TYPES * POOLS_PER_MEMORY_TYPE> pools_{};
+        std::unordered_map<VkDeviceMemory, void*> dedicated_allocations_{};
+        VkDeviceSize dedicated_bytes_{ 0u };
+        uint32_t allocation_count_{ 0u };
+
+        [[nodiscard]] VkDeviceMemory allocate_memory( VkDeviceSize size, uint32_t memory_type ) const;
+        [[nodiscard]] DeviceAllocation allocate_dedicated( VkDeviceSize size, uint32_t memory_type );
+
+    };
+
+}
+
+
+#endif //!DEVICEALLOCATOR_H
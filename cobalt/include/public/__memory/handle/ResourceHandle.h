@@ -1,23 +1,40 @@
 #ifndef RESOURCEHANDLE_H
 #define RESOURCEHANDLE_H
 
-#include "HandleTable.h"
+#include "ResourcePool.h"
 
 #include <cassert>
+#include <utility>
 
 
 namespace cobalt
 {
-    // todo: handle resource destruction in ResourceHandle for table.
-    template <typename resource_t, typename table_resource_t = resource_t>
+    /**
+     * Counted reference to a resource in its pool. Every handle owns the resource: copies add an owner, and the resource is
+     * retired once the last owner is reset or goes out of scope. release( ) retires it regardless of the other owners, which
+     * go stale. Retired resources are destroyed once the frames in flight are done with them.
+     */
+    template <typename resource_t>
     class ResourceHandle final
     {
     public:
-        explicit ResourceHandle( HandleTable<table_resource_t>&, memory::RedirectionInfo );
+        explicit ResourceHandle( memory::ResourcePoolBase&, memory::RedirectionInfo );
         ResourceHandle( ) = default;
+        ~ResourceHandle( ) noexcept;
+
+        ResourceHandle( ResourceHandle const& );
+        ResourceHandle( ResourceHandle&& ) noexcept;
+        ResourceHandle& operator=( ResourceHandle const& );
+        ResourceHandle& operator=( ResourceHandle&& ) noexcept;
 
         [[nodiscard]] bool valid( ) const;
 
+        // Gives up this handle's ownership.
+        void reset( );
+
+        // Retires the resource regardless of its other owners.
+        void release( );
+
         resource_t* get( );
         resource_t const* get( ) const;
 
@@ -28,65 +45,145 @@ namespace cobalt
         resource_t const& operator*( ) const;
 
     private:
-        HandleTable<table_resource_t>* table_ptr_{ nullptr };
+        memory::ResourcePoolBase* pool_ptr_{ nullptr };
         memory::RedirectionInfo handle_info_{ NULL_HANDLE_INDEX };
 
     };
 
 
-    template <typename resource_t, typename table_resource_t>
-    ResourceHandle<resource_t, table_resource_t>::ResourceHandle( HandleTable<table_resource_t>& table,
-                                                                  memory::RedirectionInfo const handle_info )
-        : table_ptr_{ &table }
-        , handle_info_{ handle_info } { }
+    template <typename resource_t>
+    ResourceHandle<resource_t>::ResourceHandle( memory::ResourcePoolBase& pool, memory::RedirectionInfo const handle_info )
+        : pool_ptr_{ &pool }
+        , handle_info_{ handle_info }
+    {
+        pool_ptr_->retain( handle_info_ );
+    }
+
+
+    template <typename resource_t>
+    ResourceHandle<resource_t>::~ResourceHandle( ) noexcept
+    {
+        reset( );
+    }
+
+
+    template <typename resource_t>
+    ResourceHandle<resource_t>::ResourceHandle( ResourceHandle const& other )
+        : pool_ptr_{ other.pool_ptr_ }
+        , handle_info_{ other.handle_info_ }
+    {
+        if ( pool_ptr_ != nullptr )
+        {
+            pool_ptr_->retain( handle_info_ );
+        }
+    }
+
+
+    template <typename resource_t>
+    ResourceHandle<resource_t>::ResourceHandle( ResourceHandle&& other ) noexcept
+        : pool_ptr_{ std::exchange( other.pool_ptr_, nullptr ) }
+        , handle_info_{ std::exchange( other.handle_info_, memory::RedirectionInfo{ NULL_HANDLE_INDEX } ) } { }
+
+
+    template <typename resource_t>
+    ResourceHandle<resource_t>& ResourceHandle<resource_t>::operator=( ResourceHandle const& other )
+    {
+        // Retain before releasing, assigning a handle to itself must not destroy the resource. Copied up front, as resetting
+        // clears other when it is this handle.
+        auto* const pool_ptr   = other.pool_ptr_;
+        auto const handle_info = other.handle_info_;
+        if ( pool_ptr != nullptr )
+        {
+            pool_ptr->retain( handle_info );
+        }
+        reset( );
+        pool_ptr_    = pool_ptr;
+        handle_info_ = handle_info;
+        return *this;
+    }
+
+
+    template <typename resource_t>
+    ResourceHandle<resource_t>& ResourceHandle<resource_t>::operator=( ResourceHandle&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset( );
+            pool_ptr_    = std::exchange( other.pool_ptr_, nullptr );
+            handle_info_ = std::exchange( other.handle_info_, memory::RedirectionInfo{ NULL_HANDLE_INDEX } );
+        }
+        return *this;
+    }
+
+
+    template <typename resource_t>
+    bool ResourceHandle<resource_t>::valid( ) const
+    {
+        return pool_ptr_ != nullptr && pool_ptr_->alive( handle_info_ );
+    }
+
+
+    template <typename resource_t>
+    void ResourceHandle<resource_t>::reset( )
+    {
+        if ( pool_ptr_ != nullptr )
+        {
+            std::exchange( pool_ptr_, nullptr )->release( handle_info_ );
+            handle_info_ = memory::RedirectionInfo{ NULL_HANDLE_INDEX };
+        }
+    }
 
 
-    template <typename resource_t, typename table_resource_t>
-    bool ResourceHandle<resource_t, table_resource_t>::valid( ) const
+    template <typename resource_t>
+    void ResourceHandle<resource_t>::release( )
     {
-        return table_ptr_ != nullptr && handle_info_.index != NULL_HANDLE_INDEX;
+        if ( pool_ptr_ != nullptr )
+        {
+            std::exchange( pool_ptr_, nullptr )->retire( handle_info_ );
+            handle_info_ = memory::RedirectionInfo{ NULL_HANDLE_INDEX };
+        }
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t* ResourceHandle<resource_t, table_resource_t>::get( )
+    template <typename resource_t>
+    resource_t* ResourceHandle<resource_t>::get( )
     {
-        assert( table_ptr_ != nullptr && "ResourceHandle::get: table_ptr_ is null!" );
-        return static_cast<resource_t*>( &table_ptr_->at( handle_info_ ) );
+        assert( pool_ptr_ != nullptr && "ResourceHandle::get: pool_ptr_ is null!" );
+        return &static_cast<memory::ResourcePool<resource_t>*>( pool_ptr_ )->at( handle_info_ );
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t const* ResourceHandle<resource_t, table_resource_t>::get( ) const
+    template <typename resource_t>
+    resource_t const* ResourceHandle<resource_t>::get( ) const
     {
-        assert( table_ptr_ != nullptr && "ResourceHandle::get: table_ptr_ is null!" );
-        return static_cast<resource_t*>( &table_ptr_->at( handle_info_ ) );
+        assert( pool_ptr_ != nullptr && "ResourceHandle::get: pool_ptr_ is null!" );
+        return &static_cast<memory::ResourcePool<resource_t> const*>( pool_ptr_ )->at( handle_info_ );
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t* ResourceHandle<resource_t, table_resource_t>::operator->( )
+    template <typename resource_t>
+    resource_t* ResourceHandle<resource_t>::operator->( )
     {
         return get( );
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t const* ResourceHandle<resource_t, table_resource_t>::operator->( ) const
+    template <typename resource_t>
+    resource_t const* ResourceHandle<resource_t>::operator->( ) const
     {
         return get( );
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t& ResourceHandle<resource_t, table_resource_t>::operator*( )
+    template <typename resource_t>
+    resource_t& ResourceHandle<resource_t>::operator*( )
     {
         return *get( );
     }
 
 
-    template <typename resource_t, typename table_resource_t>
-    resource_t const& ResourceHandle<resource_t, table_resource_t>::operator*( ) const
+    template <typename resource_t>
+    resource_t const& ResourceHandle<resource_t>::operator*( ) const
     {
         return *get( );
     }
@@ -0,0 +1,384 @@
+#ifndef RESOURCEPOOL_H
+#define RESOURCEPOOL_H
+
+#include <__cleanup/DeletionQueue.h>
+#include <__memory/memory_aliases.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+
+namespace cobalt
+{
+    namespace memory
+    {
+#ifdef COBALT_ENABLE_HANDLE_VALIDATION
+        constexpr bool ENABLE_HANDLE_VALIDATION{ true };
+#else
+        constexpr bool ENABLE_HANDLE_VALIDATION{ false };
+#endif
+
+        struct RedirectionInfo final
+        {
+            handle_index_t index{ NULL_HANDLE_INDEX };
+            handle_index_t generation{ 0 };
+        };
+    }
+
+
+    namespace handle_log
+    {
+        void logerr_on_invalid_table_index( std::string_view const& src, memory::handle_index_t index, size_t table_size );
+        void logerr_on_invalid_resource_index( std::string_view const& src, memory::handle_index_t index );
+        void logerr_on_generation_mismatch( std::string_view const& src, memory::handle_index_t gen1,
+                                            memory::handle_index_t gen2 );
+    }
+
+
+    namespace memory
+    {
+        class ResourcePoolBase;
+
+        struct LiveResource final
+        {
+            uint64_t sequence{ 0u };
+            ResourcePoolBase* pool_ptr{ nullptr };
+            RedirectionInfo info{};
+        };
+
+
+        /**
+         * Type erased side of a pool. Owner counting goes through here, so handles can be copied and destroyed where their
+         * resource type is incomplete. Released resources are retired: handles to them go stale right away, but they are
+         * only destroyed once the frames that may still use them have completed on the deletion queue.
+         */
+        class ResourcePoolBase
+        {
+        public:
+            virtual ~ResourcePoolBase( ) = default;
+
+            ResourcePoolBase( ResourcePoolBase const& )                = delete;
+            ResourcePoolBase( ResourcePoolBase&& ) noexcept            = delete;
+            ResourcePoolBase& operator=( ResourcePoolBase const& )     = delete;
+            ResourcePoolBase& operator=( ResourcePoolBase&& ) noexcept = delete;
+
+            [[nodiscard]] virtual bool alive( RedirectionInfo const& ) const = 0;
+            [[nodiscard]] virtual size_t size( ) const = 0;
+
+            // Stale handles are ignored, the resource may have been retired explicitly while other owners remained.
+            virtual void retain( RedirectionInfo const& ) = 0;
+            virtual void release( RedirectionInfo const& ) = 0;
+            virtual void retire( RedirectionInfo const& ) = 0;
+
+            // Destroys a live or retired resource right away, the caller guarantees the GPU is done with it.
+            virtual void destroy( RedirectionInfo const& ) = 0;
+
+            // Appends every live and retired resource, for the owner to destroy them in reverse creation order.
+            virtual void collect_live( std::vector<LiveResource>& ) = 0;
+
+        protected:
+            // Without a deletion queue, retired resources are destroyed immediately.
+            explicit ResourcePoolBase( cleanup::DeletionQueue* deletion_queue_ptr )
+                : deletion_queue_ptr_{ deletion_queue_ptr } { }
+
+            cleanup::DeletionQueue* const deletion_queue_ptr_;
+
+            static void destroy_retired( void* pool_ptr, uint64_t const payload )
+            {
+                static_cast<ResourcePoolBase*>( pool_ptr )->destroy( RedirectionInfo{
+                    .index = static_cast<handle_index_t>( payload ),
+                    .generation = static_cast<handle_index_t>( payload >> 32u )
+                } );
+            }
+
+        };
+
+
+        /**
+         * Generational slot map of one resource type. Resources are constructed in place in fixed size chunks, so they never
+         * move and a dereference is an index into contiguous storage. Retiring and destruction are O(1): retiring bumps the
+         * slot's generation, which invalidates every handle still pointing at it, and destruction hands the slot to the next
+         * resource.
+         */
+        template <typename resource_t>
+        class ResourcePool final : public ResourcePoolBase
+        {
+            static constexpr handle_index_t CHUNK_SIZE{ 64u };
+
+            enum class SlotState : uint8_t
+            {
+                FREE,
+                LIVE,
+                RETIRED
+            };
+
+            struct Slot
+            {
+                alignas( resource_t ) std::byte storage[sizeof( resource_t )];
+                uint64_t sequence{ 0u };
+                handle_index_t generation{ 0 };
+                uint32_t owner_count{ 0 };
+                SlotState state{ SlotState::FREE };
+            };
+
+        public:
+            explicit ResourcePool( cleanup::DeletionQueue* deletion_queue_ptr = nullptr );
+            ~ResourcePool( ) noexcept override;
+
+            ResourcePool( const ResourcePool& )                = delete;
+            ResourcePool( ResourcePool&& ) noexcept            = delete;
+            ResourcePool& operator=( const ResourcePool& )     = delete;
+            ResourcePool& operator=( ResourcePool&& ) noexcept = delete;
+
+            /**
+             * O(1) construction of a resource in a free slot, with no owners yet.
+             * @param sequence creation order, used to tear the pools down newest first.
+             */
+            template <typename... args_t>
+            [[nodiscard]] RedirectionInfo emplace( uint64_t sequence, args_t&&... args );
+
+            /**
+             * O(1) retrieval of a resource. Stale indices and generations are only reported, and thrown on, when
+             * COBALT_ENABLE_HANDLE_VALIDATION is defined, otherwise this is a plain indexed load.
+             */
+            [[nodiscard]] resource_t& at( RedirectionInfo const& ) const;
+
+            [[nodiscard]] bool alive( RedirectionInfo const& ) const override;
+            [[nodiscard]] size_t size( ) const override;
+
+            void retain( RedirectionInfo const& ) override;
+            void release( RedirectionInfo const& ) override;
+            void retire( RedirectionInfo const& ) override;
+            void destroy( RedirectionInfo const& ) override;
+
+            void collect_live( std::vector<LiveResource>& ) override;
+
+        private:
+            std::vector<std::unique_ptr<Slot[]>> chunks_{};
+            std::vector<handle_index_t> free_slots_{};
+            handle_index_t slot_count_{ 0u };
+            size_t live_count_{ 0u };
+
+            [[nodiscard]] Slot& slot_at( handle_index_t index ) const;
+            [[nodiscard]] static resource_t* resource_in( Slot& );
+            void destroy_slot( handle_index_t index );
+
+        };
+
+
+        template <typename resource_t>
+        ResourcePool<resource_t>::ResourcePool( cleanup::DeletionQueue* const deletion_queue_ptr )
+            : ResourcePoolBase{ deletion_queue_ptr } { }
+
+
+        template <typename resource_t>
+        ResourcePool<resource_t>::~ResourcePool( ) noexcept
+        {
+            for ( handle_index_t index{}; index < slot_count_; ++index )
+            {
+                if ( slot_at( index ).state != SlotState::FREE )
+                {
+                    destroy_slot( index );
+                }
+            }
+        }
+
+
+        template <typename resource_t>
+        template <typename... args_t>
+        RedirectionInfo ResourcePool<resource_t>::emplace( uint64_t const sequence, args_t&&... args )
+        {
+            // 1. Reuse a freed slot, otherwise append one, growing by a chunk when the last one is full.
+            handle_index_t index{ NULL_HANDLE_INDEX };
+            if ( not free_slots_.empty( ) )
+            {
+                index = free_slots_.back( );
+                free_slots_.pop_back( );
+            }
+            else
+            {
+                if ( slot_count_ % CHUNK_SIZE == 0u )
+                {
+                    chunks_.push_back( std::make_unique<Slot[]>( CHUNK_SIZE ) );
+                }
+                index = slot_count_++;
+            }
+
+            // 2. Construct in place, giving the slot back if the resource throws.
+            Slot& slot = slot_at( index );
+            try
+            {
+                std::construct_at( reinterpret_cast<resource_t*>( slot.storage ), std::forward<args_t>( args )... );
+            }
+            catch ( ... )
+            {
+                free_slots_.push_back( index );
+                throw;
+            }
+
+            slot.sequence    = sequence;
+            slot.owner_count = 0u;
+            slot.state       = SlotState::LIVE;
+            ++live_count_;
+
+            return RedirectionInfo{ .index = index, .generation = slot.generation };
+        }
+
+
+        template <typename resource_t>
+        resource_t& ResourcePool<resource_t>::at( RedirectionInfo const& info ) const
+        {
+            if constexpr ( ENABLE_HANDLE_VALIDATION )
+            {
+                // Compared inline, the logging call is only paid for when the handle is actually stale. Either way the slot
+                // holds no resource of the handle, so it is never dereferenced.
+                if ( info.index >= slot_count_ ) [[unlikely]]
+                {
+                    handle_log::logerr_on_invalid_table_index( "at", info.index, slot_count_ );
+                    throw std::out_of_range( "ResourcePool::at: handle index out of range!" );
+                }
+                if ( slot_at( info.index ).generation != info.generation ) [[unlikely]]
+                {
+                    handle_log::logerr_on_generation_mismatch( "at", slot_at( info.index ).generation, info.generation );
+                    throw std::runtime_error( "ResourcePool::at: stale handle!" );
+                }
+            }
+            return *resource_in( slot_at( info.index ) );
+        }
+
+
+        template <typename resource_t>
+        bool ResourcePool<resource_t>::alive( RedirectionInfo const& info ) const
+        {
+            if ( info.index >= slot_count_ )
+            {
+                return false;
+            }
+            Slot const& slot = slot_at( info.index );
+            return slot.state == SlotState::LIVE && slot.generation == info.generation;
+        }
+
+
+        template <typename resource_t>
+        size_t ResourcePool<resource_t>::size( ) const
+        {
+            return live_count_;
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::retain( RedirectionInfo const& info )
+        {
+            if ( alive( info ) )
+            {
+                ++slot_at( info.index ).owner_count;
+            }
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::release( RedirectionInfo const& info )
+        {
+            if ( alive( info ) && --slot_at( info.index ).owner_count == 0u )
+            {
+                retire( info );
+            }
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::retire( RedirectionInfo const& info )
+        {
+            if ( not alive( info ) )
+            {
+                return;
+            }
+            if ( deletion_queue_ptr_ == nullptr )
+            {
+                destroy_slot( info.index );
+                return;
+            }
+
+            // Stale from here on, the deleter finds the slot by its new generation.
+            Slot& slot = slot_at( info.index );
+            slot.state = SlotState::RETIRED;
+            ++slot.generation;
+            deletion_queue_ptr_->push( cleanup::Deleter{
+                .fn = &ResourcePoolBase::destroy_retired,
+                .context = this,
+                .payload = static_cast<uint64_t>( slot.generation ) << 32u | info.index
+            } );
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::destroy( RedirectionInfo const& info )
+        {
+            if ( info.index < slot_count_ && slot_at( info.index ).state != SlotState::FREE &&
+                 slot_at( info.index ).generation == info.generation )
+            {
+                destroy_slot( info.index );
+            }
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::collect_live( std::vector<LiveResource>& live )
+        {
+            for ( handle_index_t index{}; index < slot_count_; ++index )
+            {
+                if ( Slot const& slot = slot_at( index ); slot.state != SlotState::FREE )
+                {
+                    live.push_back( LiveResource{
+                        .sequence = slot.sequence,
+                        .pool_ptr = this,
+                        .info = { .index = index, .generation = slot.generation }
+                    } );
+                }
+            }
+        }
+
+
+        template <typename resource_t>
+        typename ResourcePool<resource_t>::Slot& ResourcePool<resource_t>::slot_at( handle_index_t const index ) const
+        {
+            return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+        }
+
+
+        template <typename resource_t>
+        resource_t* ResourcePool<resource_t>::resource_in( Slot& slot )
+        {
+            return std::launder( reinterpret_cast<resource_t*>( slot.storage ) );
+        }
+
+
+        template <typename resource_t>
+        void ResourcePool<resource_t>::destroy_slot( handle_index_t const index )
+        {
+            // 1. Invalidate first, handles released by the resource's own destructor must not reach this slot again. Retired
+            // slots were invalidated when they were retired.
+            Slot& slot = slot_at( index );
+            if ( slot.state == SlotState::LIVE )
+            {
+                ++slot.generation;
+            }
+            slot.state       = SlotState::FREE;
+            slot.owner_count = 0u;
+            --live_count_;
+
+            // 2. Destroy in place and hand the slot out again.
+            std::destroy_at( resource_in( slot ) );
+            free_slots_.push_back( index );
+        }
+
+    }
+
+}
+
+
+#endif //!RESOURCEPOOL_H
@@ -13,10 +13,14 @@ namespace cobalt::loader
     class AssimpModelLoader final : public ModelLoader<Vertex, uint32_t>
     {
     public:
-        explicit AssimpModelLoader( std::filesystem::path );
+        // With dedupe_texture_content, byte-identical texture files referenced under different paths share one entry.
+        explicit AssimpModelLoader( std::filesystem::path, bool dedupe_texture_content = true );
         void load( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
                    std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures ) const override;
 
+    private:
+        bool const dedupe_texture_content_{ true };
+
     };
 
 }
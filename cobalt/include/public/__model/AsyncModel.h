@@ -0,0 +1,76 @@
+#ifndef ASYNCMODEL_H
+#define ASYNCMODEL_H
+
+#include <__memory/Resource.h>
+
+#include <__event/multicast_delegate/Dispatcher.h>
+#include <__event/multicast_delegate/MulticastDelegate.h>
+#include <__model/Model.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+}
+
+namespace cobalt
+{
+    enum class ModelLoadState
+    {
+        LOADING,
+        READY,
+        FAILED,
+    };
+
+
+    /**
+     * Creates a Model on a loader thread of its own, so the render thread keeps servicing the window during the import and
+     * several models can load side by side. The model is only handed over to the render thread in poll, which also
+     * broadcasts on_loaded there. Until then, draws should be skipped and materials bound to the fallback texture.
+     */
+    class AsyncModel final : public memory::Resource
+    {
+        Dispatcher<Model&> loaded_dispatcher_{};
+
+    public:
+        using loader_t = loader::ModelLoader<Vertex, Model::index_t>;
+
+        MulticastDelegate<Model&> on_loaded{ loaded_dispatcher_ };
+
+        explicit AsyncModel( DeviceSet const&, std::unique_ptr<loader_t> loader, ModelCreateInfo const& create_info = {} );
+        ~AsyncModel( ) noexcept override;
+
+        AsyncModel( const AsyncModel& )                = delete;
+        AsyncModel( AsyncModel&& ) noexcept            = delete;
+        AsyncModel& operator=( const AsyncModel& )     = delete;
+        AsyncModel& operator=( AsyncModel&& ) noexcept = delete;
+
+        // Publishes the model once the loader thread is done with it. Call it on the render thread, between frames.
+        ModelLoadState poll( );
+
+        [[nodiscard]] ModelLoadState state( ) const;
+        [[nodiscard]] bool is_ready( ) const;
+
+        [[nodiscard]] Model& model( );
+        [[nodiscard]] Model const& model( ) const;
+
+    private:
+        std::unique_ptr<Model> model_ptr_{ nullptr };
+        ModelLoadState state_{ ModelLoadState::LOADING };
+
+        // Written by the loader thread once it no longer touches the model.
+        std::atomic<ModelLoadState> loader_state_{ ModelLoadState::LOADING };
+        std::thread loader_thread_{};
+
+        void load( DeviceSet const&, std::unique_ptr<loader_t> loader, ModelCreateInfo create_info );
+
+    };
+
+}
+
+
+#endif //!ASYNCMODEL_H
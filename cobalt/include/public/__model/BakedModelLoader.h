@@ -0,0 +1,46 @@
+#ifndef BAKEDMODELLOADER_H
+#define BAKEDMODELLOADER_H
+
+#include <__model/ModelLoader.h>
+
+#include <__model/Vertex.h>
+
+#include <cstdint>
+#include <span>
+
+
+namespace cobalt::loader
+{
+    /**
+     * Loads the final vertex, index, mesh, surface and texture tables from a binary cache stored next to the source model. On a
+     * miss the source is imported through the AssimpModelLoader and the cache is written, so only the first launch pays for the
+     * import. The cache is stamped with the source write time and size, a mismatching stamp falls back to a content hash.
+     */
+    class BakedModelLoader final : public ModelLoader<Vertex, uint32_t>
+    {
+    public:
+        // Bump whenever the import pipeline changes the data it produces, older caches are rebuilt on the next load.
+        static constexpr uint32_t BAKED_MODEL_VERSION{ 5u };
+        static constexpr std::string_view BAKED_MODEL_EXTENSION{ ".baked" };
+
+        explicit BakedModelLoader( std::filesystem::path source_path );
+        void load( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
+                   std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures ) const override;
+
+        [[nodiscard]] std::filesystem::path const& cache_path( ) const;
+
+    private:
+        std::filesystem::path cache_path_{};
+
+        [[nodiscard]] bool read_cache( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
+                                       std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures,
+                                       bool& stamp_outdated ) const;
+        void write_cache( std::span<Vertex const> vertices, std::span<uint32_t const> indices, std::span<Mesh const> meshes,
+                          std::span<SurfaceMap const> surface_maps, std::span<TextureGroup const> textures ) const;
+
+    };
+
+}
+
+
+#endif //!BAKEDMODELLOADER_H
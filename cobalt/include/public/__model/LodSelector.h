@@ -0,0 +1,46 @@
+#ifndef LODSELECTOR_H
+#define LODSELECTOR_H
+
+#include <__model/Mesh.h>
+
+#include <glm/glm.hpp>
+
+
+namespace cobalt
+{
+    /**
+     * Picks the level of detail of a mesh for one view. The error of every level is projected to pixels at the nearest point
+     * of the mesh bounding sphere and the coarsest level staying under the pixel threshold wins. Orthographic projections
+     * ignore the distance. The bias skips finer levels, e.g. for shadow maps where the detail is not visible.
+     */
+    class LodSelector final
+    {
+    public:
+        explicit LodSelector( glm::mat4 const& view, glm::mat4 const& projection, float viewport_height,
+                              float pixel_threshold = 1.f, uint32_t lod_bias = 0u ) noexcept;
+
+        [[nodiscard]] uint32_t select( Mesh const& ) const noexcept;
+        [[nodiscard]] MeshLod const& select_lod( Mesh const& ) const noexcept;
+
+        // Selection parameters, for selecting the levels on the GPU.
+        [[nodiscard]] glm::vec3 const& eye( ) const noexcept;
+        [[nodiscard]] bool orthographic( ) const noexcept;
+        [[nodiscard]] float pixels_per_unit( ) const noexcept;
+        [[nodiscard]] float pixel_threshold( ) const noexcept;
+        [[nodiscard]] uint32_t lod_bias( ) const noexcept;
+
+    private:
+        glm::vec3 eye_{ 0.f };
+        bool orthographic_{ false };
+
+        // Pixels covered by one world unit at distance one, or at any distance for an orthographic projection.
+        float pixels_per_unit_{ 0.f };
+        float pixel_threshold_{ 1.f };
+        uint32_t lod_bias_{ 0u };
+
+    };
+
+}
+
+
+#endif //!LODSELECTOR_H
@@ -1,17 +1,45 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include <glm/glm.hpp>
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
 #include <cstdint>
 
 
 namespace cobalt
 {
-    struct Mesh
+    struct MeshLod
     {
-        uint32_t index_count{ UINT32_MAX };
+        uint32_t index_count{ 0u };
         uint32_t index_offset{ UINT32_MAX };
+
+        // Largest distance the simplified surface may stray from the full mesh, in model space units. Zero for the full mesh.
+        float error{ 0.f };
+    };
+
+
+    struct Mesh
+    {
+        static constexpr uint32_t MAX_LOD_COUNT{ 4u };
+
+        // Level 0 is the full mesh, coarser levels index the same vertices with fewer triangles.
+        std::array<MeshLod, MAX_LOD_COUNT> lods{};
+        uint32_t lod_count{ 0u };
+
         int32_t vertex_offset{ INT32_MAX };
         uint32_t material_index{ UINT32_MAX };
+
+        // Width of the mesh indices in the model index buffer, the index offsets are counted in that width.
+        VkIndexType index_type{ VK_INDEX_TYPE_UINT32 };
+
+        // Model space bounds, the sphere is centered on the box. Both are tested against the view frustum when culling.
+        glm::vec3 bounds_min{ 0.f };
+        glm::vec3 bounds_max{ 0.f };
+        glm::vec3 bounds_center{ 0.f };
+        float bounds_radius{ 0.f };
     };
 
 }
@@ -4,11 +4,15 @@
 #include <__memory/Resource.h>
 
 #include <__buffer/Buffer.h>
+#include <__enum/VertexLayout.h>
 #include <__image/TextureImage.h>
+#include <__image/TextureStreamer.h>
+#include <__model/LodSelector.h>
 #include <__model/Mesh.h>
 #include <__model/ModelLoader.h>
 #include <__model/Vertex.h>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -16,17 +20,70 @@
 namespace cobalt
 {
     class DeviceSet;
+    class CommandOperator;
     class CommandPool;
+    class Pipeline;
+    class UploadContext;
 }
 
 namespace cobalt
 {
+    struct ModelCreateInfo
+    {
+        // Number of threads decoding the texture images, 0 picks the hardware concurrency.
+        uint32_t decode_thread_count{ 0u };
+
+        // Bake the textures to block compressed KTX2 files on first load and upload those instead of the source images.
+        // Only when DeviceFeatureFlags::TEXTURE_COMPRESSION_BC is enabled on the device, the sources are decoded as is
+        // otherwise. Request it through OptionalDeviceFeatures to keep devices without it usable.
+        bool compress_textures{ true };
+
+        // Layout of the vertex buffer, pipelines drawing the model must use the matching vertex input and shaders.
+        VertexLayout vertex_layout{ VertexLayout::FULL };
+
+        // Upload only the smallest levels of the baked textures and stream the finer ones in the background, the model can
+        // be drawn right away. Textures decoded from their sources are always fully resident.
+        bool stream_textures{ true };
+        TextureStreamerCreateInfo streaming{};
+
+        // Views the model is drawn from while others may still be in flight, e.g. one per frame in flight plus one per shadow
+        // map. Each has its own region of indirect draws.
+        uint32_t draw_view_count{ 1u };
+    };
+
+
+    // Consecutive draws of the model sharing an index type, issued by one indirect draw. The draw count is the most it issues.
+    struct DrawBatch
+    {
+        VkIndexType index_type{ VK_INDEX_TYPE_UINT32 };
+        uint32_t first_draw{ 0u };
+        uint32_t draw_count{ 0u };
+    };
+
+
+    // Push constants of the draw culling shader.
+    struct DrawCullConstants
+    {
+        // Normalized, pointing inwards: left, right, bottom, top, near and far.
+        std::array<glm::vec4, 6> frustum_planes{};
+
+        // Eye position, and the pixels per unit at distance one over the pixel threshold, negated for orthographic views.
+        glm::vec4 eye_lod_scale{ 0.f };
+
+        uint32_t draw_base{ 0u };
+        uint32_t count_base{ 0u };
+        uint32_t mesh_count{ 0u };
+        uint32_t lod_bias{ 0u };
+    };
+
+
     class Model final : public memory::Resource
     {
     public:
         using index_t = uint32_t;
 
-        explicit Model( DeviceSet const&, CommandPool&, loader::ModelLoader<Vertex, index_t> const& loader );
+        explicit Model( DeviceSet const&, CommandPool&, loader::ModelLoader<Vertex, index_t> const& loader,
+                        ModelCreateInfo const& create_info = {} );
         ~Model( ) noexcept override = default;
 
         Model( const Model& )                = delete;
@@ -37,6 +94,9 @@ namespace cobalt
         [[nodiscard]] std::span<Mesh const> meshes( ) const;
 
         [[nodiscard]] Buffer const& vertex_buffer( ) const;
+        [[nodiscard]] VertexLayout vertex_layout( ) const;
+
+        // Holds 16 and 32-bit indices, bind it at offset 0 with the index type of the mesh being drawn.
         [[nodiscard]] Buffer const& index_buffer( ) const;
 
         [[nodiscard]] Buffer const& surface_buffer( ) const;
@@ -45,20 +105,67 @@ namespace cobalt
 
         [[nodiscard]] std::pair<glm::vec3, glm::vec3> aabb( ) const;
 
+        // Local size the draw culling shader has to be compiled with.
+        static constexpr uint32_t DRAW_CULL_GROUP_SIZE{ 64u };
+
+        /**
+         * Written on the GPU by the draw culling, one VkDrawIndexedIndirectCommand per mesh for every view. The draws of a
+         * batch surviving the culling are packed at its front, the draw count buffer holds how many there are. The first
+         * instance of a draw is the material index of its mesh, shaders read it through gl_InstanceIndex.
+         */
+        [[nodiscard]] Buffer const& draw_buffer( ) const;
+        [[nodiscard]] VkDeviceSize draw_offset( uint32_t view ) const;
+        [[nodiscard]] std::span<DrawBatch const> draw_batches( ) const;
+
+        // One draw count per batch for every view.
+        [[nodiscard]] Buffer const& draw_count_buffer( ) const;
+        [[nodiscard]] VkDeviceSize draw_count_offset( uint32_t view, size_t batch ) const;
+
+        // The bounds, levels of detail and draw slot of every mesh in draw order, as read by the draw culling shader.
+        [[nodiscard]] Buffer const& mesh_cull_buffer( ) const;
+
+        /**
+         * Records the draw culling of the view outside of any rendering: meshes outside the frustum are dropped and the others
+         * drawn at the level of detail the selector picks. The culling pipeline must be bound with the mesh cull, draw and draw
+         * count buffers at bindings 0 to 2 of its first set. The GPU must be done with the view's previous draws.
+         */
+        void record_draw_culling( CommandOperator const&, Pipeline const& cull_pipeline, uint32_t view,
+                                  glm::mat4 const& view_projection, LodSelector const& ) const;
+
+        /**
+         * Prioritizes the streamed textures by the screen area their materials cover from this view and swaps in the levels
+         * that finished uploading. Call it on the render thread once the frame has been waited for. Returns true if the
+         * texture descriptors of that frame must be rewritten.
+         */
+        [[nodiscard]] bool update_texture_streaming( glm::mat4 const& view, glm::mat4 const& projection, VkExtent2D viewport,
+                                                     uint32_t frame_index );
+
     private:
         std::vector<Mesh> meshes_{};
 
         std::unique_ptr<Buffer> index_buffer_ptr_{ nullptr };
         std::unique_ptr<Buffer> vertex_buffer_ptr_{ nullptr };
+        VertexLayout vertex_layout_{ VertexLayout::FULL };
+
+        std::unique_ptr<Buffer> draw_buffer_ptr_{ nullptr };
+        std::unique_ptr<Buffer> draw_count_buffer_ptr_{ nullptr };
+        std::unique_ptr<Buffer> mesh_cull_buffer_ptr_{ nullptr };
+        std::vector<DrawBatch> draw_batches_{};
+        uint32_t draw_view_count_{ 0u };
 
         std::unique_ptr<Buffer> surface_buffer_ptr_{ nullptr };
         std::vector<TextureImage> textures_{};
+        std::vector<std::array<uint32_t, 5>> material_textures_{};
+        std::unique_ptr<TextureStreamer> streamer_ptr_{ nullptr };
 
         glm::vec3 aabb_min_{ 0.0f };
         glm::vec3 aabb_max_{ 0.0f };
 
-        void create_texture_images( DeviceSet const&, CommandPool&, std::span<TextureGroup const> textures );
-        void create_materials_buffer( DeviceSet const&, CommandPool&, std::span<SurfaceMap const> materials );
+        void create_texture_images( UploadContext&, std::span<TextureGroup const> textures, ModelCreateInfo const& create_info );
+        void create_index_buffer( UploadContext&, std::span<index_t const> indices );
+        void create_vertex_buffer( UploadContext&, std::span<Vertex const> vertices, VertexLayout layout );
+        void create_draw_buffers( UploadContext&, uint32_t view_count );
+        void create_materials_buffer( UploadContext&, std::span<SurfaceMap const> materials );
         void calculate_aabb( std::span<Vertex const> vertices );
 
     };
@@ -6,6 +6,7 @@
 #include <__model/TextureGroup.h>
 
 #include <filesystem>
+#include <vector>
 
 
 namespace cobalt::loader
@@ -0,0 +1,110 @@
+#ifndef PACKEDVERTEX_H
+#define PACKEDVERTEX_H
+
+#include <__model/Vertex.h>
+
+#include <glm/glm.hpp>
+
+#include <vulkan/vulkan_core.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * Compact counterpart of Vertex. The position stays full precision, the uv is stored as half floats and the normal and
+ * tangent are octahedral encoded. The bitangent is rebuilt in the vertex shader from the normal, the tangent and a sign.
+ */
+struct PackedVertex
+{
+    glm::vec3 position;
+    uint32_t uv;      // half x2
+    uint32_t normal;  // octahedral, snorm16 x2
+    uint32_t tangent; // octahedral in xy, bitangent sign in z, snorm8 x4
+
+
+    [[nodiscard]] static PackedVertex pack( Vertex const& vertex )
+    {
+        // The bitangent only needs its handedness, the shader uses cross( normal, tangent ) * sign.
+        float const bitangent_sign = glm::dot( glm::cross( vertex.normal, vertex.tangent ), vertex.bi_tangent ) < 0.f ? -1.f : 1.f;
+        glm::vec2 const tangent    = encode_octahedral( vertex.tangent );
+
+        return {
+            .position = vertex.position,
+            .uv = glm::packHalf2x16( vertex.uv ),
+            .normal = glm::packSnorm2x16( encode_octahedral( vertex.normal ) ),
+            .tangent = glm::packSnorm4x8( glm::vec4{ tangent.x, tangent.y, bitangent_sign, 0.f } )
+        };
+    }
+
+
+    static consteval VkVertexInputBindingDescription get_binding_description( )
+    {
+        return {
+            .binding = 0,
+            .stride = sizeof( PackedVertex ),
+            .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+        };
+    }
+
+
+    static constexpr std::vector<VkVertexInputAttributeDescription> get_attribute_descriptions( )
+    {
+        // The normalized formats are expanded by the input assembler, the shader only decodes the octahedral mapping.
+        return {
+            VkVertexInputAttributeDescription{
+                .location = 0,
+                .binding = 0,
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = offsetof( PackedVertex, position )
+            },
+            VkVertexInputAttributeDescription{
+                .location = 1,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SFLOAT,
+                .offset = offsetof( PackedVertex, uv )
+            },
+            VkVertexInputAttributeDescription{
+                .location = 2,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = offsetof( PackedVertex, normal )
+            },
+            VkVertexInputAttributeDescription{
+                .location = 3,
+                .binding = 0,
+                .format = VK_FORMAT_R8G8B8A8_SNORM,
+                .offset = offsetof( PackedVertex, tangent )
+            },
+        };
+    }
+
+private:
+    [[nodiscard]] static glm::vec2 encode_octahedral( glm::vec3 const& direction )
+    {
+        // Project onto the octahedron, the lower hemisphere is folded over the diagonals.
+        float const l1_norm = std::abs( direction.x ) + std::abs( direction.y ) + std::abs( direction.z );
+        if ( l1_norm == 0.f )
+        {
+            return { 0.f, 0.f };
+        }
+
+        glm::vec3 const n = direction / l1_norm;
+        if ( n.z >= 0.f )
+        {
+            return { n.x, n.y };
+        }
+        return {
+            ( 1.f - std::abs( n.y ) ) * ( n.x >= 0.f ? 1.f : -1.f ),
+            ( 1.f - std::abs( n.x ) ) * ( n.y >= 0.f ? 1.f : -1.f )
+        };
+    }
+
+};
+
+
+static_assert( sizeof( PackedVertex ) == 24u, "PackedVertex is expected to stay 24 bytes" );
+
+
+#endif //!PACKEDVERTEX_H
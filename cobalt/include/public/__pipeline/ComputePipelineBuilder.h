@@ -0,0 +1,48 @@
+#ifndef COMPUTEPIPELINEBUILDER_H
+#define COMPUTEPIPELINEBUILDER_H
+
+#include "Pipeline.h"
+
+#include <__shader/ShaderModule.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <optional>
+
+
+namespace cobalt
+{
+    class PipelineCache;
+}
+
+namespace cobalt::builder
+{
+    class ComputePipelineBuilder final
+    {
+    public:
+        ComputePipelineBuilder( ) = default;
+        ~ComputePipelineBuilder( ) noexcept = default;
+
+        ComputePipelineBuilder( const ComputePipelineBuilder& )                = delete;
+        ComputePipelineBuilder( ComputePipelineBuilder&& ) noexcept            = delete;
+        ComputePipelineBuilder& operator=( const ComputePipelineBuilder& )     = delete;
+        ComputePipelineBuilder& operator=( ComputePipelineBuilder&& ) noexcept = delete;
+
+        ComputePipelineBuilder& set_shader_module(
+            shader::ShaderModule&& shader, VkSpecializationInfo const* = nullptr, char const* entry_point = "main" );
+        // References a module owned elsewhere, e.g. by a ShaderLibrary. It must outlive the builds.
+        ComputePipelineBuilder& set_shader_module(
+            shader::ShaderModule const& shader, VkSpecializationInfo const* = nullptr, char const* entry_point = "main" );
+
+        Pipeline build( DeviceSet const&, PipelineLayout const&, PipelineCache const* = nullptr ) const;
+
+    private:
+        std::optional<shader::ShaderModule> shader_module_{};
+        VkPipelineShaderStageCreateInfo shader_stage_{};
+
+    };
+
+}
+
+
+#endif //!COMPUTEPIPELINEBUILDER_H
@@ -14,6 +14,7 @@
 namespace cobalt
 {
     class DescriptorSetLayout;
+    class PipelineCache;
 }
 
 namespace cobalt::builder
@@ -42,12 +43,15 @@ namespace cobalt::builder
 
         GraphicsPipelineBuilder& add_shader_module(
             shader::ShaderModule&& shader, VkSpecializationInfo const* = nullptr, char const* entry_point = "main" );
+        // References a module owned elsewhere, e.g. by a ShaderLibrary. It must outlive the builds.
+        GraphicsPipelineBuilder& add_shader_module(
+            shader::ShaderModule const& shader, VkSpecializationInfo const* = nullptr, char const* entry_point = "main" );
 
         GraphicsPipelineBuilder& set_dynamic_state( std::span<VkDynamicState const> dynamic_states );
 
         GraphicsPipelineBuilder& set_cull_mode( VkCullModeFlags );
 
-        Pipeline build( DeviceSet const&, PipelineLayout const&, VkPipelineBindPoint ) const;
+        Pipeline build( DeviceSet const&, PipelineLayout const&, VkPipelineBindPoint, PipelineCache const* = nullptr ) const;
 
     private:
         VkPipelineInputAssemblyStateCreateInfo input_assembly_{};
@@ -74,6 +78,22 @@ namespace cobalt::builder
 
     };
 
+
+    struct GraphicsPipelineBuild
+    {
+        GraphicsPipelineBuilder const& builder;
+        PipelineLayout const& layout;
+        VkPipelineBindPoint bind_point{ VK_PIPELINE_BIND_POINT_GRAPHICS };
+    };
+
+
+    /**
+     * Compiles the pipelines concurrently on a pool of worker threads, 0 threads picks the hardware concurrency. The pipelines
+     * are returned in the order of the builds, the first build failing rethrows its error once all builds are done.
+     */
+    [[nodiscard]] std::vector<Pipeline> build_pipelines( DeviceSet const&, std::span<GraphicsPipelineBuild const> builds,
+                                                         PipelineCache const* = nullptr, uint32_t thread_count = 0u );
+
 }
 
 
@@ -19,14 +19,23 @@ namespace cobalt
     struct PipelineCreateInfo
     {
         VkPipelineBindPoint bind_point;
+        VkPipelineCache cache;
         VkGraphicsPipelineCreateInfo create_info;
     };
 
 
+    struct ComputePipelineCreateInfo
+    {
+        VkPipelineCache cache;
+        VkComputePipelineCreateInfo create_info;
+    };
+
+
     class Pipeline final : public memory::Resource
     {
     public:
         explicit Pipeline( DeviceSet const&, PipelineLayout const&, PipelineCreateInfo const& );
+        explicit Pipeline( DeviceSet const&, PipelineLayout const&, ComputePipelineCreateInfo const& );
         ~Pipeline( ) noexcept override;
 
         Pipeline( Pipeline&& ) noexcept;
@@ -0,0 +1,50 @@
+#ifndef PIPELINECACHE_H
+#define PIPELINECACHE_H
+
+#include <__memory/Resource.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <filesystem>
+
+
+namespace cobalt
+{
+    class DeviceSet;
+}
+
+namespace cobalt
+{
+    /**
+     * VkPipelineCache persisted to disk between runs. The blob is stamped with the vendor, device, driver version and UUIDs
+     * of the physical device, a stamp that does not match the current device starts an empty cache instead. Pipelines can be
+     * created against the cache from several threads at once.
+     */
+    class PipelineCache final : public memory::Resource
+    {
+    public:
+        explicit PipelineCache( DeviceSet const&, std::filesystem::path cache_path );
+        ~PipelineCache( ) noexcept override;
+
+        PipelineCache( const PipelineCache& )                = delete;
+        PipelineCache( PipelineCache&& ) noexcept            = delete;
+        PipelineCache& operator=( const PipelineCache& )     = delete;
+        PipelineCache& operator=( PipelineCache&& ) noexcept = delete;
+
+        [[nodiscard]] VkPipelineCache handle( ) const;
+
+        // Writes the current contents to disk, also done on destruction.
+        void save( ) const;
+
+    private:
+        DeviceSet const& device_ref_;
+        std::filesystem::path const cache_path_;
+
+        VkPipelineCache pipeline_cache_{ VK_NULL_HANDLE };
+
+    };
+
+}
+
+
+#endif //!PIPELINECACHE_H
@@ -7,9 +7,15 @@
 #include <__synchronization/RenderSync.h>
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 
+namespace cobalt::cleanup
+{
+    class DeletionQueue;
+}
+
 namespace cobalt
 {
     class DeviceSet;
@@ -28,6 +34,9 @@ namespace cobalt
         CommandPool* cmd_pool{ nullptr };
         Swapchain* swapchain{ nullptr };
         uint32_t max_frames_in_flight{ UINT32_MAX };
+
+        // Optional, advanced to every frame recorded and collected as soon as its fence has been waited on.
+        cleanup::DeletionQueue* deletion_queue{ nullptr };
     };
 
 
@@ -40,6 +49,10 @@ namespace cobalt
         explicit Renderer( RendererCreateInfo const& );
         VkResult render( ) const;
 
+        // Blocks until every submitted frame has completed. Unlike waiting for the device, work submitted from other threads
+        // keeps running.
+        void wait_frames_in_flight( ) const;
+
         void set_record_command_buffer_fn( std::function<record_command_buffer_sig_t> ) noexcept;
         void set_update_uniform_buffer_fn( std::function<update_uniform_buffer_sig_t> ) noexcept;
 
@@ -52,6 +65,11 @@ namespace cobalt
         uint32_t const max_frames_in_flight_{ UINT32_MAX };
         mutable uint64_t current_frame_{ 0 };
 
+        cleanup::DeletionQueue* const deletion_queue_ptr_{ nullptr };
+
+        // Deletion queue frame last submitted from each frame slot, 0 when nothing was yet.
+        mutable std::vector<uint64_t> slot_deletion_frames_{};
+
         std::function<record_command_buffer_sig_t> record_command_buffer_fn_{ nullptr };
         std::function<update_uniform_buffer_sig_t> update_uniform_buffer_fn_{ nullptr };
 
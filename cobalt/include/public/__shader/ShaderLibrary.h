@@ -0,0 +1,44 @@
+#ifndef SHADERLIBRARY_H
+#define SHADERLIBRARY_H
+
+#include <__memory/Resource.h>
+
+#include <__shader/ShaderModule.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+
+namespace cobalt::shader
+{
+    /**
+     * Owns the shader modules of an application, keyed by path and stage. Every file is read and turned into a module once,
+     * builders reference the shared module instead of loading their own copy.
+     */
+    class ShaderLibrary final : public memory::Resource
+    {
+    public:
+        explicit ShaderLibrary( DeviceSet const& );
+        ~ShaderLibrary( ) noexcept override = default;
+
+        ShaderLibrary( const ShaderLibrary& )                = delete;
+        ShaderLibrary( ShaderLibrary&& ) noexcept            = delete;
+        ShaderLibrary& operator=( const ShaderLibrary& )     = delete;
+        ShaderLibrary& operator=( ShaderLibrary&& ) noexcept = delete;
+
+        [[nodiscard]] ShaderModule const& load( std::filesystem::path const& path, VkShaderStageFlagBits stage );
+
+    private:
+        DeviceSet const& device_ref_;
+
+        // Modules are owned through pointers, references handed out stay valid while the map grows.
+        std::unordered_map<std::string, std::unique_ptr<ShaderModule>> modules_{};
+
+    };
+
+}
+
+
+#endif //!SHADERLIBRARY_H
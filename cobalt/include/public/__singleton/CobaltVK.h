@@ -4,12 +4,14 @@
 #include <log.h>
 #include <__cleanup/DeletionQueue.h>
 #include <__context/VkContext.h>
-#include <__memory/handle/HandleTable.h>
+#include <__memory/handle/ResourcePool.h>
 #include <cobalt_vk/handle.h>
 #include <__memory/handle/ResourceHandle.h>
 #include <__render/Swapchain.h>
 
-#include <stack>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
 
 
 namespace cobalt
@@ -26,46 +28,51 @@ namespace cobalt
         CobaltVK& operator=( CobaltVK&& ) noexcept = delete;
 
         static CobaltVK& get_instance( );
+
+        // Destroys every resource still alive, newest first. The device must be idle.
         void reset_instance( );
 
+        // Released resources wait here until the frames in flight are done with them, a Renderer advances and collects it.
+        [[nodiscard]] cleanup::DeletionQueue& deletion_queue( );
+
         template <typename resource_t, typename... args_t>
             requires std::derived_from<resource_t, memory::Resource>
-        [[nodiscard]] ResourceHandle<resource_t, memory::Resource> create_resource( args_t&&... args );
+        [[nodiscard]] ResourceHandle<resource_t> create_resource( args_t&&... args );
 
     private:
         cleanup::DeletionQueue deletion_queue_{};
-        std::vector<std::unique_ptr<memory::Resource>> resources_{};
-        HandleTable<memory::Resource> resources_table_{};
+        std::unordered_map<std::type_index, std::unique_ptr<memory::ResourcePoolBase>> pools_{};
+        uint64_t next_sequence_{ 0u };
 
         CobaltVK( ) = default;
 
         template <typename resource_t>
-        [[nodiscard]] memory::Resource* store_resource( std::unique_ptr<resource_t>&& resource );
+        [[nodiscard]] memory::ResourcePool<resource_t>& pool_of( );
+
+        [[nodiscard]] size_t live_resource_count( ) const;
 
     };
 
 
     template <typename resource_t, typename... args_t>
         requires std::derived_from<resource_t, memory::Resource>
-    ResourceHandle<resource_t, memory::Resource> CobaltVK::create_resource( args_t&&... args )
+    ResourceHandle<resource_t> CobaltVK::create_resource( args_t&&... args )
     {
-        auto* const resource = this->store_resource( std::make_unique<resource_t>( std::forward<args_t>( args )... ) );
-
-        auto const table_info = resources_table_.insert( *resource );
-        ResourceHandle<resource_t, memory::Resource> handle{ resources_table_, table_info };
-        deletion_queue_.push( [this, resource, table_info]
-            {
-                resources_table_.erase( table_info );
-                std::erase_if( resources_, [resource]( auto const& uptr ) { return uptr.get( ) == resource; } );
-            } );
-        return handle;
+        auto& pool = pool_of<resource_t>( );
+        auto const info = pool.emplace( next_sequence_++, std::forward<args_t>( args )... );
+        return ResourceHandle<resource_t>{ pool, info };
     }
 
 
     template <typename resource_t>
-    memory::Resource* CobaltVK::store_resource( std::unique_ptr<resource_t>&& resource )
+    memory::ResourcePool<resource_t>& CobaltVK::pool_of( )
     {
-        return static_cast<resource_t*>( resources_.emplace_back( std::move( resource ) ).get( ) );
+        auto& pool_ptr = pools_[std::type_index{ typeid( resource_t ) }];
+        if ( pool_ptr == nullptr )
+        {
+            pool_ptr = std::make_unique<memory::ResourcePool<resource_t>>( &deletion_queue_ );
+        }
+        return static_cast<memory::ResourcePool<resource_t>&>( *pool_ptr );
     }
 
 
@@ -31,6 +31,8 @@ namespace cobalt::sync
 
         [[nodiscard]] VkFence handle( ) const noexcept;
 
+        [[nodiscard]] bool signaled( ) const noexcept;
+
         void wait( ) const noexcept;
         void reset( ) const noexcept;
 
@@ -0,0 +1,71 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace cobalt::thread
+{
+    /**
+     * Fixed set of worker threads consuming a shared task queue. Work is handed out either as single tasks through submit, or as
+     * an index range through parallel_for, which blocks the caller until every index has been processed.
+     */
+    class WorkerPool final
+    {
+    public:
+        explicit WorkerPool( uint32_t thread_count = 0u );
+        ~WorkerPool( ) noexcept;
+
+        WorkerPool( const WorkerPool& )                = delete;
+        WorkerPool( WorkerPool&& ) noexcept            = delete;
+        WorkerPool& operator=( const WorkerPool& )     = delete;
+        WorkerPool& operator=( WorkerPool&& ) noexcept = delete;
+
+        [[nodiscard]] uint32_t thread_count( ) const;
+
+        template <typename fn_t>
+        [[nodiscard]] std::future<std::invoke_result_t<fn_t>> submit( fn_t&& fn );
+
+        void parallel_for( size_t count, std::function<void( size_t )> const& fn );
+
+        [[nodiscard]] static uint32_t default_thread_count( );
+
+    private:
+        std::vector<std::thread> workers_{};
+
+        std::mutex queue_mutex_{};
+        std::condition_variable queue_cv_{};
+        std::queue<std::function<void( )>> tasks_{};
+        bool stopping_{ false };
+
+        void enqueue( std::function<void( )>&& task );
+        void worker_loop( );
+
+    };
+
+
+    template <typename fn_t>
+    std::future<std::invoke_result_t<fn_t>> WorkerPool::submit( fn_t&& fn )
+    {
+        // std::function requires copyable targets, the packaged task is therefore shared with the queued wrapper.
+        using result_t = std::invoke_result_t<fn_t>;
+        auto task      = std::make_shared<std::packaged_task<result_t( )>>( std::forward<fn_t>( fn ) );
+
+        std::future<result_t> future = task->get_future( );
+        enqueue( [task] { ( *task )( ); } );
+        return future;
+    }
+
+}
+
+
+#endif //!WORKERPOOL_H
@@ -39,6 +39,9 @@ namespace cobalt::validation
         feat_map.emplace( DeviceFeatureFlags::FAMILIES_INDICES_SUITABLE, std::make_unique<exe::FamilyIndicesFeature>( ) );
         feat_map.emplace( DeviceFeatureFlags::SHADER_IMAGE_ARRAY_NON_UNIFORM_INDEXING,
                           std::make_unique<exe::ShaderImgArrNonUniIdxFeature>( ) );
+        feat_map.emplace( DeviceFeatureFlags::TEXTURE_COMPRESSION_BC, std::make_unique<exe::TextureCompressionBCFeature>( ) );
+        feat_map.emplace( DeviceFeatureFlags::MULTI_DRAW_INDIRECT, std::make_unique<exe::MultiDrawIndirectFeature>( ) );
+        feat_map.emplace( DeviceFeatureFlags::DRAW_INDIRECT_COUNT, std::make_unique<exe::DrawIndirectCountFeature>( ) );
         return feat_map;
     }
 
@@ -54,12 +57,15 @@ namespace cobalt::validation
     public:
         PhysicalDeviceSelector( InstanceBundle const&, DeviceFeatureFlags features );
         [[nodiscard]] bool select( VkPhysicalDevice device ) const;
+        // The subset of the features the device supports, whether or not they were required.
+        [[nodiscard]] DeviceFeatureFlags supported( VkPhysicalDevice device, DeviceFeatureFlags features ) const;
         [[nodiscard]] exe::EnableData require( ) const;
 
     private:
         InstanceBundle const& instance_ref_;
         DeviceFeatureFlags const features_;
 
+        [[nodiscard]] exe::ValidationData query( VkPhysicalDevice device ) const;
         static void get_extensions( VkPhysicalDevice device, std::vector<VkExtensionProperties>& dest );
 
 
@@ -6,17 +6,31 @@
 
 #include <__buffer/Buffer.h>
 #include <__buffer/CommandPool.h>
+#include <__buffer/StagingRing.h>
+#include <__buffer/UploadContext.h>
 #include <__context/VkContext.h>
 #include <__descriptor/DescriptorAllocator.h>
 #include <__enum/ValidationFlags.h>
+#include <__image/CubemapCache.h>
 #include <__image/ImageCollection.h>
 #include <__image/ImageSampler.h>
+#include <__image/SphericalHarmonics.h>
+#include <__io/MappedFile.h>
+#include <__io/hash.h>
+#include <__memory/DeviceAllocator.h>
 #include <__model/AssimpModelLoader.h>
+#include <__model/AsyncModel.h>
+#include <__model/BakedModelLoader.h>
+#include <__model/LodSelector.h>
 #include <__model/Model.h>
+#include <__model/PackedVertex.h>
+#include <__pipeline/ComputePipelineBuilder.h>
 #include <__pipeline/GraphicsPipelineBuilder.h>
 #include <__pipeline/Pipeline.h>
+#include <__pipeline/PipelineCache.h>
 #include <__render/Renderer.h>
 #include <__render/Swapchain.h>
+#include <__shader/ShaderLibrary.h>
 #include <__shader/ShaderModule.h>
 #include <__singleton/CobaltVK.h>
 
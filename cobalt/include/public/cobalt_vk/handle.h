@@ -5,10 +5,15 @@
 #include <__memory/handle/ResourceHandle.h>
 
 
+namespace cobalt::shader
+{
+    class ShaderLibrary;
+}
+
 namespace cobalt
 {
     template <typename resource_t>
-    using DefaultHandle = ResourceHandle<resource_t, memory::Resource>;
+    using DefaultHandle = ResourceHandle<resource_t>;
 
     using VkContextHandle = DefaultHandle<class VkContext>;
     using WindowHandle = DefaultHandle<class Window>;
@@ -20,12 +25,15 @@ namespace cobalt
     using DescriptorAllocatorHandle = DefaultHandle<class DescriptorAllocator>;
     using PipelineLayoutHandle = DefaultHandle<class PipelineLayout>;
     using PipelineHandle = DefaultHandle<class Pipeline>;
+    using PipelineCacheHandle = DefaultHandle<class PipelineCache>;
     using ImageHandle = DefaultHandle<class Image>;
     using TextureImageHandle = DefaultHandle<class TextureImage>;
     using ImageSamplerHandle = DefaultHandle<class ImageSampler>;
     using ImageCollectionHandle = DefaultHandle<class ImageCollection>;
     using RendererHandle = DefaultHandle<class Renderer>;
     using ModelHandle = DefaultHandle<class Model>;
+    using AsyncModelHandle = DefaultHandle<class AsyncModel>;
+    using ShaderLibraryHandle = DefaultHandle<shader::ShaderLibrary>;
 
 }
 
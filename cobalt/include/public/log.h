@@ -3,6 +3,7 @@
 
 #include <format>
 #include <string_view>
+#include <typeinfo>
 
 
 namespace cobalt::log
@@ -13,12 +14,21 @@ namespace cobalt::log
     template <typename class_t>
     void logerr( std::string_view const& sender, std::string_view const& message, bool const conditional = true )
     {
+        // The sender is only formatted when there is something to print.
+        if ( not conditional )
+        {
+            return;
+        }
         logerr( std::format( "{}::{}", typeid( class_t ).name( ), sender ), message, conditional );
     }
 
     template <typename class_t>
     void loginfo( std::string_view const& sender, std::string_view const& message, bool const conditional = true )
     {
+        if ( not conditional )
+        {
+            return;
+        }
         loginfo( std::format( "{}::{}", typeid( class_t ).name( ), sender ), message, conditional );
     }
 
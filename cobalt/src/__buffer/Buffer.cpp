@@ -1,13 +1,14 @@
 #include <__buffer/Buffer.h>
 
 #include <__buffer/CommandPool.h>
+#include <__buffer/UploadContext.h>
 #include <__context/DeviceSet.h>
 #include <__image/Image.h>
 #include <__meta/expect_size.h>
-#include <__query/device_queries.h>
 #include <__validation/result.h>
 
 #include <cassert>
+#include <cstddef>
 
 
 namespace cobalt
@@ -16,7 +17,8 @@ namespace cobalt
     // | BUFFER                    |
     // +---------------------------+
     Buffer::Buffer( DeviceSet const& device, VkDeviceSize const size, VkBufferUsageFlags const usage,
-                    VkMemoryPropertyFlags const properties, buffer::BufferContentType const content_type )
+                    VkMemoryPropertyFlags const properties, buffer::BufferContentType const content_type,
+                    memory::AllocationLifetime const lifetime )
         : device_ref_{ device }
         , content_type_{ content_type }
         , buffer_size_{ size }
@@ -38,21 +40,16 @@ namespace cobalt
         // 2. alignment: The offset in bytes where the buffer begins in the allocated region of memory, depends on
         //    bufferInfo.usage and bufferInfo.flags
         // 3. memoryTypeBits: Bit field of the memory types that are suitable for the buffer.
-        VkMemoryRequirements const mem_requirements = fetch_memory_requirements( );
-        VkMemoryAllocateInfo const alloc_info{
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = ( memory_size_ = mem_requirements.size ),
-            .memoryTypeIndex = query::find_memory_type( device_ref_.physical( ), mem_requirements.memoryTypeBits, properties )
-        };
-
-        validation::throw_on_bad_result(
-            vkAllocateMemory( device_ref_.logical( ), &alloc_info, nullptr, &buffer_memory_ ),
-            "Failed to allocate buffer memory!" );
-
-        // If memory allocation was successful, then we can now associate this memory with the buffer.
-        // Since this memory is allocated specifically for this vertex buffer, the offset is simply 0. If the offset is
-        // non-zero, then it is required to be divisible by memRequirements.alignment.
-        vkBindBufferMemory( device_ref_.logical( ), buffer_, buffer_memory_, 0 );
+        allocation_ = device_ref_.allocator( ).allocate( memory::AllocationRequest{
+            .requirements = fetch_memory_requirements( ),
+            .properties = properties,
+            .linear_resource = true,
+            .lifetime = lifetime
+        } );
+
+        // The buffer shares its memory block with other resources, the allocator already aligned the offset to
+        // memRequirements.alignment.
+        vkBindBufferMemory( device_ref_.logical( ), buffer_, allocation_.memory, allocation_.offset );
     }
 
 
@@ -64,19 +61,19 @@ namespace cobalt
             unmap_memory( );
         }
 
-        // 2. Free the GPU buffer memory
-        if ( buffer_memory_ != VK_NULL_HANDLE )
-        {
-            vkFreeMemory( device_ref_.logical( ), buffer_memory_, nullptr );
-            buffer_memory_ = VK_NULL_HANDLE;
-        }
-
-        // 3. Destroy the buffer
+        // 2. Destroy the buffer
         if ( buffer_ != VK_NULL_HANDLE )
         {
             vkDestroyBuffer( device_ref_.logical( ), buffer_, nullptr );
             buffer_ = VK_NULL_HANDLE;
         }
+
+        // 3. Hand the GPU memory back to the allocator
+        if ( allocation_.valid( ) )
+        {
+            device_ref_.allocator( ).free( allocation_ );
+            allocation_ = {};
+        }
     }
 
 
@@ -84,14 +81,13 @@ namespace cobalt
         : device_ref_{ other.device_ref_ }
         , content_type_{ other.content_type_ }
         , buffer_size_{ other.buffer_size_ }
-        , memory_size_{ other.memory_size_ }
         , buffer_{ other.buffer_ }
-        , buffer_memory_{ other.buffer_memory_ }
+        , allocation_{ other.allocation_ }
         , memory_map_ptr_{ other.memory_map_ptr_ }
     {
-        meta::expect_size<Buffer, 64u>( );
+        meta::expect_size<Buffer, 80u>( );
         other.buffer_         = VK_NULL_HANDLE;
-        other.buffer_memory_  = VK_NULL_HANDLE;
+        other.allocation_     = {};
         other.memory_map_ptr_ = nullptr;
     }
 
@@ -104,7 +100,13 @@ namespace cobalt
 
     VkDeviceMemory Buffer::memory( ) const
     {
-        return buffer_memory_;
+        return allocation_.memory;
+    }
+
+
+    VkDeviceSize Buffer::memory_offset( ) const
+    {
+        return allocation_.offset;
     }
 
 
@@ -122,7 +124,13 @@ namespace cobalt
 
     VkDeviceSize Buffer::memory_size( ) const
     {
-        return memory_size_;
+        return allocation_.size;
+    }
+
+
+    void* Buffer::data( ) const
+    {
+        return memory_map_ptr_;
     }
 
 
@@ -133,15 +141,22 @@ namespace cobalt
     }
 
 
-    void Buffer::map_memory( VkDeviceSize const offset, VkMemoryMapFlags const flags )
+    void Buffer::read( void* const data, size_t const size ) const
+    {
+        assert( memory_map_ptr_ != nullptr && "Buffer::read: call map memory before reading data." );
+        memcpy( data, memory_map_ptr_, size );
+    }
+
+
+    void Buffer::map_memory( VkDeviceSize const offset )
     {
-        vkMapMemory( device_ref_.logical( ), buffer_memory_, offset, memory_size_, flags, &memory_map_ptr_ );
+        // The block stays mapped for as long as it lives, mapping only resolves the pointer to this buffer's range.
+        memory_map_ptr_ = static_cast<std::byte*>( device_ref_.allocator( ).map( allocation_ ) ) + offset;
     }
 
 
     void Buffer::unmap_memory( )
     {
-        vkUnmapMemory( device_ref_.logical( ), buffer_memory_ );
         memory_map_ptr_ = nullptr;
     }
 
@@ -206,18 +221,22 @@ namespace cobalt
                                                VkDeviceSize const size, VkBufferUsageFlags const main_usage_bit,
                                                BufferContentType const content_type )
         {
-            Buffer staging_buffer = make_staging_buffer( device, size );
+            UploadContext upload_context{ device, cmd_pool };
+            Buffer data_buffer = allocate_data_buffer( upload_context, data, size, main_usage_bit, content_type );
+            upload_context.submit( ).wait( );
+            return data_buffer;
+        }
 
-            staging_buffer.map_memory( );
-            staging_buffer.write( data, staging_buffer.memory_size( ) );
-            staging_buffer.unmap_memory( );
 
+        Buffer internal::allocate_data_buffer( UploadContext& upload_context, void const* data, VkDeviceSize const size,
+                                               VkBufferUsageFlags const main_usage_bit, BufferContentType const content_type )
+        {
             Buffer data_buffer{
-                device, size,
+                upload_context.device( ), size,
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | main_usage_bit,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, content_type
             };
-            staging_buffer.copy_to( data_buffer, cmd_pool );
+            upload_context.upload( data_buffer, data, size );
             return data_buffer;
         }
 
@@ -226,7 +245,18 @@ namespace cobalt
         {
             return Buffer{
                 device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                BufferContentType::ANY, memory::AllocationLifetime::TRANSIENT
+            };
+        }
+
+
+        Buffer make_readback_buffer( DeviceSet const& device, VkDeviceSize const size )
+        {
+            return Buffer{
+                device, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                BufferContentType::ANY, memory::AllocationLifetime::TRANSIENT
             };
         }
 
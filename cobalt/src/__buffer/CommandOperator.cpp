@@ -128,6 +128,13 @@ namespace cobalt
     }
 
 
+    void CommandOperator::bind_index_buffer( Buffer const& buffer, VkDeviceSize const offset,
+                                             VkIndexType const index_type ) const
+    {
+        vkCmdBindIndexBuffer( command_buffer_, buffer.handle( ), offset, index_type );
+    }
+
+
     void CommandOperator::push_constants( Pipeline const& pipeline, VkShaderStageFlags const stage_flags,
                                           uint32_t const offset, uint32_t const size, void const* data ) const
     {
@@ -149,6 +156,36 @@ namespace cobalt
     }
 
 
+    void CommandOperator::draw_indexed_indirect( Buffer const& commands, VkDeviceSize const offset, uint32_t const draw_count,
+                                                 uint32_t const stride ) const
+    {
+        vkCmdDrawIndexedIndirect( command_buffer_, commands.handle( ), offset, draw_count, stride );
+    }
+
+
+    void CommandOperator::draw_indexed_indirect_count( Buffer const& commands, VkDeviceSize const offset,
+                                                       Buffer const& count, VkDeviceSize const count_offset,
+                                                       uint32_t const max_draw_count, uint32_t const stride ) const
+    {
+        vkCmdDrawIndexedIndirectCount( command_buffer_, commands.handle( ), offset, count.handle( ), count_offset,
+                                       max_draw_count, stride );
+    }
+
+
+    void CommandOperator::dispatch( uint32_t const group_count_x, uint32_t const group_count_y,
+                                    uint32_t const group_count_z ) const
+    {
+        vkCmdDispatch( command_buffer_, group_count_x, group_count_y, group_count_z );
+    }
+
+
+    void CommandOperator::fill_buffer( Buffer const& buffer, VkDeviceSize const offset, VkDeviceSize const size,
+                                       uint32_t const data ) const
+    {
+        vkCmdFillBuffer( command_buffer_, buffer.handle( ), offset, size, data );
+    }
+
+
     void CommandOperator::copy_buffer_to_image( Buffer const& src, Image const& dst, VkBufferImageCopy const& region ) const
     {
         vkCmdCopyBufferToImage(
@@ -162,6 +199,34 @@ namespace cobalt
     }
 
 
+    void CommandOperator::copy_buffer_to_image( Buffer const& src, Image const& dst,
+                                                std::span<VkBufferImageCopy const> const regions ) const
+    {
+        vkCmdCopyBufferToImage(
+            command_buffer_,
+            src.handle( ),
+            dst.handle( ),
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>( regions.size( ) ),
+            regions.data( )
+        );
+    }
+
+
+    void CommandOperator::copy_image_to_buffer( Image const& src, Buffer const& dst,
+                                                std::span<VkBufferImageCopy const> const regions ) const
+    {
+        vkCmdCopyImageToBuffer(
+            command_buffer_,
+            src.handle( ),
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            dst.handle( ),
+            static_cast<uint32_t>( regions.size( ) ),
+            regions.data( )
+        );
+    }
+
+
     void CommandOperator::copy_buffer( Buffer const& src, Buffer const& dst ) const
     {
         VkBufferCopy const copy_region{
@@ -170,4 +235,25 @@ namespace cobalt
         vkCmdCopyBuffer( command_buffer_, src.handle( ), dst.handle( ), 1, &copy_region );
     }
 
+
+    void CommandOperator::copy_buffer( Buffer const& src, Buffer const& dst, VkBufferCopy const& region ) const
+    {
+        vkCmdCopyBuffer( command_buffer_, src.handle( ), dst.handle( ), 1, &region );
+    }
+
+
+    void CommandOperator::blit_image( Image const& src, Image const& dst, VkImageBlit const& region, VkFilter const filter ) const
+    {
+        vkCmdBlitImage(
+            command_buffer_,
+            src.handle( ),
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            dst.handle( ),
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &region,
+            filter
+        );
+    }
+
 }
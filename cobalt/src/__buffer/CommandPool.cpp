@@ -15,7 +15,11 @@ constexpr bool ENABLE_LOGGING{ false };
 namespace cobalt
 {
     CommandPool::CommandPool( VkContext const& context, VkCommandPoolCreateFlags const pool_type )
-        : context_ref_{ context }
+        : CommandPool{ context.device( ), pool_type } { }
+
+
+    CommandPool::CommandPool( DeviceSet const& device, VkCommandPoolCreateFlags const pool_type )
+        : device_ref_{ device }
         , pool_type_{ pool_type }
     {
         // There are two possible flags for command pools:
@@ -26,11 +30,11 @@ namespace cobalt
         VkCommandPoolCreateInfo const pool_create_info{
             .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
             .flags = pool_type_,
-            .queueFamilyIndex = context_ref_.device( ).graphics_queue( ).queue_family_index( )
+            .queueFamilyIndex = device_ref_.graphics_queue( ).queue_family_index( )
         };
 
         validation::throw_on_bad_result(
-            vkCreateCommandPool( context_ref_.device( ).logical( ), &pool_create_info, nullptr, &command_pool_ ),
+            vkCreateCommandPool( device_ref_.logical( ), &pool_create_info, nullptr, &command_pool_ ),
             "Failed to create command pool!" );
     }
 
@@ -41,7 +45,7 @@ namespace cobalt
         buffer_pool_.clear( );
 
         // 2. Destroy the command pool
-        vkDestroyCommandPool( context_ref_.device( ).logical( ), command_pool_, nullptr );
+        vkDestroyCommandPool( device_ref_.logical( ), command_pool_, nullptr );
     }
 
 
@@ -66,7 +70,7 @@ namespace cobalt
         }
 
         return *buffer_pool_.emplace_back( new CommandBuffer{
-            *this, context_ref_.device( ), level, buffer_pool_.size( )
+            *this, device_ref_, level, buffer_pool_.size( )
         } );
     }
 
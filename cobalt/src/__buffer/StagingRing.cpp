@@ -0,0 +1,159 @@
+#include <__buffer/StagingRing.h>
+
+#include <log.h>
+#include <__context/DeviceSet.h>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace cobalt
+{
+    StagingRing::StagingRing( DeviceSet const& device, VkDeviceSize const capacity )
+        : buffer_{
+            device, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        }
+        , capacity_{ capacity }
+    {
+        // Mapped for the whole lifetime of the ring, writing staging data is a plain memcpy.
+        buffer_.map_memory( );
+    }
+
+
+    StagingRing::~StagingRing( ) noexcept
+    {
+        log::logerr<StagingRing>( "~StagingRing", "staging regions still in flight on destruction!",
+                                  not in_flight_.empty( ) );
+    }
+
+
+    Buffer const& StagingRing::buffer( ) const
+    {
+        return buffer_;
+    }
+
+
+    VkDeviceSize StagingRing::capacity( ) const
+    {
+        return capacity_;
+    }
+
+
+    std::optional<StagingRegion> StagingRing::allocate( VkDeviceSize const size, VkDeviceSize const alignment )
+    {
+        std::lock_guard const lock{ mutex_ };
+        return allocate_locked( size, alignment );
+    }
+
+
+    void StagingRing::release( StagingRegion const& region )
+    {
+        std::lock_guard const lock{ mutex_ };
+        release_locked( region );
+    }
+
+
+    std::optional<StagingRegion> StagingRing::allocate_for_frame( uint32_t const frame_index, VkDeviceSize const size,
+                                                                  VkDeviceSize const alignment )
+    {
+        std::lock_guard const lock{ mutex_ };
+
+        std::optional<StagingRegion> region = allocate_locked( size, alignment );
+        if ( region )
+        {
+            if ( frame_index >= frame_regions_.size( ) )
+            {
+                frame_regions_.resize( frame_index + 1u );
+            }
+            frame_regions_[frame_index].push_back( *region );
+        }
+        return region;
+    }
+
+
+    void StagingRing::retire_frame( uint32_t const frame_index )
+    {
+        std::lock_guard const lock{ mutex_ };
+
+        if ( frame_index >= frame_regions_.size( ) )
+        {
+            return;
+        }
+        for ( StagingRegion const& region : frame_regions_[frame_index] )
+        {
+            release_locked( region );
+        }
+        frame_regions_[frame_index].clear( );
+    }
+
+
+    std::optional<StagingRegion> StagingRing::allocate_locked( VkDeviceSize const size, VkDeviceSize const alignment )
+    {
+        if ( size == 0u || size > capacity_ )
+        {
+            return std::nullopt;
+        }
+
+        // 1. Nothing in flight, start over from the front so the next regions do not straddle the end.
+        if ( in_flight_.empty( ) )
+        {
+            head_ = tail_ = 0u;
+        }
+
+        // 2. Place the region after the head. When the live regions have not wrapped yet, the space left at the end of the
+        // ring is tried first and the one before the tail second.
+        VkDeviceSize const aligned_head = ( head_ + alignment - 1u ) / alignment * alignment;
+        std::optional<VkDeviceSize> begin{};
+        if ( in_flight_.empty( ) || head_ > tail_ )
+        {
+            if ( aligned_head + size <= capacity_ )
+            {
+                begin = aligned_head;
+            }
+            else if ( size <= tail_ )
+            {
+                begin = 0u;
+            }
+        }
+        else if ( aligned_head + size <= tail_ )
+        {
+            begin = aligned_head;
+        }
+
+        if ( not begin )
+        {
+            return std::nullopt;
+        }
+
+        // 3. Track it until it is released.
+        head_ = *begin + size;
+        in_flight_.push_back( InFlightSpan{ .begin = *begin, .end = head_ } );
+
+        return StagingRegion{
+            .buffer_ptr = &buffer_,
+            .offset = *begin,
+            .size = size,
+            .data_ptr = static_cast<std::byte*>( buffer_.data( ) ) + *begin,
+            .sequence = front_sequence_ + in_flight_.size( ) - 1u
+        };
+    }
+
+
+    void StagingRing::release_locked( StagingRegion const& region )
+    {
+        assert( region.buffer_ptr == &buffer_ && region.sequence >= front_sequence_ &&
+            region.sequence - front_sequence_ < in_flight_.size( ) && "StagingRing::release: region is not in flight!" );
+
+        in_flight_[region.sequence - front_sequence_].released = true;
+
+        // Space is reclaimed in order, up to the oldest region still in use.
+        while ( not in_flight_.empty( ) && in_flight_.front( ).released )
+        {
+            in_flight_.pop_front( );
+            ++front_sequence_;
+        }
+        tail_ = in_flight_.empty( ) ? head_ : in_flight_.front( ).begin;
+    }
+
+}
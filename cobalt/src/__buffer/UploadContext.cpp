@@ -0,0 +1,251 @@
+#include <__buffer/UploadContext.h>
+
+#include <log.h>
+#include <__buffer/CommandBuffer.h>
+#include <__buffer/CommandPool.h>
+#include <__context/DeviceSet.h>
+#include <__image/Image.h>
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+
+namespace cobalt
+{
+    // +---------------------------+
+    // | UPLOAD TICKET             |
+    // +---------------------------+
+    UploadTicket::UploadTicket( CommandBuffer const& cmd_buffer, std::unique_ptr<sync::Fence> fence, StagingRing& staging_ring,
+                                std::vector<StagingRegion>&& staging_regions, std::vector<Buffer>&& staging_buffers )
+        : cmd_buffer_ptr_{ &cmd_buffer }
+        , fence_ptr_{ std::move( fence ) }
+        , staging_ring_ptr_{ &staging_ring }
+        , staging_regions_{ std::move( staging_regions ) }
+        , staging_buffers_{ std::move( staging_buffers ) } { }
+
+
+    UploadTicket::~UploadTicket( ) noexcept
+    {
+        wait( );
+    }
+
+
+    UploadTicket::UploadTicket( UploadTicket&& other ) noexcept
+        : cmd_buffer_ptr_{ std::exchange( other.cmd_buffer_ptr_, nullptr ) }
+        , fence_ptr_{ std::move( other.fence_ptr_ ) }
+        , staging_ring_ptr_{ std::exchange( other.staging_ring_ptr_, nullptr ) }
+        , staging_regions_{ std::move( other.staging_regions_ ) }
+        , staging_buffers_{ std::move( other.staging_buffers_ ) } { }
+
+
+    UploadTicket& UploadTicket::operator=( UploadTicket&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            wait( );
+            cmd_buffer_ptr_  = std::exchange( other.cmd_buffer_ptr_, nullptr );
+            fence_ptr_        = std::move( other.fence_ptr_ );
+            staging_ring_ptr_ = std::exchange( other.staging_ring_ptr_, nullptr );
+            staging_regions_  = std::move( other.staging_regions_ );
+            staging_buffers_  = std::move( other.staging_buffers_ );
+        }
+        return *this;
+    }
+
+
+    bool UploadTicket::ready( )
+    {
+        if ( fence_ptr_ && fence_ptr_->signaled( ) )
+        {
+            release( );
+        }
+        return fence_ptr_ == nullptr;
+    }
+
+
+    void UploadTicket::wait( )
+    {
+        if ( fence_ptr_ )
+        {
+            fence_ptr_->wait( );
+            release( );
+        }
+    }
+
+
+    void UploadTicket::release( ) noexcept
+    {
+        // The GPU is done with the batch, so the staging memory and the command buffer can be handed back.
+        for ( StagingRegion const& region : staging_regions_ )
+        {
+            staging_ring_ptr_->release( region );
+        }
+        staging_regions_.clear( );
+        staging_buffers_.clear( );
+        fence_ptr_.reset( );
+        if ( cmd_buffer_ptr_ )
+        {
+            cmd_buffer_ptr_->unlock( );
+            cmd_buffer_ptr_ = nullptr;
+        }
+    }
+
+
+    // +---------------------------+
+    // | UPLOAD CONTEXT            |
+    // +---------------------------+
+    UploadContext::UploadContext( DeviceSet const& device, CommandPool& cmd_pool )
+        : device_ref_{ device }
+        , cmd_buffer_ref_{ cmd_pool.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY ) }
+    {
+        cmd_buffer_ref_.reset( 0 );
+        cmd_operator_.emplace( cmd_buffer_ref_.command_operator( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT ) );
+    }
+
+
+    UploadContext::~UploadContext( ) noexcept
+    {
+        if ( not submitted_ )
+        {
+            // Nothing recorded so far has reached the queue, the commands and the staging memory can simply be dropped.
+            cmd_operator_.reset( );
+            cmd_buffer_ref_.unlock( );
+            for ( StagingRegion const& region : staging_regions_ )
+            {
+                device_ref_.staging_ring( ).release( region );
+            }
+        }
+    }
+
+
+    DeviceSet const& UploadContext::device( ) const
+    {
+        return device_ref_;
+    }
+
+
+    CommandOperator const& UploadContext::command_operator( ) const
+    {
+        assert( cmd_operator_.has_value( ) && "UploadContext::command_operator: batch has already been submitted." );
+        return *cmd_operator_;
+    }
+
+
+    void UploadContext::upload( Buffer const& dst, void const* const data, VkDeviceSize const size )
+    {
+        StagingRegion const staged = stage( data, size );
+        cmd_operator_->copy_buffer( *staged.buffer_ptr, dst, VkBufferCopy{
+                                        .srcOffset = staged.offset,
+                                        .dstOffset = 0,
+                                        .size = size
+                                    } );
+    }
+
+
+    void UploadContext::upload( Image& dst, void const* const data, VkDeviceSize const size )
+    {
+        StagingRegion const staged = stage( data, size );
+
+        dst.transition_layout( { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL }, *cmd_operator_ );
+        cmd_operator_->copy_buffer_to_image(
+            *staged.buffer_ptr, dst, VkBufferImageCopy{
+                .bufferOffset = staged.offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = 0,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+
+                .imageOffset = { 0, 0, 0 },
+                .imageExtent = { dst.extent( ).width, dst.extent( ).height, 1 }
+            } );
+
+        // Only level 0 comes from the host, the rest of the chain is downsampled from it in the same batch.
+        if ( dst.mip_levels( ) > 1u )
+        {
+            dst.generate_mipmaps( *cmd_operator_ );
+        }
+        else
+        {
+            dst.transition_layout( { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }, *cmd_operator_ );
+        }
+    }
+
+
+    void UploadContext::upload( Image& dst, void const* const data, VkDeviceSize const size,
+                                std::span<VkBufferImageCopy const> const regions )
+    {
+        StagingRegion const staged = stage( data, size );
+
+        // The regions are relative to the staged data, which sits somewhere inside the ring.
+        std::vector<VkBufferImageCopy> staged_regions{ regions.begin( ), regions.end( ) };
+        for ( VkBufferImageCopy& region : staged_regions )
+        {
+            region.bufferOffset += staged.offset;
+        }
+
+        dst.transition_layout( { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL }, *cmd_operator_ );
+        cmd_operator_->copy_buffer_to_image( *staged.buffer_ptr, dst, staged_regions );
+        dst.transition_layout( { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }, *cmd_operator_ );
+    }
+
+
+    UploadTicket UploadContext::submit( )
+    {
+        assert( not submitted_ && "UploadContext::submit: batch has already been submitted." );
+
+        // Buffer copies have no layout transition to carry their visibility, so a single global barrier makes every
+        // transfer write of the batch available to the stages that consume vertex, index and storage data.
+        VkMemoryBarrier2 const barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT |
+                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT
+        };
+        cmd_operator_->insert_barrier( VkDependencyInfo{
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &barrier
+        } );
+        cmd_operator_.reset( );
+
+        auto fence = std::make_unique<sync::Fence>( device_ref_ );
+        device_ref_.graphics_queue( ).submit( sync::SubmitInfo{ device_ref_.device_index( ) }.execute( cmd_buffer_ref_ ),
+                                              fence.get( ) );
+        submitted_ = true;
+
+        return UploadTicket{
+            cmd_buffer_ref_, std::move( fence ), device_ref_.staging_ring( ), std::move( staging_regions_ ),
+            std::move( staging_buffers_ )
+        };
+    }
+
+
+    StagingRegion UploadContext::stage( void const* const data, VkDeviceSize const size )
+    {
+        assert( cmd_operator_.has_value( ) && "UploadContext::stage: batch has already been submitted." );
+
+        // 1. The ring is already mapped, staging is a single copy.
+        if ( std::optional<StagingRegion> const region = device_ref_.staging_ring( ).allocate( size ) )
+        {
+            std::memcpy( region->data_ptr, data, size );
+            staging_regions_.push_back( *region );
+            return *region;
+        }
+
+        // 2. Too large for the ring, or the ring is filled up by batches still in flight.
+        Buffer& staging_buffer = staging_buffers_.emplace_back( buffer::make_staging_buffer( device_ref_, size ) );
+        staging_buffer.map_memory( );
+        staging_buffer.write( data, size );
+        staging_buffer.unmap_memory( );
+        return StagingRegion{ .buffer_ptr = &staging_buffer, .offset = 0u, .size = size };
+    }
+
+}
@@ -1,26 +1,77 @@
 #include <__cleanup/DeletionQueue.h>
 
+#include <cassert>
+
+
 namespace cobalt::cleanup
 {
-    void DeletionQueue::push( std::function<void( )>&& deleter )
+    uint64_t DeletionQueue::current_frame( ) const
+    {
+        return current_frame_;
+    }
+
+
+    void DeletionQueue::advance( uint64_t const frame )
+    {
+        assert( frame >= current_frame_ && "DeletionQueue::advance: frames must not go back!" );
+        current_frame_ = frame;
+    }
+
+
+    void DeletionQueue::push( Deleter const& deleter )
     {
-        deleters_.push( std::move( deleter ) );
+        assert( deleter.fn != nullptr && "DeletionQueue::push: deleter has no function!" );
+        entries_.push_back( Entry{ .frame = current_frame_, .deleter = deleter } );
+    }
+
+
+    void DeletionQueue::collect( uint64_t const completed_frame )
+    {
+        size_t count{ 0u };
+        while ( head_ + count < entries_.size( ) && entries_[head_ + count].frame <= completed_frame )
+        {
+            ++count;
+        }
+        run_front( count );
     }
 
 
     void DeletionQueue::flush( )
     {
-        while ( !deleters_.empty( ) )
+        while ( not is_flushed( ) )
         {
-            deleters_.top( )( );
-            deleters_.pop( );
+            run_front( entries_.size( ) - head_ );
         }
     }
 
 
     bool DeletionQueue::is_flushed( ) const
     {
-        return deleters_.empty( );
+        return head_ == entries_.size( );
+    }
+
+
+    void DeletionQueue::run_front( size_t const count )
+    {
+        // 1. Deleters may push new entries (e.g. a resource releasing the handles it holds), index instead of iterating.
+        size_t const end = head_ + count;
+        for ( ; head_ < end; ++head_ )
+        {
+            Deleter const deleter = entries_[head_].deleter;
+            deleter.fn( deleter.context, deleter.payload );
+        }
+
+        // 2. Drop what has run, once it is the larger half to keep this amortized O(1).
+        if ( head_ == entries_.size( ) )
+        {
+            entries_.clear( );
+            head_ = 0u;
+        }
+        else if ( head_ > entries_.size( ) / 2u )
+        {
+            entries_.erase( entries_.begin( ), entries_.begin( ) + static_cast<std::ptrdiff_t>( head_ ) );
+            head_ = 0u;
+        }
     }
 
 }
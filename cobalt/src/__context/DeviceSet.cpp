@@ -1,32 +1,42 @@
 #include <__context/DeviceSet.h>
 
 #include <log.h>
+#include <__buffer/StagingRing.h>
 #include <__context/InstanceBundle.h>
+#include <__context/queue_lock.h>
 #include <__context/ValidationLayers.h>
 #include <__query/queue_family.h>
 #include <__validation/result.h>
 #include <__validation/selector/PhysicalDeviceSelector.h>
 
 #include <set>
+#include <stdexcept>
 
 
 namespace cobalt
 {
+    // Enough for the level 0 of a 4K RGBA8 texture, larger payloads get a staging buffer of their own.
+    static constexpr VkDeviceSize STAGING_RING_CAPACITY{ 64ull << 20u };
+
+
     // +---------------------------+
     // | DEVICE SET                |
     // +---------------------------+
     DeviceSet::DeviceSet( InstanceBundle const& instance, DeviceFeatureFlags const features,
-                          ValidationLayers const* validation_layers )
+                          OptionalDeviceFeatures const optional_features, ValidationLayers const* validation_layers )
         : instance_ref_{ instance }
         , feature_flags_{ features | DeviceFeatureFlags::FAMILIES_INDICES_SUITABLE }
     {
-        pick_physical_device( );
+        pick_physical_device( optional_features.flags );
         create_logical_device( validation_layers );
     }
 
 
     DeviceSet::~DeviceSet( )
     {
+        // The memory blocks are owned by the device, release them before it goes.
+        staging_ring_ptr_.reset( );
+        allocator_ptr_.reset( );
         vkDestroyDevice( device_, nullptr );
     }
 
@@ -55,6 +65,18 @@ namespace cobalt
     }
 
 
+    memory::DeviceAllocator& DeviceSet::allocator( ) const
+    {
+        return *allocator_ptr_;
+    }
+
+
+    StagingRing& DeviceSet::staging_ring( ) const
+    {
+        return *staging_ring_ptr_;
+    }
+
+
     bool DeviceSet::has_feature( DeviceFeatureFlags const feature ) const
     {
         return any( feature_flags_ & feature );
@@ -69,6 +91,8 @@ namespace cobalt
 
     void DeviceSet::wait_idle( ) const
     {
+        // Background threads may be submitting, the wait needs every queue to itself.
+        std::lock_guard const lock{ sync::queue_mutex( ) };
         vkDeviceWaitIdle( device_ );
     }
 
@@ -89,7 +113,7 @@ namespace cobalt
     }
 
 
-    void DeviceSet::pick_physical_device( )
+    void DeviceSet::pick_physical_device( DeviceFeatureFlags const optional_features )
     {
         // The physical device gets implicitly destroyed when we destroy the instance.
         uint32_t device_count{ 0u };
@@ -105,8 +129,8 @@ namespace cobalt
         vkEnumeratePhysicalDevices( instance_ref_.instance( ), &device_count, devices.data( ) );
 
         // check if any of the physical devices meet the requirements
-        for ( validation::PhysicalDeviceSelector const selector{ instance_ref_, feature_flags_ };
-              VkPhysicalDevice const device : devices )
+        validation::PhysicalDeviceSelector const selector{ instance_ref_, feature_flags_ };
+        for ( VkPhysicalDevice const device : devices )
         {
             if ( selector.select( device ) )
             {
@@ -116,11 +140,14 @@ namespace cobalt
             }
         }
 
-        // if we didn't find a suitable physical device, we log an error.
+        // without a suitable physical device there is nothing to create the logical device on.
         if ( physical_device_ == VK_NULL_HANDLE )
         {
-            log::logerr<DeviceSet>( "pick_physical_device", "failed to find a suitable GPU!" );
+            throw std::runtime_error( "failed to find a suitable GPU!" );
         }
+
+        // optional features are enabled along with the required ones when the device supports them.
+        feature_flags_ = feature_flags_ | selector.supported( physical_device_, optional_features );
     }
 
 
@@ -196,6 +223,10 @@ namespace cobalt
         // Now we can create the queues by extraction
         graphics_queue_ptr_ = std::make_unique<Queue>( *this, graphics_family.value( ), 0 );
         present_queue_ptr_  = std::make_unique<Queue>( *this, present_family.value( ), 0 );
+
+        // Buffers and images are sub-allocated from here on.
+        allocator_ptr_    = std::make_unique<memory::DeviceAllocator>( device_, physical_device_ );
+        staging_ring_ptr_ = std::make_unique<StagingRing>( *this, STAGING_RING_CAPACITY );
     }
 
 }
@@ -6,6 +6,8 @@
 #include <__validation/dispatch.h>
 #include <__validation/result.h>
 
+#include <array>
+
 
 namespace cobalt
 {
@@ -84,6 +86,19 @@ namespace cobalt
             validation->populate_messanger_debug_info( debug_create_info );
             validation->populate_create_info( create_info );
         }
+
+        // Synchronization validation has to be enabled when the layer is loaded, together with the instance.
+        constexpr std::array enabled_validation_features{ VK_VALIDATION_FEATURE_ENABLE_SYNCHRONIZATION_VALIDATION_EXT };
+        VkValidationFeaturesEXT const validation_features{
+            .sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT,
+            .enabledValidationFeatureCount = static_cast<uint32_t>( enabled_validation_features.size( ) ),
+            .pEnabledValidationFeatures = enabled_validation_features.data( )
+        };
+        if ( require_validation && any( validation->flags( ) & ValidationFlags::SYNCHRONIZATION_VALIDATION ) )
+        {
+            debug_create_info.pNext = &validation_features;
+        }
+
         validation::throw_on_bad_result( vkCreateInstance( &create_info, nullptr, &instance_ ),
                                          "Failed to create Vulkan instance!" );
     }
@@ -1,12 +1,20 @@
 #include <__context/Queue.h>
 
 #include <__context/DeviceSet.h>
+#include <__context/queue_lock.h>
 #include <__synchronization/Fence.h>
 #include <__validation/result.h>
 
 
 namespace cobalt
 {
+    std::mutex& sync::queue_mutex( )
+    {
+        static std::mutex mutex{};
+        return mutex;
+    }
+
+
     Queue::Queue( DeviceSet const& device, uint32_t const queue_family_index, uint32_t const queue_index )
         : queue_family_index_{ queue_family_index }
         , queue_index_{ queue_index }
@@ -29,6 +37,7 @@ namespace cobalt
 
     void Queue::submit( sync::SubmitInfo const& submit_info, sync::Fence const* fence ) const
     {
+        std::lock_guard const lock{ sync::queue_mutex( ) };
         validation::throw_on_bad_result(
             vkQueueSubmit2( queue_, 1, &submit_info.info( ), fence ? fence->handle( ) : VK_NULL_HANDLE ),
             "failed to submit queue!" );
@@ -37,6 +46,7 @@ namespace cobalt
 
     void Queue::submit( VkSubmitInfo const& submit_info, sync::Fence const* fence ) const
     {
+        std::lock_guard const lock{ sync::queue_mutex( ) };
         validation::throw_on_bad_result(
             vkQueueSubmit( queue_, 1, &submit_info, fence ? fence->handle( ) : VK_NULL_HANDLE ),
             "failed to submit queue!" );
@@ -45,6 +55,7 @@ namespace cobalt
 
     void Queue::wait_idle( ) const
     {
+        std::lock_guard const lock{ sync::queue_mutex( ) };
         vkQueueWaitIdle( queue_ );
     }
 
@@ -65,6 +76,7 @@ namespace cobalt
 
     VkResult Queue::present( sync::PresentInfo const& present_info ) const
     {
+        std::lock_guard const lock{ sync::queue_mutex( ) };
         return vkQueuePresentKHR( queue_, &present_info.info( ) );
     }
 
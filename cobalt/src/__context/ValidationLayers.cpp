@@ -15,7 +15,8 @@ namespace cobalt
     std::vector<char const*> flags_to_layers( ValidationFlags const flags )
     {
         std::vector<char const*> layers{};
-        if ( any( flags & ValidationFlags::KHRONOS_VALIDATION ) )
+        // Synchronization validation is a feature of the Khronos layer.
+        if ( any( flags & ( ValidationFlags::KHRONOS_VALIDATION | ValidationFlags::SYNCHRONIZATION_VALIDATION ) ) )
         {
             layers.emplace_back( "VK_LAYER_KHRONOS_validation" );
         }
@@ -31,7 +31,11 @@ namespace cobalt
         }
 
         // 3. Create the device set
-        create_device( wizard.has<DeviceFeatureFlags>( ) ? wizard.feat<DeviceFeatureFlags>( ) : DeviceFeatureFlags::NONE );
+        DeviceFeatureFlags const features =
+                wizard.has<DeviceFeatureFlags>( ) ? wizard.feat<DeviceFeatureFlags>( ) : DeviceFeatureFlags::NONE;
+        OptionalDeviceFeatures const optional_features =
+                wizard.has<OptionalDeviceFeatures>( ) ? wizard.feat<OptionalDeviceFeatures>( ) : OptionalDeviceFeatures{};
+        create_device( features, optional_features );
     }
 
 
@@ -64,9 +68,9 @@ namespace cobalt
     }
 
 
-    void VkContext::create_device( DeviceFeatureFlags features )
+    void VkContext::create_device( DeviceFeatureFlags features, OptionalDeviceFeatures const optional_features )
     {
-        device_set_ptr_ = std::make_unique<DeviceSet>( instance( ), features );
+        device_set_ptr_ = std::make_unique<DeviceSet>( instance( ), features, optional_features );
     }
 
 }
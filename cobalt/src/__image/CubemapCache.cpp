@@ -0,0 +1,233 @@
+#include <__image/CubemapCache.h>
+
+#include <log.h>
+#include <__buffer/Buffer.h>
+#include <__buffer/CommandBuffer.h>
+#include <__buffer/CommandPool.h>
+#include <__buffer/UploadContext.h>
+#include <__context/DeviceSet.h>
+#include <__io/MappedFile.h>
+#include <__synchronization/SubmitInfo.h>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+
+namespace cobalt::image
+{
+    // +---------------------------+
+    // | BLOB LAYOUT               |
+    // +---------------------------+
+    // [header][face 0]...[face 5], every face tightly packed with the same extent and format.
+    static constexpr std::array<char, 4> CUBEMAP_CACHE_MAGIC{ 'C', 'B', 'C', 'M' };
+    static constexpr uint32_t CUBEMAP_CACHE_VERSION{ 1u };
+    static constexpr uint32_t CUBEMAP_FACE_COUNT{ 6u };
+
+
+    struct CubemapCacheHeader
+    {
+        std::array<char, 4> magic{};
+        uint32_t version{};
+        uint64_t key{};
+
+        uint32_t width{};
+        uint32_t height{};
+        uint32_t format{};
+        uint32_t face_count{};
+        uint64_t face_size{};
+    };
+
+
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    [[nodiscard]] static uint32_t texel_size( VkFormat const format )
+    {
+        switch ( format )
+        {
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                return 16u;
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+                return 8u;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+                return 4u;
+            default:
+                return 0u;
+        }
+    }
+
+
+    [[nodiscard]] static std::array<VkBufferImageCopy, CUBEMAP_FACE_COUNT> face_regions( VkExtent2D const extent,
+                                                                                         VkDeviceSize const face_size )
+    {
+        std::array<VkBufferImageCopy, CUBEMAP_FACE_COUNT> regions{};
+        for ( uint32_t face{}; face < CUBEMAP_FACE_COUNT; ++face )
+        {
+            regions[face] = VkBufferImageCopy{
+                .bufferOffset = face * face_size,
+                .bufferRowLength = 0u,
+                .bufferImageHeight = 0u,
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = 0u,
+                    .baseArrayLayer = face,
+                    .layerCount = 1u,
+                },
+                .imageOffset = { 0, 0, 0 },
+                .imageExtent = { extent.width, extent.height, 1u }
+            };
+        }
+        return regions;
+    }
+
+
+    // +---------------------------+
+    // | CUBEMAP CACHE             |
+    // +---------------------------+
+    std::optional<Image> load_cubemap( DeviceSet const& device, CommandPool& cmd_pool, std::filesystem::path const& path,
+                                       uint64_t const key, VkImageUsageFlags const usage )
+    {
+        io::MappedFile const blob{ path };
+        if ( not blob.is_open( ) || blob.size( ) < sizeof( CubemapCacheHeader ) )
+        {
+            return std::nullopt;
+        }
+
+        // 1. Validate the blob against the key and the layout it claims.
+        CubemapCacheHeader header{};
+        std::memcpy( &header, blob.data( ), sizeof( CubemapCacheHeader ) );
+
+        auto const format = static_cast<VkFormat>( header.format );
+        if ( header.magic != CUBEMAP_CACHE_MAGIC || header.version != CUBEMAP_CACHE_VERSION || header.key != key ||
+             header.face_count != CUBEMAP_FACE_COUNT || texel_size( format ) == 0u ||
+             header.face_size != static_cast<uint64_t>( header.width ) * header.height * texel_size( format ) ||
+             blob.size( ) != sizeof( CubemapCacheHeader ) + header.face_size * CUBEMAP_FACE_COUNT )
+        {
+            log::loginfo<Image>( "load_cubemap", std::format( "discarding stale cubemap cache: {}", path.string( ) ) );
+            return std::nullopt;
+        }
+
+        // 2. Upload every face straight from the mapping.
+        VkExtent2D const extent{ header.width, header.height };
+        Image cubemap{
+            device,
+            ImageCreateInfo{
+                .extent = extent,
+                .format = format,
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                .properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                .create_flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+                .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
+                .layers = CUBEMAP_FACE_COUNT,
+                .view_type = VK_IMAGE_VIEW_TYPE_CUBE,
+            }
+        };
+
+        auto const regions = face_regions( extent, header.face_size );
+        UploadContext upload_context{ device, cmd_pool };
+        upload_context.upload( cubemap, blob.data( ) + sizeof( CubemapCacheHeader ), header.face_size * CUBEMAP_FACE_COUNT,
+                               regions );
+        upload_context.submit( ).wait( );
+
+        return cubemap;
+    }
+
+
+    void store_cubemap( DeviceSet const& device, CommandPool& cmd_pool, Image& cubemap, std::filesystem::path const& path,
+                        uint64_t const key )
+    {
+        assert( cubemap.layers( ) == CUBEMAP_FACE_COUNT && "image::store_cubemap: Image is not a cubemap!" );
+
+        uint32_t const texel_bytes = texel_size( cubemap.format( ) );
+        if ( texel_bytes == 0u )
+        {
+            log::logerr<Image>( "store_cubemap", "unsupported cubemap format, the cache is not written" );
+            return;
+        }
+
+        VkExtent2D const extent = cubemap.extent( );
+        VkDeviceSize const face_size = static_cast<VkDeviceSize>( extent.width ) * extent.height * texel_bytes;
+        Buffer readback_buffer = buffer::make_readback_buffer( device, face_size * CUBEMAP_FACE_COUNT );
+
+        // 1. Copy the faces into host visible memory.
+        {
+            auto const& cmd_buffer = cmd_pool.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+            cmd_buffer.reset( 0 );
+
+            CommandOperator command_op = cmd_buffer.command_operator( 0 );
+
+            // SHADER READONLY OPTIMAL -> TRANSFER SRC OPTIMAL
+            cubemap.transition_layout(
+                ImageLayoutTransition{ VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL }
+                .from_stage( VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT )
+                .to_stage( VK_PIPELINE_STAGE_2_TRANSFER_BIT )
+                .from_access( VK_ACCESS_2_SHADER_SAMPLED_READ_BIT )
+                .to_access( VK_ACCESS_2_TRANSFER_READ_BIT ), command_op );
+
+            auto const regions = face_regions( extent, face_size );
+            command_op.copy_image_to_buffer( cubemap, readback_buffer, regions );
+
+            // TRANSFER SRC OPTIMAL -> SHADER READONLY OPTIMAL
+            cubemap.transition_layout( { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }, command_op );
+
+            VkMemoryBarrier2 const host_barrier{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+                .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT
+            };
+            command_op.insert_barrier( VkDependencyInfo{
+                .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                .memoryBarrierCount = 1,
+                .pMemoryBarriers = &host_barrier
+            } );
+            command_op.end_recording( );
+
+            device.graphics_queue( ).submit_and_wait( sync::SubmitInfo{ device.device_index( ) }.execute( cmd_buffer ) );
+            cmd_buffer.unlock( );
+        }
+
+        // 2. Lay the blob out in memory.
+        CubemapCacheHeader const header{
+            .magic = CUBEMAP_CACHE_MAGIC,
+            .version = CUBEMAP_CACHE_VERSION,
+            .key = key,
+            .width = extent.width,
+            .height = extent.height,
+            .format = static_cast<uint32_t>( cubemap.format( ) ),
+            .face_count = CUBEMAP_FACE_COUNT,
+            .face_size = face_size,
+        };
+
+        std::vector<std::byte> blob( sizeof( CubemapCacheHeader ) + face_size * CUBEMAP_FACE_COUNT );
+        std::memcpy( blob.data( ), &header, sizeof( CubemapCacheHeader ) );
+        readback_buffer.map_memory( );
+        readback_buffer.read( blob.data( ) + sizeof( CubemapCacheHeader ), face_size * CUBEMAP_FACE_COUNT );
+        readback_buffer.unmap_memory( );
+
+        // 3. Write to a temporary file first, a crash mid-write must never leave a truncated cache behind.
+        std::filesystem::path const temp_path{ path.string( ) + ".tmp" };
+        {
+            std::ofstream file{ temp_path, std::ios::binary | std::ios::trunc };
+            file.write( reinterpret_cast<char const*>( blob.data( ) ), static_cast<std::streamsize>( blob.size( ) ) );
+            if ( not file )
+            {
+                log::logerr<Image>( "store_cubemap", std::format( "failed to write: {}", temp_path.string( ) ) );
+                return;
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename( temp_path, path, error );
+        log::logerr<Image>( "store_cubemap", std::format( "failed to replace: {}", path.string( ) ),
+                            static_cast<bool>( error ) );
+    }
+
+}
@@ -6,10 +6,13 @@
 #include <__context/DeviceSet.h>
 #include <__image/ImageLayoutTransition.h>
 #include <__meta/expect_size.h>
-#include <__query/device_queries.h>
 #include <__validation/dispatch.h>
 #include <__validation/result.h>
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
 
 namespace cobalt
 {
@@ -18,13 +21,17 @@ namespace cobalt
         , format_{ create_info.format }
         , extent_{ create_info.extent }
         , layers_{ create_info.layers }
+        , mip_levels_{ create_info.mip_levels }
+        , layouts_{ mip_levels_ }
     {
         init_image( create_info );
         init_view( ImageViewCreateInfo{
             .image = image_,
             .format = create_info.format,
             .aspect_flags = create_info.aspect_flags,
+            .mip_levels = mip_levels_,
             .view_type = create_info.view_type,
+            .components = create_info.components,
         } );
     }
 
@@ -34,6 +41,8 @@ namespace cobalt
         , format_{ create_info.format }
         , extent_{ extent }
         , layers_{ 1 }
+        , mip_levels_{ create_info.mip_levels }
+        , layouts_{ mip_levels_ }
         , image_{ create_info.image }
     {
         log::logerr<Image>( "Image", "image cannot be VK_NULL_HANDLE!", create_info.image == VK_NULL_HANDLE );
@@ -47,12 +56,12 @@ namespace cobalt
         view_ptr_.reset( );
 
         // 2. Destroy the image and free its memory (if explicitly created)
-        if ( image_ != VK_NULL_HANDLE && image_memory_ != VK_NULL_HANDLE )
+        if ( image_ != VK_NULL_HANDLE && allocation_.valid( ) )
         {
-            vkFreeMemory( device_ref_.logical( ), image_memory_, nullptr );
             vkDestroyImage( device_ref_.logical( ), image_, nullptr );
-            image_memory_ = VK_NULL_HANDLE;
-            image_        = VK_NULL_HANDLE;
+            device_ref_.allocator( ).free( allocation_ );
+            allocation_ = {};
+            image_      = VK_NULL_HANDLE;
         }
     }
 
@@ -62,13 +71,15 @@ namespace cobalt
         , format_{ other.format_ }
         , extent_{ other.extent_ }
         , layers_{ other.layers_ }
+        , mip_levels_{ other.mip_levels_ }
+        , layouts_{ std::move( other.layouts_ ) }
         , image_{ other.image_ }
-        , image_memory_{ other.image_memory_ }
+        , allocation_{ other.allocation_ }
         , view_ptr_{ std::move( other.view_ptr_ ) }
     {
-        meta::expect_size<Image, 64u>( );
-        other.image_        = VK_NULL_HANDLE;
-        other.image_memory_ = VK_NULL_HANDLE;
+        meta::expect_size<Image, 112u>( );
+        other.image_      = VK_NULL_HANDLE;
+        other.allocation_ = {};
     }
 
 
@@ -96,6 +107,24 @@ namespace cobalt
     }
 
 
+    uint32_t Image::mip_levels( ) const
+    {
+        return mip_levels_;
+    }
+
+
+    uint32_t Image::layers( ) const
+    {
+        return layers_;
+    }
+
+
+    VkImageLayout Image::layout( uint32_t const mip_level ) const
+    {
+        return layouts_.layout( mip_level );
+    }
+
+
     void Image::transition_layout( ImageLayoutTransition const& transition, CommandPool& cmd_pool )
     {
         auto const& cmd_buffer = cmd_pool.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
@@ -112,44 +141,92 @@ namespace cobalt
     }
 
 
-    void Image::transition_layout( ImageLayoutTransition transition, CommandOperator const& cmd_operator )
+    void Image::transition_layout( ImageLayoutTransition const& transition, CommandOperator const& cmd_operator,
+                                   uint32_t const base_mip_level, uint32_t const mip_level_count )
     {
-        if ( transition.to_layout == layout_ )
+        // Every run of levels sharing the same old layout gets its own barrier.
+        std::vector<VkImageMemoryBarrier2> barriers{};
+        for ( LayoutRun const& run : layouts_.transition( base_mip_level, mip_level_count, transition.to_layout ) )
         {
-            return;
+            ImageLayoutTransition run_transition{ transition };
+            run_transition.transition_from( run.old_layout );
+
+            barriers.push_back( VkImageMemoryBarrier2{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                .srcStageMask = run_transition.src_stage_mask,
+                .srcAccessMask = run_transition.src_access_mask,
+                .dstStageMask = run_transition.dst_stage_mask,
+                .dstAccessMask = run_transition.dst_access_mask,
+                .oldLayout = run.old_layout,
+                .newLayout = run_transition.to_layout,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image_,
+                .subresourceRange = {
+                    .aspectMask = view( ).aspect_flags( ),
+                    .baseMipLevel = run.base_mip_level,
+                    .levelCount = run.level_count,
+                    .baseArrayLayer = 0,
+                    .layerCount = layers_,
+                },
+            } );
         }
 
-        transition.transition_from( layout_ );
-
-        VkImageMemoryBarrier2 const barrier{
-            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
-            .srcStageMask = transition.src_stage_mask,
-            .srcAccessMask = transition.src_access_mask,
-            .dstStageMask = transition.dst_stage_mask,
-            .dstAccessMask = transition.dst_access_mask,
-            .oldLayout = layout_,
-            .newLayout = transition.to_layout,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .image = image_,
-            .subresourceRange = {
-                .aspectMask = view( ).aspect_flags( ),
-                .baseMipLevel = 0,
-                .levelCount = 1,
-                .baseArrayLayer = 0,
-                .layerCount = layers_,
-            },
-        };
-        layout_ = transition.to_layout;
+        if ( barriers.empty( ) )
+        {
+            return;
+        }
 
         cmd_operator.insert_barrier( VkDependencyInfo{
             .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-            .imageMemoryBarrierCount = 1,
-            .pImageMemoryBarriers = &barrier
+            .imageMemoryBarrierCount = static_cast<uint32_t>( barriers.size( ) ),
+            .pImageMemoryBarriers = barriers.data( )
         } );
     }
 
 
+    void Image::generate_mipmaps( CommandOperator const& cmd_operator )
+    {
+        VkImageAspectFlags const aspect_flags = view( ).aspect_flags( );
+        for ( uint32_t level{ 1u }; level < mip_levels_; ++level )
+        {
+            // 1. The previous level becomes the blit source, the current one receives the downsampled texels.
+            transition_layout( ImageLayoutTransition{ VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL }, cmd_operator, level - 1u, 1u );
+            transition_layout( ImageLayoutTransition{ VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL }, cmd_operator, level, 1u );
+
+            VkExtent2D const src_extent = image::calculate_mip_extent( extent_, level - 1u );
+            VkExtent2D const dst_extent = image::calculate_mip_extent( extent_, level );
+
+            VkImageBlit const blit{
+                .srcSubresource = {
+                    .aspectMask = aspect_flags,
+                    .mipLevel = level - 1u,
+                    .baseArrayLayer = 0,
+                    .layerCount = layers_
+                },
+                .srcOffsets = {
+                    { 0, 0, 0 },
+                    { static_cast<int32_t>( src_extent.width ), static_cast<int32_t>( src_extent.height ), 1 }
+                },
+                .dstSubresource = {
+                    .aspectMask = aspect_flags,
+                    .mipLevel = level,
+                    .baseArrayLayer = 0,
+                    .layerCount = layers_
+                },
+                .dstOffsets = {
+                    { 0, 0, 0 },
+                    { static_cast<int32_t>( dst_extent.width ), static_cast<int32_t>( dst_extent.height ), 1 }
+                },
+            };
+            cmd_operator.blit_image( *this, *this, blit, VK_FILTER_LINEAR );
+        }
+
+        // 2. Every level but the last one was left as a blit source.
+        transition_layout( ImageLayoutTransition{ VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }, cmd_operator );
+    }
+
+
     void Image::init_image( ImageCreateInfo const& create_info )
     {
         // Create texture image
@@ -159,7 +236,7 @@ namespace cobalt
         image_info.extent.width  = create_info.extent.width;
         image_info.extent.height = create_info.extent.height;
         image_info.extent.depth  = 1;
-        image_info.mipLevels     = 1;
+        image_info.mipLevels     = mip_levels_;
         image_info.arrayLayers   = layers_;
 
         // Tell vulkan what kind of texels we are going to use
@@ -186,17 +263,15 @@ namespace cobalt
         VkMemoryRequirements mem_requirements;
         vkGetImageMemoryRequirements( device_ref_.logical( ), image_, &mem_requirements );
 
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = query::find_memory_type(
-            device_ref_.physical( ), mem_requirements.memoryTypeBits, create_info.properties );
-
-        validation::throw_on_bad_result(
-            vkAllocateMemory( device_ref_.logical( ), &alloc_info, nullptr, &image_memory_ ),
-            "failed to allocate image memory!" );
+        // Optimally tiled images are kept in blocks of their own, away from buffers and linear images, so neighbours never
+        // share a bufferImageGranularity page.
+        allocation_ = device_ref_.allocator( ).allocate( memory::AllocationRequest{
+            .requirements = mem_requirements,
+            .properties = create_info.properties,
+            .linear_resource = create_info.tiling == VK_IMAGE_TILING_LINEAR,
+        } );
 
-        vkBindImageMemory( device_ref_.logical( ), image_, image_memory_, 0 );
+        vkBindImageMemory( device_ref_.logical( ), image_, allocation_.memory, allocation_.offset );
     }
 
 
@@ -208,4 +283,19 @@ namespace cobalt
         }
     }
 
+
+    namespace image
+    {
+        uint32_t calculate_mip_levels( VkExtent2D const extent )
+        {
+            return static_cast<uint32_t>( std::bit_width( std::max( extent.width, extent.height ) ) );
+        }
+
+
+        VkExtent2D calculate_mip_extent( VkExtent2D const extent, uint32_t const mip_level )
+        {
+            return VkExtent2D{ std::max( extent.width >> mip_level, 1u ), std::max( extent.height >> mip_level, 1u ) };
+        }
+    }
+
 }
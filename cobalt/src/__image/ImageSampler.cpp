@@ -26,7 +26,7 @@ namespace cobalt
             .addressModeV = create_info.address_mode,
             .addressModeW = create_info.address_mode,
 
-            .mipLodBias = 0.f,
+            .mipLodBias = create_info.mip_lod_bias,
 
             .anisotropyEnable = device_ref_.has_feature( DeviceFeatureFlags::ANISOTROPIC_SAMPLING ),
             .maxAnisotropy = properties.properties.limits.maxSamplerAnisotropy,
@@ -34,9 +34,9 @@ namespace cobalt
             .compareEnable = create_info.compare_enable,
             .compareOp = create_info.compare_op,
 
-            .minLod = 0.f,
-            .maxLod = 0.f,
-            
+            .minLod = create_info.min_lod,
+            .maxLod = create_info.max_lod,
+
             .borderColor = create_info.border_color,
 
             .unnormalizedCoordinates = create_info.unnormalized_coordinates,
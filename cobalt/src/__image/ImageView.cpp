@@ -35,15 +35,12 @@ namespace cobalt
         image_view_info.format   = create_info.format;
 
         // The components field allows you to swizzle the color channels around.
-        image_view_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-        image_view_info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-        image_view_info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-        image_view_info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+        image_view_info.components = create_info.components;
 
         // The subresourceRange field describes what the image's purpose is and which part of the image should be accessed.
         image_view_info.subresourceRange.aspectMask     = create_info.aspect_flags;
         image_view_info.subresourceRange.baseMipLevel   = 0;
-        image_view_info.subresourceRange.levelCount     = 1;
+        image_view_info.subresourceRange.levelCount     = create_info.mip_levels;
         image_view_info.subresourceRange.baseArrayLayer = create_info.base_layer;
         image_view_info.subresourceRange.layerCount     = create_info.view_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6u : 1u;
 
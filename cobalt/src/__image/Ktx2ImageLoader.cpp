@@ -0,0 +1,187 @@
+#include <log.h>
+#include <__image/Ktx2ImageLoader.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+
+
+namespace cobalt
+{
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    [[nodiscard]] static VkComponentSwizzle to_component_swizzle( char const channel )
+    {
+        switch ( channel )
+        {
+            case 'r':
+                return VK_COMPONENT_SWIZZLE_R;
+            case 'g':
+                return VK_COMPONENT_SWIZZLE_G;
+            case 'b':
+                return VK_COMPONENT_SWIZZLE_B;
+            case 'a':
+                return VK_COMPONENT_SWIZZLE_A;
+            case '0':
+                return VK_COMPONENT_SWIZZLE_ZERO;
+            case '1':
+                return VK_COMPONENT_SWIZZLE_ONE;
+            default:
+                return VK_COMPONENT_SWIZZLE_IDENTITY;
+        }
+    }
+
+
+    // +---------------------------+
+    // | KTX2 IMAGE LOADER         |
+    // +---------------------------+
+    Ktx2ImageLoader::Ktx2ImageLoader( std::filesystem::path const& path )
+        : file_{ path }
+    {
+        valid_ = file_.is_open( ) && parse( );
+        log::logerr<Ktx2ImageLoader>( "Ktx2ImageLoader", std::format( "failed to load KTX2 image: {}", path.string( ) ),
+                                      not valid_ );
+    }
+
+
+    bool Ktx2ImageLoader::is_valid( ) const noexcept
+    {
+        return valid_;
+    }
+
+
+    VkFormat Ktx2ImageLoader::format( ) const noexcept
+    {
+        return static_cast<VkFormat>( header_.vk_format );
+    }
+
+
+    VkComponentMapping Ktx2ImageLoader::swizzle( ) const noexcept
+    {
+        return swizzle_;
+    }
+
+
+    uint32_t Ktx2ImageLoader::img_width( ) const noexcept
+    {
+        return header_.pixel_width;
+    }
+
+
+    uint32_t Ktx2ImageLoader::img_height( ) const noexcept
+    {
+        return header_.pixel_height;
+    }
+
+
+    uint32_t Ktx2ImageLoader::mip_levels( ) const noexcept
+    {
+        return static_cast<uint32_t>( levels_.size( ) );
+    }
+
+
+    std::span<std::byte const> Ktx2ImageLoader::level_data( ) const noexcept
+    {
+        return file_.bytes( ).subspan( data_begin_, data_end_ - data_begin_ );
+    }
+
+
+    uint64_t Ktx2ImageLoader::level_offset( uint32_t const level ) const
+    {
+        assert( level < levels_.size( ) && "Ktx2ImageLoader::level_offset: level out of range!" );
+        return levels_[level].byte_offset - data_begin_;
+    }
+
+
+    uint64_t Ktx2ImageLoader::level_size( uint32_t const level ) const
+    {
+        assert( level < levels_.size( ) && "Ktx2ImageLoader::level_size: level out of range!" );
+        return levels_[level].byte_length;
+    }
+
+
+    bool Ktx2ImageLoader::parse( )
+    {
+        auto const file_size = static_cast<uint64_t>( file_.size( ) );
+        if ( file_size < sizeof( image::Ktx2Header ) )
+        {
+            return false;
+        }
+        std::memcpy( &header_, file_.data( ), sizeof( image::Ktx2Header ) );
+
+        // 1. Only plain 2D textures are produced by the baker, anything else is rejected rather than half-supported.
+        if ( header_.identifier != image::KTX2_IDENTIFIER || header_.vk_format == VK_FORMAT_UNDEFINED ||
+             header_.supercompression_scheme != 0u || header_.pixel_width == 0u || header_.pixel_height == 0u ||
+             header_.pixel_depth != 0u || header_.layer_count > 1u || header_.face_count != 1u || header_.level_count == 0u )
+        {
+            return false;
+        }
+
+        // 2. Read the level index and the contiguous range the payloads span.
+        uint64_t const index_size = header_.level_count * sizeof( image::Ktx2LevelIndex );
+        if ( sizeof( image::Ktx2Header ) + index_size > file_size )
+        {
+            return false;
+        }
+        levels_.resize( header_.level_count );
+        std::memcpy( levels_.data( ), file_.data( ) + sizeof( image::Ktx2Header ), index_size );
+
+        data_begin_ = UINT64_MAX;
+        data_end_   = 0u;
+        for ( auto const& [byte_offset, byte_length, uncompressed_byte_length] : levels_ )
+        {
+            if ( byte_length == 0u || byte_offset > file_size || byte_length > file_size - byte_offset )
+            {
+                return false;
+            }
+            data_begin_ = std::min( data_begin_, byte_offset );
+            data_end_   = std::max( data_end_, byte_offset + byte_length );
+        }
+
+        parse_key_values( );
+        return true;
+    }
+
+
+    void Ktx2ImageLoader::parse_key_values( )
+    {
+        uint64_t const kvd_end = static_cast<uint64_t>( header_.kvd_byte_offset ) + header_.kvd_byte_length;
+        if ( header_.kvd_byte_length == 0u || kvd_end > file_.size( ) )
+        {
+            return;
+        }
+
+        // Entries are [length][key\0value\0] padded to 4 bytes, only the swizzle is relevant for sampling.
+        uint64_t offset = header_.kvd_byte_offset;
+        while ( offset + sizeof( uint32_t ) <= kvd_end )
+        {
+            uint32_t entry_length{};
+            std::memcpy( &entry_length, file_.data( ) + offset, sizeof( uint32_t ) );
+            offset += sizeof( uint32_t );
+            if ( offset + entry_length > kvd_end )
+            {
+                return;
+            }
+
+            std::string_view const entry{ reinterpret_cast<char const*>( file_.data( ) + offset ), entry_length };
+            if ( size_t const separator = entry.find( '\0' ); separator != std::string_view::npos &&
+                                                              entry.substr( 0u, separator ) == "KTXswizzle" )
+            {
+                std::string_view const value = entry.substr( separator + 1u );
+                if ( value.size( ) >= 4u )
+                {
+                    swizzle_ = VkComponentMapping{
+                        .r = to_component_swizzle( value[0] ),
+                        .g = to_component_swizzle( value[1] ),
+                        .b = to_component_swizzle( value[2] ),
+                        .a = to_component_swizzle( value[3] ),
+                    };
+                }
+            }
+            offset += ( entry_length + 3u ) & ~3u;
+        }
+    }
+
+}
@@ -0,0 +1,172 @@
+#include <__image/SphericalHarmonics.h>
+
+#include <__image/StbImageLoader.h>
+#include <__thread/WorkerPool.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+
+namespace cobalt::image
+{
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    // Rows reduced per task, enough work to amortize the task overhead while keeping every worker busy on a 4K image.
+    static constexpr uint32_t SH9_ROWS_PER_BAND{ 16u };
+
+    // Real SH basis constants, bands 0 to 2.
+    static constexpr float SH_Y00{ .282095f };
+    static constexpr float SH_Y1{ .488603f };
+    static constexpr float SH_Y2{ 1.092548f };
+    static constexpr float SH_Y20{ .315392f };
+    static constexpr float SH_Y22{ .546274f };
+
+    // Cosine lobe convolution per band (PI, 2PI/3, PI/4), divided by PI for the lambertian BRDF.
+    static constexpr std::array<float, SH9_COEFFICIENT_COUNT> SH_IRRADIANCE_SCALE{
+        1.f, 2.f / 3.f, 2.f / 3.f, 2.f / 3.f, .25f, .25f, .25f, .25f, .25f
+    };
+
+
+    using sh9_sums_t = std::array<double, SH9_COEFFICIENT_COUNT * 3u>;
+
+
+    [[nodiscard]] static std::array<float, SH9_COEFFICIENT_COUNT> sh9_basis( glm::vec3 const& d )
+    {
+        return {
+            SH_Y00,
+            SH_Y1 * d.y,
+            SH_Y1 * d.z,
+            SH_Y1 * d.x,
+            SH_Y2 * d.x * d.y,
+            SH_Y2 * d.y * d.z,
+            SH_Y20 * ( 3.f * d.z * d.z - 1.f ),
+            SH_Y2 * d.x * d.z,
+            SH_Y22 * ( d.x * d.x - d.y * d.y ),
+        };
+    }
+
+
+    // +---------------------------+
+    // | SPHERICAL HARMONICS       |
+    // +---------------------------+
+    SH9Irradiance project_irradiance_sh9( std::span<float const> const rgba, uint32_t const width, uint32_t const height,
+                                          uint32_t const thread_count )
+    {
+        assert( rgba.size( ) >= static_cast<size_t>( width ) * height * 4u && "project_irradiance_sh9: not enough texels!" );
+
+        // 1. The azimuth only depends on the column, its sines and cosines are shared by every row.
+        std::vector<float> cos_azimuth( width );
+        std::vector<float> sin_azimuth( width );
+        for ( uint32_t x{}; x < width; ++x )
+        {
+            float const azimuth = ( ( static_cast<float>( x ) + .5f ) / static_cast<float>( width ) - .5f ) * 2.f *
+                                  std::numbers::pi_v<float>;
+            cos_azimuth[x] = std::cos( azimuth );
+            sin_azimuth[x] = std::sin( azimuth );
+        }
+
+        // 2. Reduce bands of rows independently. Every band writes its own partial sums, which are added up in order
+        // afterwards so the result does not depend on the scheduling.
+        uint32_t const band_count = ( height + SH9_ROWS_PER_BAND - 1u ) / SH9_ROWS_PER_BAND;
+        std::vector<sh9_sums_t> band_sums( band_count );
+
+        float const texel_solid_angle = 2.f * std::numbers::pi_v<float> / static_cast<float>( width ) *
+                                        std::numbers::pi_v<float> / static_cast<float>( height );
+
+        thread::WorkerPool workers{ thread_count };
+        workers.parallel_for( band_count, [&]( size_t const band )
+            {
+                sh9_sums_t& sums = band_sums[band];
+                uint32_t const row_begin = static_cast<uint32_t>( band ) * SH9_ROWS_PER_BAND;
+                uint32_t const row_end   = std::min( row_begin + SH9_ROWS_PER_BAND, height );
+
+                for ( uint32_t y{ row_begin }; y < row_end; ++y )
+                {
+                    float const elevation = ( ( static_cast<float>( y ) + .5f ) / static_cast<float>( height ) - .5f ) *
+                                            std::numbers::pi_v<float>;
+                    float const cos_elevation = std::cos( elevation );
+                    float const sin_elevation = std::sin( elevation );
+
+                    // Texels shrink towards the poles, weight them by the solid angle they cover.
+                    float const weight = texel_solid_angle * cos_elevation;
+
+                    // Accumulate the row in floats, the flat loop over contiguous texels is left to the compiler to vectorize.
+                    std::array<float, SH9_COEFFICIENT_COUNT * 3u> row_sums{};
+                    float const* texel = rgba.data( ) + static_cast<size_t>( y ) * width * 4u;
+                    for ( uint32_t x{}; x < width; ++x, texel += 4u )
+                    {
+                        glm::vec3 const direction{
+                            cos_elevation * cos_azimuth[x], sin_elevation, cos_elevation * sin_azimuth[x]
+                        };
+                        std::array<float, SH9_COEFFICIENT_COUNT> const basis = sh9_basis( direction );
+                        for ( uint32_t i{}; i < SH9_COEFFICIENT_COUNT; ++i )
+                        {
+                            row_sums[i * 3u + 0u] += texel[0] * basis[i];
+                            row_sums[i * 3u + 1u] += texel[1] * basis[i];
+                            row_sums[i * 3u + 2u] += texel[2] * basis[i];
+                        }
+                    }
+
+                    for ( size_t i{}; i < row_sums.size( ); ++i )
+                    {
+                        sums[i] += static_cast<double>( row_sums[i] ) * weight;
+                    }
+                }
+            } );
+
+        // 3. Add the bands up and fold in the convolution.
+        sh9_sums_t total{};
+        for ( sh9_sums_t const& sums : band_sums )
+        {
+            for ( size_t i{}; i < total.size( ); ++i )
+            {
+                total[i] += sums[i];
+            }
+        }
+
+        SH9Irradiance irradiance{};
+        for ( uint32_t i{}; i < SH9_COEFFICIENT_COUNT; ++i )
+        {
+            irradiance.coefficients[i] = glm::vec4{
+                static_cast<float>( total[i * 3u + 0u] ),
+                static_cast<float>( total[i * 3u + 1u] ),
+                static_cast<float>( total[i * 3u + 2u] ),
+                0.f
+            } * SH_IRRADIANCE_SCALE[i];
+        }
+        return irradiance;
+    }
+
+
+    SH9Irradiance project_irradiance_sh9( std::filesystem::path const& equirect_path, uint32_t const thread_count )
+    {
+        // The loader reports a failed decode itself, a black environment is all that is left to return.
+        StbImageLoader const image{ equirect_path, 4u, true };
+        if ( image.pixels( ) == nullptr )
+        {
+            return {};
+        }
+
+        size_t const texel_count = static_cast<size_t>( image.img_width( ) ) * image.img_height( );
+        return project_irradiance_sh9( std::span{ static_cast<float const*>( image.pixels( ) ), texel_count * 4u },
+                                       image.img_width( ), image.img_height( ), thread_count );
+    }
+
+
+    glm::vec3 evaluate_irradiance_sh9( SH9Irradiance const& irradiance, glm::vec3 const& direction )
+    {
+        std::array<float, SH9_COEFFICIENT_COUNT> const basis = sh9_basis( direction );
+
+        glm::vec3 result{ 0.f };
+        for ( uint32_t i{}; i < SH9_COEFFICIENT_COUNT; ++i )
+        {
+            result += glm::vec3{ irradiance.coefficients[i] } * basis[i];
+        }
+        return glm::max( result, glm::vec3{ 0.f } );
+    }
+
+}
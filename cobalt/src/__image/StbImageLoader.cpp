@@ -1,6 +1,10 @@
 #include <log.h>
 #include <__image/StbImageLoader.h>
 
+#include <__io/MappedFile.h>
+
+#include <climits>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
@@ -115,23 +119,31 @@ namespace cobalt
 
     void StbImageLoader::load_image( std::filesystem::path const& path, uint32_t const desired_channels )
     {
-        load_image_impl( reinterpret_cast<load_fn_t>( stbi_load ), path, desired_channels );
+        load_image_impl( reinterpret_cast<load_fn_t>( stbi_load_from_memory ), path, desired_channels );
         img_channel_size_ = sizeof( stbi_uc );
     }
 
 
     void StbImageLoader::load_image_float( std::filesystem::path const& path, uint32_t const desired_channels )
     {
-        load_image_impl( reinterpret_cast<load_fn_t>( stbi_loadf ), path, desired_channels );
+        load_image_impl( reinterpret_cast<load_fn_t>( stbi_loadf_from_memory ), path, desired_channels );
         img_channel_size_ = sizeof( float );
     }
 
 
     void StbImageLoader::load_image_impl( load_fn_t const fn, std::filesystem::path const& path, uint32_t const desired_channels )
     {
+        // Decode straight from the mapped file instead of letting stb read it through its own FILE* buffer.
+        io::MappedFile const file{ path };
+        if ( not file.is_open( ) || file.size( ) > static_cast<size_t>( INT_MAX ) )
+        {
+            return;
+        }
+
         int found_channels;
-        pixels_ptr_ = fn( path.string( ).c_str( ), reinterpret_cast<int*>( &img_width_ ), reinterpret_cast<int*>( &img_height_ ),
-                          &found_channels, desired_channels );
+        pixels_ptr_ = fn( reinterpret_cast<unsigned char const*>( file.data( ) ), static_cast<int>( file.size( ) ),
+                          reinterpret_cast<int*>( &img_width_ ), reinterpret_cast<int*>( &img_height_ ), &found_channels,
+                          desired_channels );
         img_channels_ = desired_channels != 0 ? desired_channels : found_channels;
     }
 
@@ -0,0 +1,60 @@
+#include <__image/SubresourceLayouts.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace cobalt
+{
+    SubresourceLayouts::SubresourceLayouts( uint32_t const mip_levels )
+        : layouts_( mip_levels, VK_IMAGE_LAYOUT_UNDEFINED ) { }
+
+
+    uint32_t SubresourceLayouts::mip_levels( ) const
+    {
+        return static_cast<uint32_t>( layouts_.size( ) );
+    }
+
+
+    VkImageLayout SubresourceLayouts::layout( uint32_t const mip_level ) const
+    {
+        assert( mip_level < layouts_.size( ) && "SubresourceLayouts::layout: mip level out of range!" );
+        return layouts_[mip_level];
+    }
+
+
+    std::vector<LayoutRun> SubresourceLayouts::transition( uint32_t const base_mip_level, uint32_t const mip_level_count,
+                                                           VkImageLayout const to_layout )
+    {
+        assert( base_mip_level < layouts_.size( ) && "SubresourceLayouts::transition: base mip level out of range!" );
+        uint32_t const end_level = mip_level_count == VK_REMAINING_MIP_LEVELS
+                                       ? mip_levels( )
+                                       : std::min( base_mip_level + mip_level_count, mip_levels( ) );
+
+        std::vector<LayoutRun> runs{};
+        for ( uint32_t level{ base_mip_level }; level < end_level; )
+        {
+            VkImageLayout const old_layout = layouts_[level];
+            uint32_t run_end{ level + 1u };
+            while ( run_end < end_level && layouts_[run_end] == old_layout )
+            {
+                ++run_end;
+            }
+
+            if ( old_layout != to_layout )
+            {
+                runs.push_back( LayoutRun{ .base_mip_level = level, .level_count = run_end - level, .old_layout = old_layout } );
+                std::fill( layouts_.begin( ) + level, layouts_.begin( ) + run_end, to_layout );
+            }
+            level = run_end;
+        }
+        return runs;
+    }
+
+
+    void SubresourceLayouts::reset( )
+    {
+        std::ranges::fill( layouts_, VK_IMAGE_LAYOUT_UNDEFINED );
+    }
+
+}
@@ -0,0 +1,361 @@
+#include <log.h>
+#include <__image/TextureBaker.h>
+
+#include <__image/block_compression.h>
+#include <__image/Ktx2ImageLoader.h>
+#include <__image/StbImageLoader.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace cobalt::image
+{
+    // +---------------------------+
+    // | FORMAT DESCRIPTION        |
+    // +---------------------------+
+    // Khronos data format descriptor values, see the KDFG specification.
+    static constexpr uint8_t KHR_DF_MODEL_BC4{ 131u };
+    static constexpr uint8_t KHR_DF_MODEL_BC5{ 132u };
+    static constexpr uint8_t KHR_DF_MODEL_BC7{ 134u };
+    static constexpr uint8_t KHR_DF_PRIMARIES_BT709{ 1u };
+    static constexpr uint8_t KHR_DF_TRANSFER_LINEAR{ 1u };
+    static constexpr uint8_t KHR_DF_TRANSFER_SRGB{ 2u };
+
+
+    struct BakeFormat
+    {
+        uint32_t block_size{};
+        uint8_t color_model{};
+        uint8_t transfer{};
+        uint32_t sample_count{};
+        std::string_view swizzle{};
+        std::string_view tag{};
+    };
+
+
+    [[nodiscard]] static bool describe_format( VkFormat const format, BakeFormat& description )
+    {
+        switch ( format )
+        {
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+                description = { 8u, KHR_DF_MODEL_BC4, KHR_DF_TRANSFER_LINEAR, 1u, "rrr1", "bc4" };
+                return true;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                description = { 16u, KHR_DF_MODEL_BC5, KHR_DF_TRANSFER_LINEAR, 2u, "", "bc5" };
+                return true;
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+                description = { 16u, KHR_DF_MODEL_BC7, KHR_DF_TRANSFER_LINEAR, 1u, "", "bc7" };
+                return true;
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                description = { 16u, KHR_DF_MODEL_BC7, KHR_DF_TRANSFER_SRGB, 1u, "", "bc7_srgb" };
+                return true;
+            default:
+                return false;
+        }
+    }
+
+
+    // +---------------------------+
+    // | TEXEL HELPERS             |
+    // +---------------------------+
+    [[nodiscard]] static float srgb_to_linear( uint8_t const value )
+    {
+        static std::array<float, 256> const table = []
+            {
+                std::array<float, 256> lut{};
+                for ( size_t i{}; i < lut.size( ); ++i )
+                {
+                    float const c = static_cast<float>( i ) / 255.f;
+                    lut[i]        = c <= 0.04045f ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+                }
+                return lut;
+            }( );
+        return table[value];
+    }
+
+
+    [[nodiscard]] static uint8_t linear_to_srgb( float const value )
+    {
+        float const c       = std::clamp( value, 0.f, 1.f );
+        float const encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow( c, 1.f / 2.4f ) - 0.055f;
+        return static_cast<uint8_t>( std::lround( encoded * 255.f ) );
+    }
+
+
+    // 2x2 box filter, odd edges repeat the last texel. Color channels of sRGB images are averaged in linear space.
+    [[nodiscard]] static std::vector<uint8_t> downsample( std::span<uint8_t const> const rgba, uint32_t const width,
+                                                          uint32_t const height, bool const srgb )
+    {
+        uint32_t const next_width  = std::max( width / 2u, 1u );
+        uint32_t const next_height = std::max( height / 2u, 1u );
+
+        std::vector<uint8_t> next( static_cast<size_t>( next_width ) * next_height * 4u );
+        for ( uint32_t y{}; y < next_height; ++y )
+        {
+            std::array<uint32_t, 2> const rows{ std::min( y * 2u, height - 1u ), std::min( y * 2u + 1u, height - 1u ) };
+            for ( uint32_t x{}; x < next_width; ++x )
+            {
+                std::array<uint32_t, 2> const cols{ std::min( x * 2u, width - 1u ), std::min( x * 2u + 1u, width - 1u ) };
+                for ( uint32_t c{}; c < 4u; ++c )
+                {
+                    bool const linearize = srgb && c < 3u;
+
+                    float sum{};
+                    for ( uint32_t const row : rows )
+                    {
+                        for ( uint32_t const col : cols )
+                        {
+                            uint8_t const texel = rgba[( static_cast<size_t>( row ) * width + col ) * 4u + c];
+                            sum += linearize ? srgb_to_linear( texel ) : static_cast<float>( texel );
+                        }
+                    }
+                    next[( static_cast<size_t>( y ) * next_width + x ) * 4u + c] =
+                            linearize ? linear_to_srgb( sum / 4.f ) : static_cast<uint8_t>( std::lround( sum / 4.f ) );
+                }
+            }
+        }
+        return next;
+    }
+
+
+    [[nodiscard]] static std::vector<std::byte> encode_level( VkFormat const format, std::span<uint8_t const> const rgba,
+                                                              uint32_t const width, uint32_t const height )
+    {
+        switch ( format )
+        {
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+                return encode_bc4( rgba, width, height, 0u );
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                return encode_bc5( rgba, width, height );
+            default:
+                return encode_bc7( rgba, width, height );
+        }
+    }
+
+
+    // +---------------------------+
+    // | KTX2 WRITER               |
+    // +---------------------------+
+    template <typename value_t>
+    static void append_value( std::vector<std::byte>& blob, value_t const& value )
+    {
+        auto const* bytes = reinterpret_cast<std::byte const*>( &value );
+        blob.insert( blob.end( ), bytes, bytes + sizeof( value_t ) );
+    }
+
+
+    [[nodiscard]] static std::vector<std::byte> make_data_format_descriptor( BakeFormat const& description )
+    {
+        // One basic descriptor block, the samples split the block bits evenly between the stored channels.
+        auto const block_size = static_cast<uint16_t>( 24u + 16u * description.sample_count );
+
+        std::vector<std::byte> dfd{};
+        append_value( dfd, static_cast<uint32_t>( sizeof( uint32_t ) + block_size ) );
+        append_value( dfd, uint32_t{ 0u } ); // vendor id, descriptor type
+        append_value( dfd, uint16_t{ 2u } ); // version
+        append_value( dfd, block_size );
+        append_value( dfd, std::array<uint8_t, 4>{
+                          description.color_model, KHR_DF_PRIMARIES_BT709, description.transfer, 0u } );
+        append_value( dfd, std::array<uint8_t, 4>{ BC_BLOCK_DIMENSION - 1u, BC_BLOCK_DIMENSION - 1u, 0u, 0u } );
+        append_value( dfd, std::array<uint8_t, 8>{ static_cast<uint8_t>( description.block_size ) } );
+
+        uint32_t const sample_bits = description.block_size * 8u / description.sample_count;
+        for ( uint32_t sample{}; sample < description.sample_count; ++sample )
+        {
+            append_value( dfd, static_cast<uint16_t>( sample * sample_bits ) );
+            append_value( dfd, static_cast<uint8_t>( sample_bits - 1u ) );
+            append_value( dfd, static_cast<uint8_t>( sample ) ); // channel id: red, then green
+            append_value( dfd, uint32_t{ 0u } );                 // sample position
+            append_value( dfd, uint32_t{ 0u } );                 // lower
+            append_value( dfd, UINT32_MAX );                     // upper
+        }
+        return dfd;
+    }
+
+
+    [[nodiscard]] static std::vector<std::byte> make_key_values( BakeFormat const& description )
+    {
+        // Keys are sorted by their byte values as the specification requires.
+        std::vector<std::pair<std::string_view, std::string_view>> entries{};
+        if ( not description.swizzle.empty( ) )
+        {
+            entries.emplace_back( "KTXswizzle", description.swizzle );
+        }
+        entries.emplace_back( "KTXwriter", "cobalt" );
+
+        std::vector<std::byte> kvd{};
+        for ( auto const& [key, value] : entries )
+        {
+            append_value( kvd, static_cast<uint32_t>( key.size( ) + value.size( ) + 2u ) );
+            for ( std::string_view const str : { key, value } )
+            {
+                auto const* bytes = reinterpret_cast<std::byte const*>( str.data( ) );
+                kvd.insert( kvd.end( ), bytes, bytes + str.size( ) );
+                kvd.push_back( std::byte{ 0 } );
+            }
+            kvd.resize( ( kvd.size( ) + 3u ) & ~size_t{ 3u } );
+        }
+        return kvd;
+    }
+
+
+    [[nodiscard]] static bool write_ktx2( std::filesystem::path const& destination, VkFormat const format,
+                                          BakeFormat const& description, uint32_t const width, uint32_t const height,
+                                          std::span<std::vector<std::byte> const> const levels )
+    {
+        std::vector<std::byte> const dfd = make_data_format_descriptor( description );
+        std::vector<std::byte> const kvd = make_key_values( description );
+
+        auto const level_count = static_cast<uint32_t>( levels.size( ) );
+        uint64_t const index_end = sizeof( Ktx2Header ) + level_count * sizeof( Ktx2LevelIndex );
+
+        Ktx2Header const header{
+            .identifier = KTX2_IDENTIFIER,
+            .vk_format = static_cast<uint32_t>( format ),
+            .type_size = 1u,
+            .pixel_width = width,
+            .pixel_height = height,
+            .pixel_depth = 0u,
+            .layer_count = 0u,
+            .face_count = 1u,
+            .level_count = level_count,
+            .supercompression_scheme = 0u,
+            .dfd_byte_offset = static_cast<uint32_t>( index_end ),
+            .dfd_byte_length = static_cast<uint32_t>( dfd.size( ) ),
+            .kvd_byte_offset = static_cast<uint32_t>( index_end + dfd.size( ) ),
+            .kvd_byte_length = static_cast<uint32_t>( kvd.size( ) ),
+        };
+
+        // 1. Lay the levels out smallest first, each one aligned to the block size.
+        std::vector<std::byte> blob( index_end );
+        blob.insert( blob.end( ), dfd.begin( ), dfd.end( ) );
+        blob.insert( blob.end( ), kvd.begin( ), kvd.end( ) );
+
+        std::vector<Ktx2LevelIndex> level_index( level_count );
+        for ( uint32_t level{ level_count }; level-- > 0u; )
+        {
+            blob.resize( ( blob.size( ) + description.block_size - 1u ) / description.block_size * description.block_size );
+            level_index[level] = {
+                .byte_offset = blob.size( ),
+                .byte_length = levels[level].size( ),
+                .uncompressed_byte_length = levels[level].size( )
+            };
+            blob.insert( blob.end( ), levels[level].begin( ), levels[level].end( ) );
+        }
+        std::memcpy( blob.data( ), &header, sizeof( Ktx2Header ) );
+        std::memcpy( blob.data( ) + sizeof( Ktx2Header ), level_index.data( ), level_count * sizeof( Ktx2LevelIndex ) );
+
+        // 2. Write to a temporary file first, a crash mid-write must never leave a truncated texture behind.
+        // The same texture can be baked by two workers at once, each one writes its own temporary file.
+        std::filesystem::path const temp_path{
+            std::format( "{}.{}.tmp", destination.string( ), std::hash<std::thread::id>{ }( std::this_thread::get_id( ) ) )
+        };
+        {
+            std::ofstream file{ temp_path, std::ios::binary | std::ios::trunc };
+            file.write( reinterpret_cast<char const*>( blob.data( ) ), static_cast<std::streamsize>( blob.size( ) ) );
+            if ( not file )
+            {
+                log::logerr( "bake_texture", std::format( "failed to write: {}", temp_path.string( ) ) );
+                return false;
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename( temp_path, destination, error );
+        log::logerr( "bake_texture", std::format( "failed to replace: {}", destination.string( ) ), static_cast<bool>( error ) );
+        return not error;
+    }
+
+
+    // +---------------------------+
+    // | BAKER                     |
+    // +---------------------------+
+    std::filesystem::path baked_texture_path( std::filesystem::path const& source, TextureBakeInfo const& bake_info )
+    {
+        BakeFormat description{};
+        bool const supported = describe_format( bake_info.format, description );
+        log::logerr( "baked_texture_path", "unsupported bake format!", not supported );
+
+        std::string tag{ description.tag };
+        if ( bake_info.format == VK_FORMAT_BC4_UNORM_BLOCK )
+        {
+            tag += "rgba"[std::min( bake_info.source_channel, 3u )];
+            tag += bake_info.linearize_source ? "_linear" : "";
+        }
+        return std::filesystem::path{ std::format( "{}.{}.ktx2", source.string( ), tag ) };
+    }
+
+
+    bool is_bake_outdated( std::filesystem::path const& source, std::filesystem::path const& baked )
+    {
+        std::error_code error{};
+        auto const baked_time = std::filesystem::last_write_time( baked, error );
+        if ( error )
+        {
+            return true;
+        }
+        auto const source_time = std::filesystem::last_write_time( source, error );
+        return error || source_time > baked_time;
+    }
+
+
+    bool bake_texture( std::filesystem::path const& source, std::filesystem::path const& destination,
+                       TextureBakeInfo const& bake_info )
+    {
+        BakeFormat description{};
+        if ( not describe_format( bake_info.format, description ) )
+        {
+            log::logerr( "bake_texture", std::format( "unsupported bake format: {}", static_cast<int>( bake_info.format ) ) );
+            return false;
+        }
+
+        StbImageLoader const loader{ source, 4u };
+        if ( not loader.pixels( ) )
+        {
+            return false;
+        }
+
+        uint32_t const width  = loader.img_width( );
+        uint32_t const height = loader.img_height( );
+        std::vector<uint8_t> texels( static_cast<uint8_t const*>( loader.pixels( ) ),
+                                     static_cast<uint8_t const*>( loader.pixels( ) ) + loader.img_size( ) );
+
+        // 1. Single channel bakes move the selected channel into red, decoded to linear if the source stores it as sRGB.
+        if ( bake_info.format == VK_FORMAT_BC4_UNORM_BLOCK )
+        {
+            uint32_t const channel = std::min( bake_info.source_channel, 3u );
+            for ( size_t i{}; i < texels.size( ); i += 4u )
+            {
+                uint8_t const value = texels[i + channel];
+                texels[i]           = bake_info.linearize_source
+                                          ? static_cast<uint8_t>( std::lround( srgb_to_linear( value ) * 255.f ) )
+                                          : value;
+            }
+        }
+
+        // 2. Encode the chain down to 1x1.
+        bool const srgb = bake_info.format == VK_FORMAT_BC7_SRGB_BLOCK;
+        std::vector<std::vector<std::byte>> levels{};
+        for ( uint32_t level_width{ width }, level_height{ height };; )
+        {
+            levels.push_back( encode_level( bake_info.format, texels, level_width, level_height ) );
+            if ( level_width == 1u && level_height == 1u )
+            {
+                break;
+            }
+            texels       = downsample( texels, level_width, level_height, srgb );
+            level_width  = std::max( level_width / 2u, 1u );
+            level_height = std::max( level_height / 2u, 1u );
+        }
+
+        return write_ktx2( destination, bake_info.format, description, width, height, levels );
+    }
+
+}
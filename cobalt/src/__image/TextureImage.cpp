@@ -1,10 +1,19 @@
 #include <__image/TextureImage.h>
 
 #include <__buffer/Buffer.h>
+#include <__buffer/UploadContext.h>
 #include <__context/DeviceSet.h>
 #include <__image/Image.h>
+#include <__image/Ktx2ImageLoader.h>
 #include <__image/StbImageLoader.h>
 #include <__meta/expect_size.h>
+#include <__query/device_queries.h>
+
+#include <log.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
 
 
 namespace cobalt
@@ -13,45 +22,148 @@ namespace cobalt
     // | TEXTURE IMAGE             |
     // +---------------------------+
     TextureImage::TextureImage( DeviceSet const& device, CommandPool& cmd_pool, TextureImageCreateInfo const& create_info )
+    {
+        UploadContext upload_context{ device, cmd_pool };
+        load_image( upload_context, create_info );
+        upload_context.submit( ).wait( );
+    }
+
+
+    TextureImage::TextureImage( UploadContext& upload_context, TextureImageCreateInfo const& create_info )
+    {
+        load_image( upload_context, create_info );
+    }
+
+
+    TextureImage::TextureImage( UploadContext& upload_context, StbImageLoader const& decoded_image, VkFormat const image_format,
+                                bool const generate_mips )
+    {
+        upload_image( upload_context, decoded_image, image_format, generate_mips );
+    }
+
+
+    TextureImage::TextureImage( UploadContext& upload_context, Ktx2ImageLoader const& baked_image, uint32_t const base_level )
+    {
+        upload_image( upload_context, baked_image, base_level );
+    }
+
+
+    TextureImage::TextureImage( TextureImage&& other ) noexcept
+        : texture_image_ptr_{ std::move( other.texture_image_ptr_ ) }
+    {
+        meta::expect_size<TextureImage, 16u>( );
+    }
+
+
+    Image const& TextureImage::image( ) const
+    {
+        return *texture_image_ptr_;
+    }
+
+
+    void TextureImage::swap( TextureImage& other ) noexcept
+    {
+        std::swap( texture_image_ptr_, other.texture_image_ptr_ );
+    }
+
+
+    void TextureImage::load_image( UploadContext& upload_context, TextureImageCreateInfo const& create_info )
     {
         StbImageLoader const loader{
             create_info.path_to_img, image::to_channel_count( create_info.image_format ),
             image::is_float_texel( create_info.image_format ),
         };
+        upload_image( upload_context, loader, create_info.image_format, create_info.generate_mips );
+    }
+
+
+    void TextureImage::upload_image( UploadContext& upload_context, StbImageLoader const& loader, VkFormat const image_format,
+                                     bool const generate_mips )
+    {
+        VkExtent2D const extent{ loader.img_width( ), loader.img_height( ) };
+
+        // The chain is built with linear blits on the GPU, formats that cannot be filtered that way keep a single level.
+        bool const blit_supported = query::supports_format_features(
+            upload_context.device( ).physical( ), image_format, VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+            VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT );
+        log::logerr<TextureImage>( "upload_image", "format does not support linear blits, skipping mip generation.",
+                                   generate_mips && not blit_supported );
+
+        uint32_t const mip_levels = generate_mips && blit_supported ? image::calculate_mip_levels( extent ) : 1u;
 
         texture_image_ptr_ = std::make_unique<Image>(
-            device,
+            upload_context.device( ),
             ImageCreateInfo{
-                .extent = { loader.img_width( ), loader.img_height( ) },
-                .format = create_info.image_format,
+                .extent = extent,
+                .format = image_format,
                 .tiling = VK_IMAGE_TILING_OPTIMAL,
-                .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 .properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mip_levels = mip_levels,
                 .view_type = VK_IMAGE_VIEW_TYPE_2D,
             } );
 
-        Buffer staging_buffer = buffer::make_staging_buffer( device, loader.img_size( ) );
-        staging_buffer.map_memory( );
-        staging_buffer.write( loader.pixels( ), staging_buffer.memory_size( ) );
-        staging_buffer.unmap_memory( );
-
-        texture_image_ptr_->transition_layout( { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL }, cmd_pool );
-        staging_buffer.copy_to( *texture_image_ptr_, cmd_pool );
-        texture_image_ptr_->transition_layout( { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }, cmd_pool );
+        // The staging copy is kept alive by the upload context until the batch has been executed.
+        upload_context.upload( *texture_image_ptr_, loader.pixels( ), loader.img_size( ) );
     }
 
 
-    TextureImage::TextureImage( TextureImage&& other ) noexcept
-        : texture_image_ptr_{ std::move( other.texture_image_ptr_ ) }
+    void TextureImage::upload_image( UploadContext& upload_context, Ktx2ImageLoader const& loader, uint32_t const base_level )
     {
-        meta::expect_size<TextureImage, 16u>( );
-    }
+        assert( base_level < loader.mip_levels( ) && "TextureImage::upload_image: base level out of range!" );
 
+        uint32_t const width = std::max( loader.img_width( ) >> base_level, 1u );
+        uint32_t const height = std::max( loader.img_height( ) >> base_level, 1u );
+        uint32_t const level_count = loader.mip_levels( ) - base_level;
 
-    Image const& TextureImage::image( ) const
-    {
-        return *texture_image_ptr_;
+        texture_image_ptr_ = std::make_unique<Image>(
+            upload_context.device( ),
+            ImageCreateInfo{
+                .extent = { width, height },
+                .format = loader.format( ),
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mip_levels = level_count,
+                .view_type = VK_IMAGE_VIEW_TYPE_2D,
+                .components = loader.swizzle( ),
+            } );
+
+        // The chain is already built, the levels are copied straight from the file. Only the range spanned by the uploaded
+        // levels is staged, skipping the finer ones.
+        uint64_t range_begin{ UINT64_MAX };
+        uint64_t range_end{ 0u };
+        for ( uint32_t level{ base_level }; level < loader.mip_levels( ); ++level )
+        {
+            range_begin = std::min( range_begin, loader.level_offset( level ) );
+            range_end   = std::max( range_end, loader.level_offset( level ) + loader.level_size( level ) );
+        }
+
+        std::vector<VkBufferImageCopy> regions( level_count );
+        for ( uint32_t level{}; level < level_count; ++level )
+        {
+            regions[level] = VkBufferImageCopy{
+                .bufferOffset = loader.level_offset( base_level + level ) - range_begin,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = level,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+
+                .imageOffset = { 0, 0, 0 },
+                .imageExtent = { std::max( width >> level, 1u ), std::max( height >> level, 1u ), 1 }
+            };
+        }
+
+        auto const level_data = loader.level_data( ).subspan( range_begin, range_end - range_begin );
+        upload_context.upload( *texture_image_ptr_, level_data.data( ), level_data.size( ), regions );
     }
 
 }
@@ -0,0 +1,227 @@
+#include <__image/TextureStreamer.h>
+
+#include <__buffer/UploadContext.h>
+#include <__context/DeviceSet.h>
+#include <__image/Ktx2ImageLoader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+
+namespace cobalt
+{
+    TextureStreamer::TextureStreamer( DeviceSet const& device, TextureStreamerCreateInfo const& create_info )
+        : device_ref_{ device }
+        , create_info_{ create_info }
+        , cmd_pool_{ device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT }
+        , stale_frames_( create_info.frames_in_flight, false )
+    {
+        worker_ = std::thread{ &TextureStreamer::run_worker, this };
+    }
+
+
+    TextureStreamer::~TextureStreamer( ) noexcept
+    {
+        {
+            std::lock_guard const lock{ mutex_ };
+            stop_ = true;
+        }
+        wake_condition_.notify_one( );
+
+        // The worker waits for its upload to complete before checking the flag, nothing is left in flight after the join.
+        worker_.join( );
+    }
+
+
+    TextureImage TextureStreamer::add( UploadContext& upload_context, uint32_t const texture_index,
+                                       std::unique_ptr<Ktx2ImageLoader> baked_image )
+    {
+        // The tail starts at the first level small enough, or at the last level for a texture that has no such level.
+        uint32_t tail_level{ 0u };
+        while ( tail_level + 1u < baked_image->mip_levels( ) &&
+                ( std::max( baked_image->img_width( ), baked_image->img_height( ) ) >> tail_level ) >
+                create_info_.resident_tail_size )
+        {
+            ++tail_level;
+        }
+
+        TextureImage texture{ upload_context, *baked_image, tail_level };
+
+        std::lock_guard const lock{ mutex_ };
+        textures_.push_back( StreamedTexture{
+            .texture_index = texture_index,
+            .image_ptr = std::move( baked_image ),
+            .tail_level = tail_level,
+            .resident_level = tail_level,
+            .wanted_level = tail_level,
+        } );
+        return texture;
+    }
+
+
+    void TextureStreamer::request( std::span<float const> const texture_areas )
+    {
+        {
+            std::lock_guard const lock{ mutex_ };
+            for ( StreamedTexture& texture : textures_ )
+            {
+                if ( texture.texture_index >= texture_areas.size( ) )
+                {
+                    continue;
+                }
+                texture.screen_area = texture_areas[texture.texture_index];
+                if ( texture.screen_area <= 0.f )
+                {
+                    continue;
+                }
+
+                // Assume the texture is stretched once over the covered area: every halving of the extent over the covered
+                // diameter is a level that would be minified anyway. Tiled textures only need coarser levels than this.
+                float const diameter = 2.f * std::sqrt( texture.screen_area / std::numbers::pi_v<float> );
+                auto const longest_side = static_cast<float>(
+                    std::max( texture.image_ptr->img_width( ), texture.image_ptr->img_height( ) ) );
+                float const level = std::floor( std::log2( std::max( longest_side / std::max( diameter, 1.f ), 1.f ) ) );
+
+                texture.wanted_level = std::min( static_cast<uint32_t>( level ), texture.tail_level );
+            }
+        }
+        wake_condition_.notify_one( );
+    }
+
+
+    bool TextureStreamer::update( std::span<TextureImage> const textures, uint32_t const frame_index )
+    {
+        ++update_count_;
+
+        // 1. Every frame that could sample a replaced image has completed by now.
+        std::erase_if( retired_, [this]( RetiredTexture const& retired ) { return retired.release_update <= update_count_; } );
+
+        // 2. Swap in the finished uploads, the previous images are retired rather than destroyed.
+        {
+            std::lock_guard const lock{ mutex_ };
+            for ( auto& [texture_index, texture_ptr] : completed_ )
+            {
+                textures[texture_index].swap( *texture_ptr );
+                retired_.push_back( RetiredTexture{
+                    .release_update = update_count_ + create_info_.frames_in_flight,
+                    .texture_ptr = std::move( texture_ptr )
+                } );
+            }
+            if ( not completed_.empty( ) )
+            {
+                std::ranges::fill( stale_frames_, true );
+            }
+            completed_.clear( );
+        }
+
+        bool const stale = stale_frames_[frame_index];
+        stale_frames_[frame_index] = false;
+        return stale;
+    }
+
+
+    VkDeviceSize TextureStreamer::resident_size( ) const
+    {
+        std::lock_guard const lock{ mutex_ };
+        return std::accumulate( textures_.begin( ), textures_.end( ), VkDeviceSize{ 0u },
+                                []( VkDeviceSize const sum, StreamedTexture const& texture )
+                                    {
+                                        return sum + chain_size( texture, texture.resident_level );
+                                    } );
+    }
+
+
+    void TextureStreamer::run_worker( )
+    {
+        while ( true )
+        {
+            std::optional<StreamedUpload> upload{};
+            Ktx2ImageLoader const* image_ptr{ nullptr };
+            uint32_t texture_index{};
+            {
+                std::unique_lock lock{ mutex_ };
+                wake_condition_.wait( lock, [this, &upload]
+                    {
+                        upload = plan_upload( );
+                        return stop_ || upload.has_value( );
+                    } );
+                if ( stop_ )
+                {
+                    return;
+                }
+
+                // The loaders are owned through pointers, they stay put while textures are being added.
+                image_ptr     = textures_[upload->streamed_index].image_ptr.get( );
+                texture_index = textures_[upload->streamed_index].texture_index;
+            }
+
+            // Record and wait on the upload outside of the lock, the render thread keeps going meanwhile.
+            UploadContext upload_context{ device_ref_, cmd_pool_ };
+            auto texture_ptr = std::make_unique<TextureImage>( upload_context, *image_ptr, upload->base_level );
+            upload_context.submit( ).wait( );
+
+            std::lock_guard const lock{ mutex_ };
+            textures_[upload->streamed_index].resident_level = upload->base_level;
+            completed_.emplace_back( texture_index, std::move( texture_ptr ) );
+        }
+    }
+
+
+    std::optional<TextureStreamer::StreamedUpload> TextureStreamer::plan_upload( ) const
+    {
+        // 1. Hand out the budget by screen area. Visible textures ask for their wanted level, the others for what they have,
+        // and everyone settles for the finest level that still fits.
+        std::vector<size_t> order( textures_.size( ) );
+        std::iota( order.begin( ), order.end( ), size_t{ 0u } );
+        std::ranges::stable_sort( order, [this]( size_t const lhs, size_t const rhs )
+            {
+                return textures_[lhs].screen_area > textures_[rhs].screen_area;
+            } );
+
+        std::vector<uint32_t> planned_levels( textures_.size( ) );
+        uint64_t budget_left = create_info_.memory_budget;
+        for ( size_t const index : order )
+        {
+            StreamedTexture const& texture = textures_[index];
+
+            uint32_t level = texture.screen_area > 0.f ? texture.wanted_level : texture.resident_level;
+            while ( level < texture.tail_level && chain_size( texture, level ) > budget_left )
+            {
+                ++level;
+            }
+            planned_levels[index] = level;
+            budget_left -= std::min( chain_size( texture, level ), budget_left );
+        }
+
+        // 2. Free memory first, starting with the least visible texture, then grow the most visible one.
+        for ( auto it = order.rbegin( ); it != order.rend( ); ++it )
+        {
+            if ( planned_levels[*it] > textures_[*it].resident_level )
+            {
+                return StreamedUpload{ *it, planned_levels[*it] };
+            }
+        }
+        for ( size_t const index : order )
+        {
+            if ( planned_levels[index] < textures_[index].resident_level )
+            {
+                return StreamedUpload{ index, planned_levels[index] };
+            }
+        }
+        return std::nullopt;
+    }
+
+
+    uint64_t TextureStreamer::chain_size( StreamedTexture const& texture, uint32_t const base_level )
+    {
+        uint64_t size{ 0u };
+        for ( uint32_t level{ base_level }; level < texture.image_ptr->mip_levels( ); ++level )
+        {
+            size += texture.image_ptr->level_size( level );
+        }
+        return size;
+    }
+
+}
@@ -0,0 +1,351 @@
+#include <__image/block_compression.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+
+namespace cobalt::image
+{
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    using block_texels_t = std::array<std::array<uint8_t, 4>, 16>;
+
+
+    [[nodiscard]] static block_texels_t fetch_block( std::span<uint8_t const> const rgba, uint32_t const width,
+                                                     uint32_t const height, uint32_t const block_x, uint32_t const block_y )
+    {
+        block_texels_t texels{};
+        for ( uint32_t y{}; y < BC_BLOCK_DIMENSION; ++y )
+        {
+            uint32_t const src_y = std::min( block_y * BC_BLOCK_DIMENSION + y, height - 1u );
+            for ( uint32_t x{}; x < BC_BLOCK_DIMENSION; ++x )
+            {
+                uint32_t const src_x = std::min( block_x * BC_BLOCK_DIMENSION + x, width - 1u );
+                std::memcpy( texels[y * BC_BLOCK_DIMENSION + x].data( ), &rgba[( src_y * width + src_x ) * 4u], 4u );
+            }
+        }
+        return texels;
+    }
+
+
+    template <size_t block_size_v, typename encode_fn_t>
+    [[nodiscard]] static std::vector<std::byte> encode_blocks( std::span<uint8_t const> const rgba, uint32_t const width,
+                                                               uint32_t const height, encode_fn_t&& encode_fn )
+    {
+        assert( rgba.size( ) >= static_cast<size_t>( width ) * height * 4u && "encode_blocks: not enough texels!" );
+
+        uint32_t const blocks_x = block_count( width );
+        uint32_t const blocks_y = block_count( height );
+
+        std::vector<std::byte> blocks( static_cast<size_t>( blocks_x ) * blocks_y * block_size_v );
+        for ( uint32_t by{}; by < blocks_y; ++by )
+        {
+            for ( uint32_t bx{}; bx < blocks_x; ++bx )
+            {
+                std::array<uint8_t, block_size_v> const block = encode_fn( fetch_block( rgba, width, height, bx, by ) );
+                std::memcpy( &blocks[( static_cast<size_t>( by ) * blocks_x + bx ) * block_size_v], block.data( ), block_size_v );
+            }
+        }
+        return blocks;
+    }
+
+
+    // Writes values LSB first, the bit order every BC format is specified in.
+    class BlockBitWriter final
+    {
+    public:
+        void write( uint32_t const value, uint32_t const bit_count )
+        {
+            for ( uint32_t i{}; i < bit_count; ++i, ++cursor_ )
+            {
+                if ( ( value >> i ) & 1u )
+                {
+                    bits_[cursor_ / 8u] |= static_cast<uint8_t>( 1u << ( cursor_ % 8u ) );
+                }
+            }
+        }
+
+
+        [[nodiscard]] std::array<uint8_t, 16> const& bits( ) const
+        {
+            assert( cursor_ == 128u && "BlockBitWriter::bits: block is not complete!" );
+            return bits_;
+        }
+
+    private:
+        std::array<uint8_t, 16> bits_{};
+        uint32_t cursor_{ 0u };
+
+    };
+
+
+    // +---------------------------+
+    // | BC4                       |
+    // +---------------------------+
+    [[nodiscard]] static std::array<uint8_t, 8> encode_bc4_block( block_texels_t const& texels, uint32_t const channel )
+    {
+        uint8_t low{ 255u };
+        uint8_t high{ 0u };
+        for ( auto const& texel : texels )
+        {
+            low  = std::min( low, texel[channel] );
+            high = std::max( high, texel[channel] );
+        }
+
+        // red_0 > red_1 selects the eight value palette, equal endpoints leave every index pointing at red_0.
+        std::array<uint8_t, 8> block{ high, low };
+        if ( high == low )
+        {
+            return block;
+        }
+
+        std::array<int32_t, 8> palette{ high, low };
+        for ( int32_t i{ 2 }; i < 8; ++i )
+        {
+            palette[i] = ( ( 8 - i ) * high + ( i - 1 ) * low + 3 ) / 7;
+        }
+
+        uint64_t indices{};
+        for ( uint32_t texel{}; texel < 16u; ++texel )
+        {
+            int32_t const value = texels[texel][channel];
+
+            uint64_t best_index{};
+            int32_t best_error{ INT32_MAX };
+            for ( uint64_t i{}; i < 8u; ++i )
+            {
+                if ( int32_t const error = std::abs( palette[i] - value ); error < best_error )
+                {
+                    best_error = error;
+                    best_index = i;
+                }
+            }
+            indices |= best_index << ( 3u * texel );
+        }
+
+        for ( uint32_t i{}; i < 6u; ++i )
+        {
+            block[2u + i] = static_cast<uint8_t>( indices >> ( 8u * i ) );
+        }
+        return block;
+    }
+
+
+    std::vector<std::byte> encode_bc4( std::span<uint8_t const> const rgba, uint32_t const width, uint32_t const height,
+                                       uint32_t const channel )
+    {
+        assert( channel < 4u && "encode_bc4: channel out of range!" );
+        return encode_blocks<8u>( rgba, width, height, [channel]( block_texels_t const& texels )
+            {
+                return encode_bc4_block( texels, channel );
+            } );
+    }
+
+
+    // +---------------------------+
+    // | BC5                       |
+    // +---------------------------+
+    std::vector<std::byte> encode_bc5( std::span<uint8_t const> const rgba, uint32_t const width, uint32_t const height )
+    {
+        return encode_blocks<16u>( rgba, width, height, []( block_texels_t const& texels )
+            {
+                std::array<uint8_t, 16> block{};
+                std::ranges::copy( encode_bc4_block( texels, 0u ), block.begin( ) );
+                std::ranges::copy( encode_bc4_block( texels, 1u ), block.begin( ) + 8 );
+                return block;
+            } );
+    }
+
+
+    // +---------------------------+
+    // | BC7                       |
+    // +---------------------------+
+    // Mode 6: one subset, RGBA endpoints of 7 bits plus a unique p-bit each, 4-bit indices. It is the cheapest mode to search
+    // and handles alpha without a second block, which is enough for albedo maps.
+    static constexpr std::array<int32_t, 16> BC7_WEIGHTS_4{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+    struct Bc7Endpoints
+    {
+        std::array<uint8_t, 4> low{};
+        std::array<uint8_t, 4> high{};
+        uint32_t low_pbit{};
+        uint32_t high_pbit{};
+    };
+
+
+    [[nodiscard]] static std::array<float, 4> principal_axis( block_texels_t const& texels, std::array<float, 4> const& mean )
+    {
+        std::array<std::array<float, 4>, 4> covariance{};
+        for ( auto const& texel : texels )
+        {
+            for ( uint32_t row{}; row < 4u; ++row )
+            {
+                for ( uint32_t col{}; col < 4u; ++col )
+                {
+                    covariance[row][col] += ( texel[row] - mean[row] ) * ( texel[col] - mean[col] );
+                }
+            }
+        }
+
+        // A handful of power iterations settle on the dominant eigenvector for a 4x4 block.
+        std::array<float, 4> axis{ 1.f, 1.f, 1.f, 1.f };
+        for ( uint32_t iteration{}; iteration < 8u; ++iteration )
+        {
+            std::array<float, 4> next{};
+            for ( uint32_t row{}; row < 4u; ++row )
+            {
+                for ( uint32_t col{}; col < 4u; ++col )
+                {
+                    next[row] += covariance[row][col] * axis[col];
+                }
+            }
+
+            float const length = std::sqrt( next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3] );
+            if ( length < 1e-6f )
+            {
+                break;
+            }
+            for ( uint32_t c{}; c < 4u; ++c )
+            {
+                axis[c] = next[c] / length;
+            }
+        }
+        return axis;
+    }
+
+
+    [[nodiscard]] static uint8_t quantize_endpoint( float const value, uint32_t const pbit )
+    {
+        float const quantized = std::round( ( value - static_cast<float>( pbit ) ) / 2.f );
+        return static_cast<uint8_t>( std::clamp( quantized, 0.f, 127.f ) );
+    }
+
+
+    [[nodiscard]] static uint64_t fit_bc7_indices( block_texels_t const& texels, Bc7Endpoints const& endpoints,
+                                                   std::array<uint8_t, 16>& indices )
+    {
+        std::array<std::array<int32_t, 4>, 16> palette{};
+        for ( uint32_t i{}; i < 16u; ++i )
+        {
+            for ( uint32_t c{}; c < 4u; ++c )
+            {
+                int32_t const low  = ( endpoints.low[c] << 1 ) | static_cast<int32_t>( endpoints.low_pbit );
+                int32_t const high = ( endpoints.high[c] << 1 ) | static_cast<int32_t>( endpoints.high_pbit );
+                palette[i][c]      = ( ( 64 - BC7_WEIGHTS_4[i] ) * low + BC7_WEIGHTS_4[i] * high + 32 ) >> 6;
+            }
+        }
+
+        uint64_t total_error{};
+        for ( uint32_t texel{}; texel < 16u; ++texel )
+        {
+            uint32_t best_error{ UINT32_MAX };
+            for ( uint8_t i{}; i < 16u; ++i )
+            {
+                uint32_t error{};
+                for ( uint32_t c{}; c < 4u; ++c )
+                {
+                    int32_t const delta = palette[i][c] - texels[texel][c];
+                    error += static_cast<uint32_t>( delta * delta );
+                }
+                if ( error < best_error )
+                {
+                    best_error     = error;
+                    indices[texel] = i;
+                }
+            }
+            total_error += best_error;
+        }
+        return total_error;
+    }
+
+
+    [[nodiscard]] static std::array<uint8_t, 16> encode_bc7_block( block_texels_t const& texels )
+    {
+        // 1. Fit a line through the block colors, the endpoints are the extreme projections onto it.
+        std::array<float, 4> mean{};
+        for ( auto const& texel : texels )
+        {
+            for ( uint32_t c{}; c < 4u; ++c )
+            {
+                mean[c] += texel[c] / 16.f;
+            }
+        }
+        std::array<float, 4> const axis = principal_axis( texels, mean );
+
+        float min_projection{ std::numeric_limits<float>::max( ) };
+        float max_projection{ std::numeric_limits<float>::lowest( ) };
+        for ( auto const& texel : texels )
+        {
+            float projection{};
+            for ( uint32_t c{}; c < 4u; ++c )
+            {
+                projection += ( texel[c] - mean[c] ) * axis[c];
+            }
+            min_projection = std::min( min_projection, projection );
+            max_projection = std::max( max_projection, projection );
+        }
+
+        // 2. Try every p-bit combination, they shift the reachable endpoint values by one.
+        Bc7Endpoints best_endpoints{};
+        std::array<uint8_t, 16> best_indices{};
+        uint64_t best_error{ UINT64_MAX };
+        for ( uint32_t pbits{}; pbits < 4u; ++pbits )
+        {
+            Bc7Endpoints endpoints{ .low_pbit = pbits & 1u, .high_pbit = pbits >> 1u };
+            for ( uint32_t c{}; c < 4u; ++c )
+            {
+                endpoints.low[c]  = quantize_endpoint( mean[c] + axis[c] * min_projection, endpoints.low_pbit );
+                endpoints.high[c] = quantize_endpoint( mean[c] + axis[c] * max_projection, endpoints.high_pbit );
+            }
+
+            std::array<uint8_t, 16> indices{};
+            if ( uint64_t const error = fit_bc7_indices( texels, endpoints, indices ); error < best_error )
+            {
+                best_error     = error;
+                best_endpoints = endpoints;
+                best_indices   = indices;
+            }
+        }
+
+        // 3. The anchor index drops its top bit, flip the endpoints if the first texel needs it.
+        if ( best_indices[0] & 0x8u )
+        {
+            std::swap( best_endpoints.low, best_endpoints.high );
+            std::swap( best_endpoints.low_pbit, best_endpoints.high_pbit );
+            for ( uint8_t& index : best_indices )
+            {
+                index = static_cast<uint8_t>( 15u - index );
+            }
+        }
+
+        // 4. Pack: mode bit, endpoints grouped per channel, p-bits, indices.
+        BlockBitWriter writer{};
+        writer.write( 1u << 6u, 7u );
+        for ( uint32_t c{}; c < 4u; ++c )
+        {
+            writer.write( best_endpoints.low[c], 7u );
+            writer.write( best_endpoints.high[c], 7u );
+        }
+        writer.write( best_endpoints.low_pbit, 1u );
+        writer.write( best_endpoints.high_pbit, 1u );
+        writer.write( best_indices[0], 3u );
+        for ( uint32_t texel{ 1u }; texel < 16u; ++texel )
+        {
+            writer.write( best_indices[texel], 4u );
+        }
+        return writer.bits( );
+    }
+
+
+    std::vector<std::byte> encode_bc7( std::span<uint8_t const> const rgba, uint32_t const width, uint32_t const height )
+    {
+        return encode_blocks<16u>( rgba, width, height, encode_bc7_block );
+    }
+
+}
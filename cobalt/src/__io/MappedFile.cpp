@@ -0,0 +1,171 @@
+#include <__io/MappedFile.h>
+
+#include <__io/hash.h>
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace cobalt::io
+{
+    MappedFile::MappedFile( std::filesystem::path const& path )
+    {
+#ifdef _WIN32
+        HANDLE const file = CreateFileW( path.c_str( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( file == INVALID_HANDLE_VALUE )
+        {
+            return;
+        }
+        file_handle_ = file;
+
+        LARGE_INTEGER file_size{};
+        if ( not GetFileSizeEx( file, &file_size ) )
+        {
+            unmap( );
+            return;
+        }
+        size_ = static_cast<size_t>( file_size.QuadPart );
+        open_ = true;
+
+        // Empty files cannot be mapped, they are still a valid (empty) view.
+        if ( size_ == 0u )
+        {
+            return;
+        }
+
+        mapping_handle_ = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( mapping_handle_ == nullptr )
+        {
+            unmap( );
+            return;
+        }
+        data_ptr_ = static_cast<std::byte const*>( MapViewOfFile( mapping_handle_, FILE_MAP_READ, 0, 0, 0 ) );
+        if ( data_ptr_ == nullptr )
+        {
+            unmap( );
+        }
+#else
+        int const fd = ::open( path.c_str( ), O_RDONLY );
+        if ( fd < 0 )
+        {
+            return;
+        }
+
+        struct stat file_stat{};
+        if ( fstat( fd, &file_stat ) != 0 )
+        {
+            ::close( fd );
+            return;
+        }
+        size_ = static_cast<size_t>( file_stat.st_size );
+        open_ = true;
+
+        // Empty files cannot be mapped, they are still a valid (empty) view.
+        if ( size_ != 0u )
+        {
+            void* const mapping = mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( mapping == MAP_FAILED )
+            {
+                size_ = 0u;
+                open_ = false;
+            }
+            else
+            {
+                data_ptr_ = static_cast<std::byte const*>( mapping );
+            }
+        }
+
+        // The mapping keeps its own reference to the file.
+        ::close( fd );
+#endif
+    }
+
+
+    MappedFile::~MappedFile( ) noexcept
+    {
+        unmap( );
+    }
+
+
+    MappedFile::MappedFile( MappedFile&& other ) noexcept
+        : data_ptr_{ std::exchange( other.data_ptr_, nullptr ) }
+        , size_{ std::exchange( other.size_, 0u ) }
+        , open_{ std::exchange( other.open_, false ) }
+#ifdef _WIN32
+        , file_handle_{ std::exchange( other.file_handle_, nullptr ) }
+        , mapping_handle_{ std::exchange( other.mapping_handle_, nullptr ) }
+#endif
+    { }
+
+
+    bool MappedFile::is_open( ) const noexcept
+    {
+        return open_;
+    }
+
+
+    std::byte const* MappedFile::data( ) const noexcept
+    {
+        return data_ptr_;
+    }
+
+
+    size_t MappedFile::size( ) const noexcept
+    {
+        return size_;
+    }
+
+
+    std::span<std::byte const> MappedFile::bytes( ) const noexcept
+    {
+        return { data_ptr_, size_ };
+    }
+
+
+    void MappedFile::unmap( ) noexcept
+    {
+#ifdef _WIN32
+        if ( data_ptr_ )
+        {
+            UnmapViewOfFile( data_ptr_ );
+        }
+        if ( mapping_handle_ )
+        {
+            CloseHandle( mapping_handle_ );
+        }
+        if ( file_handle_ )
+        {
+            CloseHandle( file_handle_ );
+        }
+        mapping_handle_ = nullptr;
+        file_handle_    = nullptr;
+#else
+        if ( data_ptr_ )
+        {
+            munmap( const_cast<std::byte*>( data_ptr_ ), size_ );
+        }
+#endif
+        data_ptr_ = nullptr;
+        size_     = 0u;
+        open_     = false;
+    }
+
+
+    uint64_t hash_file( std::filesystem::path const& path )
+    {
+        MappedFile const file{ path };
+        return hash_bytes( file.bytes( ) );
+    }
+
+}
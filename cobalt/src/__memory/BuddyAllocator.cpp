@@ -0,0 +1,108 @@
+#include <__memory/BuddyAllocator.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+
+namespace cobalt::memory
+{
+    BuddyAllocator::BuddyAllocator( uint64_t const capacity, uint64_t const min_node_size )
+        : capacity_{ capacity }
+        , min_node_size_{ min_node_size }
+        , max_order_{ static_cast<uint32_t>( std::countr_zero( capacity / min_node_size ) ) }
+    {
+        assert( std::has_single_bit( capacity ) && std::has_single_bit( min_node_size ) &&
+            "BuddyAllocator::BuddyAllocator: sizes must be powers of two!" );
+        assert( min_node_size <= capacity && "BuddyAllocator::BuddyAllocator: node size exceeds the capacity!" );
+
+        free_nodes_.resize( max_order_ + 1u );
+        free_nodes_[max_order_].insert( 0u );
+    }
+
+
+    std::optional<uint64_t> BuddyAllocator::allocate( uint64_t const size, uint64_t const alignment )
+    {
+        // 1. Nodes are aligned to their own size, growing the request to the alignment covers both.
+        uint64_t const required = std::bit_ceil( std::max( { size, alignment, min_node_size_ } ) );
+        if ( required > capacity_ )
+        {
+            return std::nullopt;
+        }
+        auto const order = static_cast<uint32_t>( std::countr_zero( required / min_node_size_ ) );
+
+        // 2. Find the smallest free node that fits.
+        uint32_t found_order{ order };
+        while ( found_order <= max_order_ && free_nodes_[found_order].empty( ) )
+        {
+            ++found_order;
+        }
+        if ( found_order > max_order_ )
+        {
+            return std::nullopt;
+        }
+
+        uint64_t const offset = *free_nodes_[found_order].begin( );
+        free_nodes_[found_order].erase( free_nodes_[found_order].begin( ) );
+
+        // 3. Split it down, the upper halves go back to the free lists.
+        while ( found_order > order )
+        {
+            --found_order;
+            free_nodes_[found_order].insert( offset + node_size( found_order ) );
+        }
+
+        allocated_orders_.emplace( offset, order );
+        used_ += node_size( order );
+        return offset;
+    }
+
+
+    void BuddyAllocator::free( uint64_t offset )
+    {
+        auto const it = allocated_orders_.find( offset );
+        assert( it != allocated_orders_.end( ) && "BuddyAllocator::free: offset was not allocated!" );
+
+        uint32_t order = it->second;
+        allocated_orders_.erase( it );
+        used_ -= node_size( order );
+
+        // Merge with the buddy for as long as it is free as well.
+        while ( order < max_order_ )
+        {
+            uint64_t const buddy = offset ^ node_size( order );
+            if ( free_nodes_[order].erase( buddy ) == 0u )
+            {
+                break;
+            }
+            offset = std::min( offset, buddy );
+            ++order;
+        }
+        free_nodes_[order].insert( offset );
+    }
+
+
+    uint64_t BuddyAllocator::capacity( ) const
+    {
+        return capacity_;
+    }
+
+
+    uint64_t BuddyAllocator::used( ) const
+    {
+        return used_;
+    }
+
+
+    bool BuddyAllocator::empty( ) const
+    {
+        return allocated_orders_.empty( );
+    }
+
+
+    uint64_t BuddyAllocator::node_size( uint32_t const order ) const
+    {
+        return min_node_size_ << order;
+    }
+
+}
@@ -0,0 +1,319 @@
+#include <__memory/DeviceAllocator.h>
+
+#include <log.h>
+#include <__memory/BuddyAllocator.h>
+#include <__memory/device_memory_policy.h>
+#include <__memory/LinearAllocator.h>
+#include <__validation/result.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <optional>
+#include <variant>
+
+
+namespace cobalt::memory
+{
+    // +---------------------------+
+    // | DEVICE MEMORY BLOCK       |
+    // +---------------------------+
+    class DeviceMemoryBlock final
+    {
+    public:
+        DeviceMemoryBlock( VkDeviceMemory const memory, VkDeviceSize const size, AllocationLifetime const lifetime,
+                           VkDeviceSize const min_allocation_size )
+            : memory_{ memory }
+            , allocator_{ lifetime == AllocationLifetime::TRANSIENT
+                              ? allocator_t{ std::in_place_type<LinearAllocator>, size }
+                              : allocator_t{ std::in_place_type<BuddyAllocator>, size, min_allocation_size } } { }
+
+        [[nodiscard]] VkDeviceMemory memory( ) const { return memory_; }
+
+        [[nodiscard]] std::optional<VkDeviceSize> allocate( VkDeviceSize const size, VkDeviceSize const alignment )
+        {
+            return std::visit( [&]( auto& allocator ) { return allocator.allocate( size, alignment ); }, allocator_ );
+        }
+
+
+        void free( VkDeviceSize const offset )
+        {
+            if ( auto* buddy = std::get_if<BuddyAllocator>( &allocator_ ) )
+            {
+                buddy->free( offset );
+            }
+            else
+            {
+                std::get<LinearAllocator>( allocator_ ).free( );
+            }
+        }
+
+
+        [[nodiscard]] VkDeviceSize capacity( ) const
+        {
+            return std::visit( []( auto const& allocator ) { return allocator.capacity( ); }, allocator_ );
+        }
+
+
+        [[nodiscard]] VkDeviceSize used( ) const
+        {
+            return std::visit( []( auto const& allocator ) { return allocator.used( ); }, allocator_ );
+        }
+
+
+        [[nodiscard]] bool empty( ) const
+        {
+            return std::visit( []( auto const& allocator ) { return allocator.empty( ); }, allocator_ );
+        }
+
+
+        [[nodiscard]] void* map( VkDevice const device )
+        {
+            if ( mapped_ptr_ == nullptr )
+            {
+                validation::throw_on_bad_result(
+                    vkMapMemory( device, memory_, 0u, VK_WHOLE_SIZE, 0u, &mapped_ptr_ ),
+                    "failed to map memory block!" );
+            }
+            return mapped_ptr_;
+        }
+
+    private:
+        using allocator_t = std::variant<BuddyAllocator, LinearAllocator>;
+
+        VkDeviceMemory const memory_;
+        allocator_t allocator_;
+
+        // Mapped on first use and left mapped, vkFreeMemory implicitly unmaps it.
+        void* mapped_ptr_{ nullptr };
+
+    };
+
+
+    // +---------------------------+
+    // | DEVICE ALLOCATOR          |
+    // +---------------------------+
+    DeviceAllocator::DeviceAllocator( VkDevice const device, VkPhysicalDevice const physical_device,
+                                      DeviceAllocatorCreateInfo const& create_info )
+        : device_{ device }
+        , create_info_{ create_info }
+    {
+        assert( std::has_single_bit( create_info.block_size ) && std::has_single_bit( create_info.transient_block_size ) &&
+            std::has_single_bit( create_info.min_allocation_size ) &&
+            "DeviceAllocator::DeviceAllocator: sizes must be powers of two!" );
+
+        vkGetPhysicalDeviceMemoryProperties( physical_device, &memory_properties_ );
+    }
+
+
+    DeviceAllocator::~DeviceAllocator( ) noexcept
+    {
+        DeviceAllocatorStats const leaked = stats( );
+        log::logerr<DeviceAllocator>( "~DeviceAllocator",
+                                      std::format( "{} allocations still alive on destruction!", leaked.allocation_count ),
+                                      leaked.allocation_count > 0u );
+
+        for ( auto const& pool : pools_ )
+        {
+            for ( auto const& block : pool )
+            {
+                if ( block )
+                {
+                    vkFreeMemory( device_, block->memory( ), nullptr );
+                }
+            }
+        }
+        for ( auto const& [memory, mapped_ptr] : dedicated_allocations_ )
+        {
+            vkFreeMemory( device_, memory, nullptr );
+        }
+    }
+
+
+    DeviceAllocation DeviceAllocator::allocate( AllocationRequest const& request )
+    {
+        uint32_t const memory_type = find_memory_type( memory_properties_, request.requirements.memoryTypeBits,
+                                                       request.properties );
+        VkDeviceSize const block_size = pool_block_size( memory_properties_, create_info_, memory_type, request.lifetime );
+
+        std::lock_guard const lock{ mutex_ };
+
+        // 1. Large resources would waste most of a block, they get memory of their own.
+        if ( requires_dedicated( request.requirements.size, block_size ) )
+        {
+            return allocate_dedicated( request.requirements.size, memory_type );
+        }
+
+        // 2. First fit over the blocks of the pool.
+        uint32_t const index = pool_index( memory_type, request );
+        auto& pool = pools_[index];
+        for ( uint32_t block_index{}; block_index < pool.size( ); ++block_index )
+        {
+            if ( not pool[block_index] )
+            {
+                continue;
+            }
+            if ( auto const offset = pool[block_index]->allocate( request.requirements.size, request.requirements.alignment ) )
+            {
+                ++allocation_count_;
+                return DeviceAllocation{
+                    .memory = pool[block_index]->memory( ),
+                    .offset = *offset,
+                    .size = request.requirements.size,
+                    .pool_index = index,
+                    .block_index = block_index
+                };
+            }
+        }
+
+        // 3. No room left, grow the pool. Freed slots are reused before appending.
+        auto const slot = std::ranges::find_if( pool, []( auto const& block ) { return block == nullptr; } );
+        auto const block_index = static_cast<uint32_t>( std::distance( pool.begin( ), slot ) );
+        auto block = std::make_unique<DeviceMemoryBlock>(
+            allocate_memory( block_size, memory_type ), block_size, request.lifetime, create_info_.min_allocation_size );
+
+        auto const offset = block->allocate( request.requirements.size, request.requirements.alignment );
+        assert( offset.has_value( ) && "DeviceAllocator::allocate: fresh block cannot fit the request!" );
+
+        DeviceAllocation const allocation{
+            .memory = block->memory( ),
+            .offset = *offset,
+            .size = request.requirements.size,
+            .pool_index = index,
+            .block_index = block_index
+        };
+        ++allocation_count_;
+
+        if ( slot == pool.end( ) )
+        {
+            pool.push_back( std::move( block ) );
+        }
+        else
+        {
+            *slot = std::move( block );
+        }
+        return allocation;
+    }
+
+
+    void DeviceAllocator::free( DeviceAllocation const& allocation )
+    {
+        if ( not allocation.valid( ) )
+        {
+            return;
+        }
+
+        std::lock_guard const lock{ mutex_ };
+
+        --allocation_count_;
+        if ( allocation.dedicated( ) )
+        {
+            dedicated_allocations_.erase( allocation.memory );
+            dedicated_bytes_ -= allocation.size;
+            vkFreeMemory( device_, allocation.memory, nullptr );
+            return;
+        }
+
+        auto& pool = pools_[allocation.pool_index];
+        auto& block = pool[allocation.block_index];
+        assert( block && block->memory( ) == allocation.memory && "DeviceAllocator::free: allocation does not match its block!" );
+
+        block->free( allocation.offset );
+        if ( not block->empty( ) )
+        {
+            return;
+        }
+
+        // Keep one empty block around per pool, releasing it would make the next resource pay for a driver allocation.
+        bool const has_other_block = std::ranges::any_of( pool, [&]( auto const& other )
+            {
+                return other && other != block;
+            } );
+        if ( has_other_block )
+        {
+            vkFreeMemory( device_, block->memory( ), nullptr );
+            block.reset( );
+        }
+    }
+
+
+    void* DeviceAllocator::map( DeviceAllocation const& allocation )
+    {
+        assert( allocation.valid( ) && "DeviceAllocator::map: invalid allocation!" );
+
+        std::lock_guard const lock{ mutex_ };
+
+        if ( allocation.dedicated( ) )
+        {
+            void*& mapped_ptr = dedicated_allocations_.at( allocation.memory );
+            if ( mapped_ptr == nullptr )
+            {
+                validation::throw_on_bad_result(
+                    vkMapMemory( device_, allocation.memory, 0u, VK_WHOLE_SIZE, 0u, &mapped_ptr ),
+                    "failed to map dedicated memory!" );
+            }
+            return mapped_ptr;
+        }
+
+        void* const block_ptr = pools_[allocation.pool_index][allocation.block_index]->map( device_ );
+        return static_cast<std::byte*>( block_ptr ) + allocation.offset;
+    }
+
+
+    DeviceAllocatorStats DeviceAllocator::stats( ) const
+    {
+        std::lock_guard const lock{ mutex_ };
+
+        DeviceAllocatorStats stats{
+            .dedicated_count = static_cast<uint32_t>( dedicated_allocations_.size( ) ),
+            .allocation_count = allocation_count_,
+            .reserved_bytes = dedicated_bytes_,
+            .used_bytes = dedicated_bytes_
+        };
+        for ( auto const& pool : pools_ )
+        {
+            for ( auto const& block : pool )
+            {
+                if ( block )
+                {
+                    ++stats.block_count;
+                    stats.reserved_bytes += block->capacity( );
+                    stats.used_bytes += block->used( );
+                }
+            }
+        }
+        return stats;
+    }
+
+
+    VkDeviceMemory DeviceAllocator::allocate_memory( VkDeviceSize const size, uint32_t const memory_type ) const
+    {
+        VkMemoryAllocateInfo const alloc_info{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = size,
+            .memoryTypeIndex = memory_type
+        };
+
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        validation::throw_on_bad_result(
+            vkAllocateMemory( device_, &alloc_info, nullptr, &memory ),
+            "Failed to allocate device memory!" );
+        return memory;
+    }
+
+
+    DeviceAllocation DeviceAllocator::allocate_dedicated( VkDeviceSize const size, uint32_t const memory_type )
+    {
+        VkDeviceMemory const memory = allocate_memory( size, memory_type );
+        dedicated_allocations_.emplace( memory, nullptr );
+        dedicated_bytes_ += size;
+        ++allocation_count_;
+
+        return DeviceAllocation{
+            .memory = memory,
+            .offset = 0u,
+            .size = size,
+        };
+    }
+
+}
@@ -0,0 +1,55 @@
+#include <__memory/LinearAllocator.h>
+
+#include <cassert>
+
+
+namespace cobalt::memory
+{
+    LinearAllocator::LinearAllocator( uint64_t const capacity )
+        : capacity_{ capacity } { }
+
+
+    std::optional<uint64_t> LinearAllocator::allocate( uint64_t const size, uint64_t const alignment )
+    {
+        uint64_t const offset = ( head_ + alignment - 1u ) / alignment * alignment;
+        if ( offset + size > capacity_ )
+        {
+            return std::nullopt;
+        }
+
+        head_ = offset + size;
+        ++live_count_;
+        return offset;
+    }
+
+
+    void LinearAllocator::free( )
+    {
+        assert( live_count_ > 0u && "LinearAllocator::free: no live allocation!" );
+
+        // The range is only reclaimed as a whole, once nothing points into it anymore.
+        if ( --live_count_ == 0u )
+        {
+            head_ = 0u;
+        }
+    }
+
+
+    uint64_t LinearAllocator::capacity( ) const
+    {
+        return capacity_;
+    }
+
+
+    uint64_t LinearAllocator::used( ) const
+    {
+        return head_;
+    }
+
+
+    bool LinearAllocator::empty( ) const
+    {
+        return live_count_ == 0u;
+    }
+
+}
@@ -0,0 +1,51 @@
+#include <__memory/device_memory_policy.h>
+
+#include <__validation/dispatch.h>
+
+#include <algorithm>
+#include <bit>
+
+
+namespace cobalt::memory
+{
+    uint32_t find_memory_type( VkPhysicalDeviceMemoryProperties const& memory_properties, uint32_t const type_filter,
+                               VkMemoryPropertyFlags const properties )
+    {
+        for ( uint32_t i{}; i < memory_properties.memoryTypeCount; ++i )
+        {
+            if ( type_filter & ( 1u << i ) && ( memory_properties.memoryTypes[i].propertyFlags & properties ) == properties )
+            {
+                return i;
+            }
+        }
+        validation::throw_runtime_error( "Failed to find suitable memory type!" );
+        return UINT32_MAX;
+    }
+
+
+    VkDeviceSize pool_block_size( VkPhysicalDeviceMemoryProperties const& memory_properties,
+                                  DeviceAllocatorCreateInfo const& create_info, uint32_t const memory_type,
+                                  AllocationLifetime const lifetime )
+    {
+        // Small heaps (e.g. the 256MiB BAR heap) would be exhausted by a handful of blocks, stay within an eighth of them.
+        VkDeviceSize const heap_size = memory_properties.memoryHeaps[memory_properties.memoryTypes[memory_type].heapIndex].size;
+        VkDeviceSize const block_size = lifetime == AllocationLifetime::TRANSIENT
+                                            ? create_info.transient_block_size
+                                            : create_info.block_size;
+        return std::max( std::min( block_size, std::bit_floor( heap_size / 8u ) ), create_info.min_allocation_size );
+    }
+
+
+    uint32_t pool_index( uint32_t const memory_type, AllocationRequest const& request )
+    {
+        return memory_type * DeviceAllocator::POOLS_PER_MEMORY_TYPE + ( request.linear_resource ? 2u : 0u ) +
+               ( request.lifetime == AllocationLifetime::TRANSIENT ? 1u : 0u );
+    }
+
+
+    bool requires_dedicated( VkDeviceSize const size, VkDeviceSize const block_size )
+    {
+        return size > block_size / 2u;
+    }
+
+}
@@ -1,4 +1,4 @@
-#include <__memory/handle/HandleTable.h>
+#include <__memory/handle/ResourcePool.h>
 
 #include <log.h>
 
@@ -7,20 +7,20 @@ namespace cobalt::handle_log
 {
     void logerr_on_invalid_table_index( std::string_view const& src, memory::handle_index_t const index, size_t const table_size )
     {
-        log::logerr<HandleTable<int>>( src, "table_index out of bounds.", index >= table_size );
+        log::logerr<memory::ResourcePoolBase>( src, "table_index out of bounds.", index >= table_size );
     }
 
 
     void logerr_on_invalid_resource_index( std::string_view const& src, memory::handle_index_t const index )
     {
-        log::logerr<HandleTable<int>>( src, "resource index is NULL_HANDLE_INDEX.", index == NULL_HANDLE_INDEX );
+        log::logerr<memory::ResourcePoolBase>( src, "resource index is NULL_HANDLE_INDEX.", index == NULL_HANDLE_INDEX );
     }
 
 
     void logerr_on_generation_mismatch( std::string_view const& src, memory::handle_index_t const gen1,
                                         memory::handle_index_t const gen2 )
     {
-        log::logerr<HandleTable<int>>( src, "generation mismatch.", gen1 != gen2 );
+        log::logerr<memory::ResourcePoolBase>( src, "generation mismatch.", gen1 != gen2 );
     }
 
 }
@@ -1,11 +1,21 @@
+#include <log.h>
 #include <__model/AssimpModelLoader.h>
 
+#include <__io/MappedFile.h>
+#include <__io/hash.h>
+#include <__model/mesh_optimizer.h>
 #include <__validation/dispatch.h>
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
 #include <span>
 #include <unordered_map>
 #include <utility>
@@ -16,12 +26,33 @@ namespace cobalt::loader
     static constexpr std::string_view FALLBACK_TEXTURE_NAME{ "missing_texture_256x256.png" };
     static constexpr uint32_t FALLBACK_TEXTURE_INDEX{ 0 };
 
+    // The first simplified level clusters the mesh on a grid of this many cells along its longest side, every next attempt
+    // halves it. A level is only kept if it has at most this fraction of the triangles of the previous one.
+    static constexpr float LOD_BASE_RESOLUTION{ 64.f };
+    static constexpr float LOD_MIN_RESOLUTION{ 2.f };
+    static constexpr float LOD_MIN_REDUCTION{ 0.6f };
+
+    // Indexes the texture table while materials are extracted. Paths are looked up by their normalized form, contents by
+    // their hash and type, since the type decides the format a texture is uploaded in.
+    struct TextureTable
+    {
+        std::vector<TextureGroup>& textures;
+        bool dedupe_content{};
+
+        std::unordered_map<std::string, uint32_t> path_indices{};
+        std::unordered_map<uint64_t, std::vector<uint32_t>> content_indices{};
+        uint32_t content_duplicates{};
+    };
+
+
     // +---------------------------+
     // | HELPERS FORWARD DECL      |
     // +---------------------------+
     void extract_meshes( aiScene const*, std::vector<Vertex>&, std::vector<uint32_t>&, std::vector<Mesh>& );
-    void extract_materials( aiScene const*, std::vector<SurfaceMap>&, std::vector<TextureGroup>&, std::filesystem::path const& );
-    uint32_t fetch_texture_data( aiMaterial const*, aiTextureType, std::vector<TextureGroup>&, std::filesystem::path const& );
+    void build_lods( Mesh&, std::span<Vertex const>, std::span<uint32_t const> full_indices, std::vector<uint32_t>& );
+    void extract_materials( aiScene const*, std::vector<SurfaceMap>&, TextureTable&, std::filesystem::path const& );
+    uint32_t fetch_texture_data( aiMaterial const*, aiTextureType, TextureTable&, std::filesystem::path const& );
+    std::optional<uint32_t> find_texture_content( TextureTable const&, uint64_t content_key, io::MappedFile const& );
 
     [[nodiscard]] glm::vec3 to_vec3( aiVector3D const& vec ) { return { vec.x, vec.y, vec.z }; }
     [[nodiscard]] glm::vec3 to_vec3( aiColor3D const& color ) { return { color.r, color.g, color.b }; }
@@ -33,7 +64,9 @@ namespace cobalt::loader
     // +---------------------------+
     // | MODEL LOADER              |
     // +---------------------------+
-    AssimpModelLoader::AssimpModelLoader( std::filesystem::path path ) : ModelLoader{ std::move( path ) } { }
+    AssimpModelLoader::AssimpModelLoader( std::filesystem::path path, bool const dedupe_texture_content )
+        : ModelLoader{ std::move( path ) }
+        , dedupe_texture_content_{ dedupe_texture_content } { }
 
 
     void AssimpModelLoader::load( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
@@ -54,9 +87,16 @@ namespace cobalt::loader
         // add empty texture for fallback
         textures.emplace_back( TextureGroup{ .type = TextureType::BASE_COLOR, .path = base_path_ / FALLBACK_TEXTURE_NAME } );
 
+        TextureTable texture_table{ .textures = textures, .dedupe_content = dedupe_texture_content_ };
+        texture_table.path_indices.emplace( textures.back( ).path.lexically_normal( ).string( ), FALLBACK_TEXTURE_INDEX );
+
         // load meshes and materials
         extract_meshes( scene, vertices, indices, meshes );
-        extract_materials( scene, surface_maps, textures, base_path_ );
+        extract_materials( scene, surface_maps, texture_table, base_path_ );
+
+        log::loginfo<AssimpModelLoader>( "load", std::format( "{} unique textures, {} merged by content",
+                                                              textures.size( ), texture_table.content_duplicates ),
+                                         texture_table.content_duplicates > 0u );
     }
 
 
@@ -67,39 +107,146 @@ namespace cobalt::loader
                          std::vector<Mesh>& meshes )
     {
         int32_t vertex_offset{};
-        uint32_t index_offset{};
+
+        // Cache misses weighted by triangle count, to report the whole model before and after optimizing.
+        double misses_before{};
+        double misses_after{};
+        size_t short_index_meshes{};
+        std::array<size_t, Mesh::MAX_LOD_COUNT> lod_triangles{};
 
         aiMatrix4x4 const root_transform = scene->mRootNode->mTransformation;
 
         for ( aiMesh const* const mesh : std::span{ scene->mMeshes, std::next( scene->mMeshes, scene->mNumMeshes ) } )
         {
-            uint32_t const num_vertices = mesh->mNumVertices;
-            vertices.reserve( vertices.size( ) + num_vertices );
-            for ( size_t vertex_idx{}; vertex_idx < num_vertices; ++vertex_idx )
+            uint32_t const num_indices = mesh->mNumFaces * 3;
+            std::vector<uint32_t> mesh_indices{};
+            mesh_indices.reserve( num_indices );
+            for ( aiFace const& face : std::span{ mesh->mFaces, std::next( mesh->mFaces, mesh->mNumFaces ) } )
             {
-                vertices.emplace_back(
+                std::copy( face.mIndices, std::next( face.mIndices, face.mNumIndices ), std::back_inserter( mesh_indices ) );
+            }
+
+            // Reorder the triangles for the post-transform cache, then lay the vertices out in the order they are fetched.
+            // Vertices no triangle references are dropped by the remap.
+            double const triangle_count = static_cast<double>( mesh_indices.size( ) / 3u );
+            misses_before += mesh::calculate_acmr( mesh_indices, mesh->mNumVertices ) * triangle_count;
+
+            mesh::optimize_vertex_cache( mesh_indices, mesh->mNumVertices );
+            std::vector<uint32_t> const remap = mesh::optimize_vertex_fetch( mesh_indices, mesh->mNumVertices );
+
+            auto const num_vertices = static_cast<uint32_t>(
+                std::ranges::count_if( remap, []( uint32_t const slot ) { return slot != mesh::UNUSED_VERTEX; } ) );
+            misses_after += mesh::calculate_acmr( mesh_indices, num_vertices ) * triangle_count;
+
+            size_t const first_vertex = vertices.size( );
+            vertices.resize( first_vertex + num_vertices );
+            for ( uint32_t vertex_idx{}; vertex_idx < mesh->mNumVertices; ++vertex_idx )
+            {
+                if ( remap[vertex_idx] == mesh::UNUSED_VERTEX )
+                {
+                    continue;
+                }
+                vertices[first_vertex + remap[vertex_idx]] = Vertex{
                     to_vec3( root_transform * mesh->mVertices[vertex_idx] ),
                     to_vec2( mesh->mTextureCoords[0][vertex_idx] ),
                     to_vec3( mesh->mNormals[vertex_idx] ),
                     to_vec3( mesh->mTangents[vertex_idx] ),
-                    to_vec3( mesh->mBitangents[vertex_idx] ) );
+                    to_vec3( mesh->mBitangents[vertex_idx] ) };
             }
 
-            uint32_t const num_indices = mesh->mNumFaces * 3;
-            indices.reserve( indices.size( ) + num_indices );
-            for ( aiFace const& face : std::span{ mesh->mFaces, std::next( mesh->mFaces, mesh->mNumFaces ) } )
+            // Indices are relative to vertex_offset, so a mesh fits 16-bit indices on its own.
+            VkIndexType const index_type = mesh::fits_short_indices( num_vertices ) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+            short_index_meshes += index_type == VK_INDEX_TYPE_UINT16;
+
+            Mesh& new_mesh = meshes.emplace_back( Mesh{
+                .vertex_offset = vertex_offset,
+                .material_index = mesh->mMaterialIndex,
+                .index_type = index_type
+            } );
+            build_lods( new_mesh, std::span{ vertices }.subspan( first_vertex, num_vertices ), mesh_indices, indices );
+
+            for ( uint32_t lod{}; lod < new_mesh.lod_count; ++lod )
             {
-                std::copy( face.mIndices, std::next( face.mIndices, face.mNumIndices ), std::back_inserter( indices ) );
+                lod_triangles[lod] += new_mesh.lods[lod].index_count / 3u;
             }
-
-            meshes.emplace_back( num_indices, index_offset, vertex_offset, mesh->mMaterialIndex );
             vertex_offset += num_vertices;
-            index_offset += num_indices;
         }
+
+        auto const total_triangles = static_cast<double>( lod_triangles[0] );
+        log::loginfo<AssimpModelLoader>(
+            "extract_meshes",
+            std::format( "{} meshes, {} triangles: ACMR {:.3f} -> {:.3f}, {} meshes use 16-bit indices",
+                         meshes.size( ), lod_triangles[0],
+                         total_triangles > 0.0 ? misses_before / total_triangles : 0.0,
+                         total_triangles > 0.0 ? misses_after / total_triangles : 0.0, short_index_meshes ) );
+        log::loginfo<AssimpModelLoader>(
+            "extract_meshes",
+            std::format( "triangles per level of detail: {} / {} / {} / {}",
+                         lod_triangles[0], lod_triangles[1], lod_triangles[2], lod_triangles[3] ) );
     }
 
 
-    void extract_materials( aiScene const* scene, std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures,
+    void build_lods( Mesh& mesh, std::span<Vertex const> const vertices, std::span<uint32_t const> const full_indices,
+                     std::vector<uint32_t>& indices )
+    {
+        std::vector<glm::vec3> positions( vertices.size( ) );
+        std::vector<glm::vec3> normals( vertices.size( ) );
+        std::ranges::transform( vertices, positions.begin( ), &Vertex::position );
+        std::ranges::transform( vertices, normals.begin( ), &Vertex::normal );
+
+        // 1. Bound the mesh, the box and sphere drive the culling and level selection at draw time.
+        glm::vec3 bounds_min{ std::numeric_limits<float>::max( ) };
+        glm::vec3 bounds_max{ std::numeric_limits<float>::lowest( ) };
+        for ( glm::vec3 const& position : positions )
+        {
+            bounds_min = glm::min( bounds_min, position );
+            bounds_max = glm::max( bounds_max, position );
+        }
+        mesh.bounds_min    = bounds_min;
+        mesh.bounds_max    = bounds_max;
+        mesh.bounds_center = ( bounds_min + bounds_max ) * 0.5f;
+        for ( glm::vec3 const& position : positions )
+        {
+            mesh.bounds_radius = std::max( mesh.bounds_radius, glm::length( position - mesh.bounds_center ) );
+        }
+
+        // 2. The full mesh is level 0.
+        mesh.lods[0] = MeshLod{ static_cast<uint32_t>( full_indices.size( ) ), static_cast<uint32_t>( indices.size( ) ), 0.f };
+        mesh.lod_count = 1u;
+        indices.insert( indices.end( ), full_indices.begin( ), full_indices.end( ) );
+
+        // 3. Cluster on coarser and coarser grids. The cells are nested, so every level only removes detail. The error is
+        // the cell diagonal, the furthest a vertex can move when snapped to its cluster.
+        glm::vec3 const extent = bounds_max - bounds_min;
+        float const longest_side = std::max( { extent.x, extent.y, extent.z } );
+        size_t previous_count = full_indices.size( );
+        for ( float resolution = LOD_BASE_RESOLUTION;
+              mesh.lod_count < Mesh::MAX_LOD_COUNT && resolution >= LOD_MIN_RESOLUTION && longest_side > 0.f;
+              resolution *= 0.5f )
+        {
+            float const cell_size = longest_side / resolution;
+            std::vector<uint32_t> lod_indices = mesh::simplify_clustered( full_indices, positions, normals, cell_size );
+            if ( lod_indices.empty( ) )
+            {
+                break;
+            }
+            if ( static_cast<float>( lod_indices.size( ) ) > LOD_MIN_REDUCTION * static_cast<float>( previous_count ) )
+            {
+                continue;
+            }
+
+            mesh::optimize_vertex_cache( lod_indices, static_cast<uint32_t>( vertices.size( ) ) );
+            mesh.lods[mesh.lod_count++] = MeshLod{
+                static_cast<uint32_t>( lod_indices.size( ) ), static_cast<uint32_t>( indices.size( ) ),
+                cell_size * std::sqrt( 3.f )
+            };
+            indices.insert( indices.end( ), lod_indices.begin( ), lod_indices.end( ) );
+            previous_count = lod_indices.size( );
+        }
+    }
+
+
+    void extract_materials( aiScene const* scene, std::vector<SurfaceMap>& surface_maps, TextureTable& texture_table,
                             std::filesystem::path const& base_path )
     {
         surface_maps.reserve( scene->mNumMaterials );
@@ -107,18 +254,18 @@ namespace cobalt::loader
         {
             SurfaceMap map{};
             map.base.indices = glm::uvec4{
-                fetch_texture_data( mat, aiTextureType_BASE_COLOR, textures, base_path ),
-                fetch_texture_data( mat, aiTextureType_NORMALS, textures, base_path ),
-                fetch_texture_data( mat, aiTextureType_METALNESS, textures, base_path ),
-                fetch_texture_data( mat, aiTextureType_DIFFUSE_ROUGHNESS, textures, base_path )
+                fetch_texture_data( mat, aiTextureType_BASE_COLOR, texture_table, base_path ),
+                fetch_texture_data( mat, aiTextureType_NORMALS, texture_table, base_path ),
+                fetch_texture_data( mat, aiTextureType_METALNESS, texture_table, base_path ),
+                fetch_texture_data( mat, aiTextureType_DIFFUSE_ROUGHNESS, texture_table, base_path )
             };
-            map.extra.value.ao_index = fetch_texture_data( mat, aiTextureType_AMBIENT_OCCLUSION, textures, base_path );
+            map.extra.value.ao_index = fetch_texture_data( mat, aiTextureType_AMBIENT_OCCLUSION, texture_table, base_path );
             surface_maps.emplace_back( map );
         }
     }
 
 
-    uint32_t fetch_texture_data( aiMaterial const* mat, aiTextureType const type, std::vector<TextureGroup>& textures,
+    uint32_t fetch_texture_data( aiMaterial const* mat, aiTextureType const type, TextureTable& texture_table,
                                  std::filesystem::path const& base_path )
     {
         if ( mat->GetTextureCount( type ) <= 0 )
@@ -128,21 +275,61 @@ namespace cobalt::loader
 
         aiString relative_path{};
         mat->GetTexture( type, 0, &relative_path );
-        std::filesystem::path const texture_path{ base_path / relative_path.C_Str( ) };
+        std::filesystem::path const texture_path{ ( base_path / relative_path.C_Str( ) ).lexically_normal( ) };
+
+        auto const [it, inserted] = texture_table.path_indices.try_emplace( texture_path.string( ), FALLBACK_TEXTURE_INDEX );
+        if ( not inserted )
+        {
+            return it->second;
+        }
         if ( not exists( texture_path ) )
         {
             return FALLBACK_TEXTURE_INDEX;
         }
 
-        auto const it =
-                std::ranges::find_if( textures, [&texture_path]( TextureGroup const& tex ) { return tex.path == texture_path; } );
-        if ( it != textures.end( ) )
+        // Byte-identical files under another name share the image, it is decoded and uploaded once.
+        TextureType const tex_type = to_tex_type( type );
+        uint64_t content_key{};
+        if ( texture_table.dedupe_content )
+        {
+            io::MappedFile const file{ texture_path };
+            content_key = io::hash_combine( io::hash_bytes( file.bytes( ) ), static_cast<uint64_t>( tex_type ) );
+            if ( std::optional<uint32_t> const index = find_texture_content( texture_table, content_key, file ) )
+            {
+                ++texture_table.content_duplicates;
+                return it->second = *index;
+            }
+        }
+
+        it->second = static_cast<uint32_t>( texture_table.textures.size( ) );
+        texture_table.textures.emplace_back( tex_type, texture_path );
+        if ( texture_table.dedupe_content )
+        {
+            texture_table.content_indices[content_key].push_back( it->second );
+        }
+        return it->second;
+    }
+
+
+    std::optional<uint32_t> find_texture_content( TextureTable const& texture_table, uint64_t const content_key,
+                                                  io::MappedFile const& file )
+    {
+        auto const it = texture_table.content_indices.find( content_key );
+        if ( not file.is_open( ) || it == texture_table.content_indices.end( ) )
         {
-            return static_cast<uint32_t>( std::distance( textures.begin( ), it ) );
+            return std::nullopt;
         }
 
-        textures.emplace_back( to_tex_type( type ), std::move( texture_path ) );
-        return static_cast<uint32_t>( textures.size( ) - 1 );
+        // The hash only narrows the candidates down, the bytes decide.
+        for ( uint32_t const index : it->second )
+        {
+            io::MappedFile const candidate{ texture_table.textures[index].path };
+            if ( candidate.size( ) == file.size( ) && std::memcmp( candidate.data( ), file.data( ), file.size( ) ) == 0 )
+            {
+                return index;
+            }
+        }
+        return std::nullopt;
     }
 
 
@@ -0,0 +1,104 @@
+#include <__model/AsyncModel.h>
+
+#include <log.h>
+#include <__buffer/CommandPool.h>
+
+#include <cassert>
+#include <chrono>
+#include <exception>
+
+
+namespace cobalt
+{
+    AsyncModel::AsyncModel( DeviceSet const& device, std::unique_ptr<loader_t> loader, ModelCreateInfo const& create_info )
+    {
+        assert( loader && "AsyncModel::AsyncModel: Loader cannot be nullptr!" );
+        loader_thread_ = std::thread{ &AsyncModel::load, this, std::cref( device ), std::move( loader ), create_info };
+    }
+
+
+    AsyncModel::~AsyncModel( ) noexcept
+    {
+        // An import cannot be interrupted, destroying the handle early waits for it to finish.
+        if ( loader_thread_.joinable( ) )
+        {
+            loader_thread_.join( );
+        }
+    }
+
+
+    ModelLoadState AsyncModel::poll( )
+    {
+        if ( state_ != ModelLoadState::LOADING )
+        {
+            return state_;
+        }
+
+        ModelLoadState const loader_state = loader_state_.load( std::memory_order_acquire );
+        if ( loader_state == ModelLoadState::LOADING )
+        {
+            return state_;
+        }
+
+        loader_thread_.join( );
+        state_ = loader_state;
+        if ( state_ == ModelLoadState::READY )
+        {
+            loaded_dispatcher_.broadcast( *model_ptr_ );
+        }
+        return state_;
+    }
+
+
+    ModelLoadState AsyncModel::state( ) const
+    {
+        return state_;
+    }
+
+
+    bool AsyncModel::is_ready( ) const
+    {
+        return state_ == ModelLoadState::READY;
+    }
+
+
+    Model& AsyncModel::model( )
+    {
+        assert( is_ready( ) && "AsyncModel::model: Model is not loaded yet!" );
+        return *model_ptr_;
+    }
+
+
+    Model const& AsyncModel::model( ) const
+    {
+        assert( is_ready( ) && "AsyncModel::model: Model is not loaded yet!" );
+        return *model_ptr_;
+    }
+
+
+    void AsyncModel::load( DeviceSet const& device, std::unique_ptr<loader_t> loader, ModelCreateInfo const create_info )
+    {
+        using clock_t = std::chrono::steady_clock;
+        auto const start = clock_t::now( );
+
+        // The uploads are recorded on a pool of this thread, queue submissions are serialized with the render thread.
+        try
+        {
+            CommandPool cmd_pool{ device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT };
+            model_ptr_ = std::make_unique<Model>( device, cmd_pool, *loader, create_info );
+        }
+        catch ( std::exception const& e )
+        {
+            log::logerr<AsyncModel>( "load", e.what( ) );
+            model_ptr_.reset( );
+            loader_state_.store( ModelLoadState::FAILED, std::memory_order_release );
+            return;
+        }
+
+        log::loginfo<AsyncModel>( "load", std::format( "model loaded in the background in {:.1f}ms",
+                                                       std::chrono::duration<double, std::milli>(
+                                                           clock_t::now( ) - start ).count( ) ) );
+        loader_state_.store( ModelLoadState::READY, std::memory_order_release );
+    }
+
+}
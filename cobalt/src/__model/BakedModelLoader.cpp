@@ -0,0 +1,282 @@
+#include <__model/BakedModelLoader.h>
+
+#include <log.h>
+#include <__io/MappedFile.h>
+#include <__io/hash.h>
+#include <__model/AssimpModelLoader.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+
+namespace cobalt::loader
+{
+    // +---------------------------+
+    // | BLOB LAYOUT               |
+    // +---------------------------+
+    // [header][vertices][indices][meshes][surface maps][texture records], every section starts 16-byte aligned so the tables
+    // can be read in place from the mapping. A texture record is followed by its path, relative to the model directory.
+    static constexpr std::array<char, 4> BAKED_MODEL_MAGIC{ 'C', 'B', 'M', 'D' };
+    static constexpr uint64_t SECTION_ALIGNMENT{ 16u };
+
+
+    struct BakedSection
+    {
+        uint64_t offset{};
+        uint64_t count{};
+    };
+
+
+    struct BakedTextureRecord
+    {
+        uint32_t type{};
+        uint32_t path_size{};
+    };
+
+
+    struct BakedModelHeader
+    {
+        std::array<char, 4> magic{};
+        uint32_t version{};
+
+        uint32_t vertex_stride{};
+        uint32_t index_stride{};
+        uint32_t mesh_stride{};
+        uint32_t surface_map_stride{};
+
+        int64_t source_write_time{};
+        uint64_t source_size{};
+        uint64_t source_hash{};
+
+        BakedSection vertices{};
+        BakedSection indices{};
+        BakedSection meshes{};
+        BakedSection surface_maps{};
+        BakedSection textures{};
+    };
+
+
+    static_assert( std::is_trivially_copyable_v<Vertex> && std::is_trivially_copyable_v<Mesh> &&
+                   std::is_trivially_copyable_v<SurfaceMap>, "baked tables are copied as raw bytes" );
+
+
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    struct SourceStamp
+    {
+        int64_t write_time{};
+        uint64_t size{};
+    };
+
+
+    [[nodiscard]] static SourceStamp stamp_source( std::filesystem::path const& path )
+    {
+        std::error_code error{};
+        auto const write_time = std::filesystem::last_write_time( path, error );
+        if ( error )
+        {
+            return {};
+        }
+        auto const size = std::filesystem::file_size( path, error );
+        if ( error )
+        {
+            return {};
+        }
+        return { static_cast<int64_t>( write_time.time_since_epoch( ).count( ) ), static_cast<uint64_t>( size ) };
+    }
+
+
+    [[nodiscard]] static uint64_t align_section( uint64_t const offset )
+    {
+        return ( offset + SECTION_ALIGNMENT - 1u ) & ~( SECTION_ALIGNMENT - 1u );
+    }
+
+
+    template <typename data_t>
+    [[nodiscard]] static bool copy_section( io::MappedFile const& blob, BakedSection const& section, std::vector<data_t>& dst )
+    {
+        if ( section.offset > blob.size( ) || section.count > ( blob.size( ) - section.offset ) / sizeof( data_t ) )
+        {
+            return false;
+        }
+        dst.resize( section.count );
+        std::memcpy( dst.data( ), blob.data( ) + section.offset, section.count * sizeof( data_t ) );
+        return true;
+    }
+
+
+    // +---------------------------+
+    // | MODEL LOADER              |
+    // +---------------------------+
+    BakedModelLoader::BakedModelLoader( std::filesystem::path source_path )
+        : ModelLoader{ std::move( source_path ) }
+        , cache_path_{ model_path_.string( ) + std::string{ BAKED_MODEL_EXTENSION } } { }
+
+
+    void BakedModelLoader::load( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
+                                 std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures ) const
+    {
+        if ( bool stamp_outdated{ false }; read_cache( vertices, indices, meshes, surface_maps, textures, stamp_outdated ) )
+        {
+            // The source was touched without changing, refresh the stamp so the next launch skips hashing it.
+            if ( stamp_outdated )
+            {
+                write_cache( vertices, indices, meshes, surface_maps, textures );
+            }
+            return;
+        }
+
+        // A rejected cache may have filled some of the tables already.
+        vertices.clear( );
+        indices.clear( );
+        meshes.clear( );
+        surface_maps.clear( );
+        textures.clear( );
+
+        log::loginfo<BakedModelLoader>( "load", std::format( "baking model cache: {}", cache_path_.string( ) ) );
+        AssimpModelLoader{ model_path_ }.load( vertices, indices, meshes, surface_maps, textures );
+        write_cache( vertices, indices, meshes, surface_maps, textures );
+    }
+
+
+    std::filesystem::path const& BakedModelLoader::cache_path( ) const
+    {
+        return cache_path_;
+    }
+
+
+    bool BakedModelLoader::read_cache( std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Mesh>& meshes,
+                                       std::vector<SurfaceMap>& surface_maps, std::vector<TextureGroup>& textures,
+                                       bool& stamp_outdated ) const
+    {
+        io::MappedFile const blob{ cache_path_ };
+        if ( not blob.is_open( ) || blob.size( ) < sizeof( BakedModelHeader ) )
+        {
+            return false;
+        }
+
+        // 1. Validate the layout the blob was written with.
+        BakedModelHeader header{};
+        std::memcpy( &header, blob.data( ), sizeof( BakedModelHeader ) );
+
+        if ( header.magic != BAKED_MODEL_MAGIC || header.version != BAKED_MODEL_VERSION ||
+             header.vertex_stride != sizeof( Vertex ) || header.index_stride != sizeof( uint32_t ) ||
+             header.mesh_stride != sizeof( Mesh ) || header.surface_map_stride != sizeof( SurfaceMap ) )
+        {
+            return false;
+        }
+
+        // 2. Validate the source, the content hash is only computed when the cheap stamp does not match.
+        auto const [write_time, size] = stamp_source( model_path_ );
+        stamp_outdated                = header.source_write_time != write_time || header.source_size != size;
+        if ( stamp_outdated && header.source_hash != io::hash_file( model_path_ ) )
+        {
+            return false;
+        }
+
+        // 3. Copy the tables out of the mapping.
+        if ( not copy_section( blob, header.vertices, vertices ) || not copy_section( blob, header.indices, indices ) ||
+             not copy_section( blob, header.meshes, meshes ) || not copy_section( blob, header.surface_maps, surface_maps ) )
+        {
+            return false;
+        }
+
+        uint64_t offset = header.textures.offset;
+        textures.reserve( header.textures.count );
+        for ( uint64_t i{}; i < header.textures.count; ++i )
+        {
+            BakedTextureRecord record{};
+            if ( offset + sizeof( BakedTextureRecord ) > blob.size( ) )
+            {
+                return false;
+            }
+            std::memcpy( &record, blob.data( ) + offset, sizeof( BakedTextureRecord ) );
+            offset += sizeof( BakedTextureRecord );
+
+            if ( offset + record.path_size > blob.size( ) )
+            {
+                return false;
+            }
+            std::string_view const relative_path{ reinterpret_cast<char const*>( blob.data( ) + offset ), record.path_size };
+            offset += record.path_size;
+
+            textures.emplace_back( static_cast<TextureType>( record.type ), base_path_ / relative_path );
+        }
+        return true;
+    }
+
+
+    void BakedModelLoader::write_cache( std::span<Vertex const> const vertices, std::span<uint32_t const> const indices,
+                                        std::span<Mesh const> const meshes, std::span<SurfaceMap const> const surface_maps,
+                                        std::span<TextureGroup const> const textures ) const
+    {
+        auto const [write_time, size] = stamp_source( model_path_ );
+
+        BakedModelHeader header{
+            .magic = BAKED_MODEL_MAGIC,
+            .version = BAKED_MODEL_VERSION,
+            .vertex_stride = sizeof( Vertex ),
+            .index_stride = sizeof( uint32_t ),
+            .mesh_stride = sizeof( Mesh ),
+            .surface_map_stride = sizeof( SurfaceMap ),
+            .source_write_time = write_time,
+            .source_size = size,
+            .source_hash = io::hash_file( model_path_ ),
+        };
+
+        // 1. Lay the blob out in memory.
+        std::vector<std::byte> blob( sizeof( BakedModelHeader ) );
+        auto const append = [&blob]( void const* data, size_t const data_size )
+            {
+                auto const* bytes = static_cast<std::byte const*>( data );
+                blob.insert( blob.end( ), bytes, bytes + data_size );
+            };
+        auto const append_section = [&blob, &append]( auto const table )
+            {
+                blob.resize( align_section( blob.size( ) ) );
+                BakedSection const section{ .offset = blob.size( ), .count = table.size( ) };
+                append( table.data( ), table.size_bytes( ) );
+                return section;
+            };
+
+        header.vertices     = append_section( vertices );
+        header.indices      = append_section( indices );
+        header.meshes       = append_section( meshes );
+        header.surface_maps = append_section( surface_maps );
+
+        blob.resize( align_section( blob.size( ) ) );
+        header.textures = { .offset = blob.size( ), .count = textures.size( ) };
+        for ( auto const& [type, path] : textures )
+        {
+            std::string const relative_path = path.lexically_relative( base_path_ ).generic_string( );
+            BakedTextureRecord const record{
+                .type = static_cast<uint32_t>( type ),
+                .path_size = static_cast<uint32_t>( relative_path.size( ) )
+            };
+            append( &record, sizeof( BakedTextureRecord ) );
+            append( relative_path.data( ), relative_path.size( ) );
+        }
+        std::memcpy( blob.data( ), &header, sizeof( BakedModelHeader ) );
+
+        // 2. Write to a temporary file first, a crash mid-write must never leave a truncated cache behind.
+        std::filesystem::path const temp_path{ cache_path_.string( ) + ".tmp" };
+        {
+            std::ofstream file{ temp_path, std::ios::binary | std::ios::trunc };
+            file.write( reinterpret_cast<char const*>( blob.data( ) ), static_cast<std::streamsize>( blob.size( ) ) );
+            if ( not file )
+            {
+                log::logerr<BakedModelLoader>( "write_cache", std::format( "failed to write: {}", temp_path.string( ) ) );
+                return;
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename( temp_path, cache_path_, error );
+        log::logerr<BakedModelLoader>( "write_cache", std::format( "failed to replace: {}", cache_path_.string( ) ),
+                                       static_cast<bool>( error ) );
+    }
+
+}
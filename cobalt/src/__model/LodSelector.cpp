@@ -0,0 +1,81 @@
+#include <__model/LodSelector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+
+namespace cobalt
+{
+    LodSelector::LodSelector( glm::mat4 const& view, glm::mat4 const& projection, float const viewport_height,
+                              float const pixel_threshold, uint32_t const lod_bias ) noexcept
+        : orthographic_{ projection[3][3] == 1.f }
+        , pixels_per_unit_{ std::abs( projection[1][1] ) * viewport_height * 0.5f }
+        , pixel_threshold_{ pixel_threshold }
+        , lod_bias_{ lod_bias }
+    {
+        // The view matrix is a rigid transform, the eye is its translation rotated back to world space.
+        glm::vec3 const translation{ view[3] };
+        eye_ = -glm::vec3{ glm::dot( glm::vec3{ view[0] }, translation ), glm::dot( glm::vec3{ view[1] }, translation ),
+                           glm::dot( glm::vec3{ view[2] }, translation ) };
+    }
+
+
+    uint32_t LodSelector::select( Mesh const& mesh ) const noexcept
+    {
+        assert( mesh.lod_count > 0u && "LodSelector::select: mesh has no levels of detail!" );
+
+        float pixels_per_unit = pixels_per_unit_;
+        if ( not orthographic_ )
+        {
+            // Inside the bounding sphere everything may be right in front of the camera, keep the full detail.
+            float const distance = glm::length( mesh.bounds_center - eye_ ) - mesh.bounds_radius;
+            pixels_per_unit      = distance > 0.f ? pixels_per_unit_ / distance : std::numeric_limits<float>::max( );
+        }
+
+        uint32_t lod{ 0u };
+        while ( lod + 1u < mesh.lod_count && mesh.lods[lod + 1u].error * pixels_per_unit <= pixel_threshold_ )
+        {
+            ++lod;
+        }
+        return std::min( lod + lod_bias_, mesh.lod_count - 1u );
+    }
+
+
+    MeshLod const& LodSelector::select_lod( Mesh const& mesh ) const noexcept
+    {
+        return mesh.lods[select( mesh )];
+    }
+
+
+    glm::vec3 const& LodSelector::eye( ) const noexcept
+    {
+        return eye_;
+    }
+
+
+    bool LodSelector::orthographic( ) const noexcept
+    {
+        return orthographic_;
+    }
+
+
+    float LodSelector::pixels_per_unit( ) const noexcept
+    {
+        return pixels_per_unit_;
+    }
+
+
+    float LodSelector::pixel_threshold( ) const noexcept
+    {
+        return pixel_threshold_;
+    }
+
+
+    uint32_t LodSelector::lod_bias( ) const noexcept
+    {
+        return lod_bias_;
+    }
+
+}
@@ -1,14 +1,108 @@
 #include <log.h>
 #include <__model/Model.h>
 
+#include <__buffer/CommandOperator.h>
+#include <__buffer/UploadContext.h>
 #include <__builder/ModelLoader.h>
+#include <__context/DeviceSet.h>
+#include <__image/Ktx2ImageLoader.h>
+#include <__image/StbImageLoader.h>
+#include <__image/TextureBaker.h>
+#include <__model/PackedVertex.h>
+#include <__pipeline/Pipeline.h>
+#include <__thread/WorkerPool.h>
 
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <numbers>
 
 
 namespace cobalt
 {
-    Model::Model( DeviceSet const& device, CommandPool& cmd_pool, loader::ModelLoader<Vertex, index_t> const& loader )
+    [[nodiscard]] static VkFormat to_texture_format( TextureType const type )
+    {
+        switch ( type )
+        {
+            case TextureType::BASE_COLOR:
+            case TextureType::METALNESS:
+            case TextureType::ROUGHNESS:
+            case TextureType::AO:
+                return VK_FORMAT_R8G8B8A8_SRGB;
+            case TextureType::NORMAL:
+                return VK_FORMAT_R8G8B8A8_UNORM;
+            default:
+                throw std::runtime_error( "unsupported texture type" );
+        }
+    }
+
+
+    [[nodiscard]] static image::TextureBakeInfo to_bake_info( TextureType const type )
+    {
+        // Single channel maps keep the channel the shaders sample them from. Their sources are uploaded as sRGB on the
+        // uncompressed path, so they are linearized before encoding to sample the same values.
+        switch ( type )
+        {
+            case TextureType::BASE_COLOR:
+                return { .format = VK_FORMAT_BC7_SRGB_BLOCK };
+            case TextureType::NORMAL:
+                return { .format = VK_FORMAT_BC5_UNORM_BLOCK };
+            case TextureType::METALNESS:
+                return { .format = VK_FORMAT_BC4_UNORM_BLOCK, .source_channel = 2u, .linearize_source = true };
+            case TextureType::ROUGHNESS:
+                return { .format = VK_FORMAT_BC4_UNORM_BLOCK, .source_channel = 1u, .linearize_source = true };
+            case TextureType::AO:
+                return { .format = VK_FORMAT_BC4_UNORM_BLOCK, .source_channel = 0u, .linearize_source = true };
+            default:
+                throw std::runtime_error( "unsupported texture type" );
+        }
+    }
+
+
+    // Mirrors the std430 layout of MeshCullData in the draw culling shader.
+    struct MeshCullData
+    {
+        glm::vec4 sphere{ 0.f };
+        glm::vec3 aabb_min{ 0.f };
+        uint32_t lod_count{ 0u };
+        glm::vec3 aabb_max{ 0.f };
+        int32_t vertex_offset{ 0 };
+        glm::vec4 lod_errors{ 0.f };
+        glm::uvec4 lod_index_counts{ 0u };
+        glm::uvec4 lod_index_offsets{ 0u };
+        uint32_t material_index{ 0u };
+        uint32_t batch{ 0u };
+        uint32_t batch_first_draw{ 0u };
+        uint32_t padding{ 0u };
+    };
+
+
+    static_assert( sizeof( MeshCullData ) == 112u && Mesh::MAX_LOD_COUNT == 4u,
+                   "MeshCullData has to match the draw culling shader" );
+    static_assert( sizeof( DrawCullConstants ) <= 128u, "push constants are only guaranteed up to 128 bytes" );
+
+
+    [[nodiscard]] static std::array<glm::vec4, 6> make_frustum_planes( glm::mat4 const& view_projection )
+    {
+        // Rows of the matrix combined as in Gribb and Hartmann, the depth range is [0, 1] so the near plane is the third row.
+        glm::mat4 const rows = glm::transpose( view_projection );
+        std::array planes{
+            rows[3] + rows[0], rows[3] - rows[0],
+            rows[3] + rows[1], rows[3] - rows[1],
+            rows[2], rows[3] - rows[2]
+        };
+        for ( glm::vec4& plane : planes )
+        {
+            plane /= glm::length( glm::vec3{ plane } );
+        }
+        return planes;
+    }
+
+
+    Model::Model( DeviceSet const& device, CommandPool& cmd_pool, loader::ModelLoader<Vertex, index_t> const& loader,
+                  ModelCreateInfo const& create_info )
     {
         std::vector<Vertex> vertices{};
         std::vector<index_t> indices{};
@@ -17,17 +111,20 @@ namespace cobalt
 
         loader.load( vertices, indices, meshes_, surface_maps, textures );
 
+        // Every copy and layout transition of the model is recorded in one batch and submitted once.
+        UploadContext upload_context{ device, cmd_pool };
+
         // Create buffers
-        index_buffer_ptr_ = std::make_unique<Buffer>(
-            buffer::make_index_buffer<index_t>( device, cmd_pool, indices )
-        );
-        vertex_buffer_ptr_ = std::make_unique<Buffer>(
-            buffer::make_vertex_buffer<Vertex>( device, cmd_pool, vertices )
-        );
-
-        create_texture_images( device, cmd_pool, textures );
-        create_materials_buffer( device, cmd_pool, surface_maps );
+        create_index_buffer( upload_context, indices );
+        create_vertex_buffer( upload_context, vertices, create_info.vertex_layout );
+        create_draw_buffers( upload_context, create_info.draw_view_count );
+
+        create_texture_images( upload_context, textures, create_info );
+        create_materials_buffer( upload_context, surface_maps );
         calculate_aabb( vertices );
+
+        // The model is expected to be usable once constructed, so the CPU side only blocks once for the whole batch.
+        upload_context.submit( ).wait( );
     }
 
 
@@ -43,6 +140,12 @@ namespace cobalt
     }
 
 
+    VertexLayout Model::vertex_layout( ) const
+    {
+        return vertex_layout_;
+    }
+
+
     Buffer const& Model::index_buffer( ) const
     {
         return *index_buffer_ptr_;
@@ -67,51 +170,417 @@ namespace cobalt
     }
 
 
-    void Model::create_texture_images( DeviceSet const& device, CommandPool& cmd_pool, std::span<TextureGroup const> textures )
+    Buffer const& Model::draw_buffer( ) const
+    {
+        return *draw_buffer_ptr_;
+    }
+
+
+    VkDeviceSize Model::draw_offset( uint32_t const view ) const
+    {
+        assert( view < draw_view_count_ && "Model::draw_offset: view out of range!" );
+        return static_cast<VkDeviceSize>( view ) * meshes_.size( ) * sizeof( VkDrawIndexedIndirectCommand );
+    }
+
+
+    std::span<DrawBatch const> Model::draw_batches( ) const
     {
-        std::set<std::string> texture_paths{};
-        for ( auto const& [type, path] : textures )
+        return draw_batches_;
+    }
+
+
+    Buffer const& Model::draw_count_buffer( ) const
+    {
+        return *draw_count_buffer_ptr_;
+    }
+
+
+    VkDeviceSize Model::draw_count_offset( uint32_t const view, size_t const batch ) const
+    {
+        assert( view < draw_view_count_ && batch < draw_batches_.size( ) && "Model::draw_count_offset: out of range!" );
+        return ( static_cast<VkDeviceSize>( view ) * draw_batches_.size( ) + batch ) * sizeof( uint32_t );
+    }
+
+
+    Buffer const& Model::mesh_cull_buffer( ) const
+    {
+        return *mesh_cull_buffer_ptr_;
+    }
+
+
+    void Model::record_draw_culling( CommandOperator const& command_op, Pipeline const& cull_pipeline, uint32_t const view,
+                                     glm::mat4 const& view_projection, LodSelector const& lod_selector ) const
+    {
+        assert( view < draw_view_count_ && "Model::record_draw_culling: view out of range!" );
+        if ( draw_batches_.empty( ) )
+        {
+            return;
+        }
+        auto const mesh_count = static_cast<uint32_t>( meshes_.size( ) );
+
+        // 1. Every batch of the view starts out empty.
+        VkDeviceSize const count_offset = draw_count_offset( view, 0u );
+        VkDeviceSize const count_size   = draw_batches_.size( ) * sizeof( uint32_t );
+        command_op.fill_buffer( *draw_count_buffer_ptr_, count_offset, count_size, 0u );
+
+        VkMemoryBarrier2 const clear_barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+        };
+        command_op.insert_barrier( VkDependencyInfo{
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &clear_barrier
+        } );
+
+        // 2. One invocation per mesh. The threshold is folded into the scale, a level fits once its projected error is one.
+        float const lod_scale = lod_selector.pixels_per_unit( ) / lod_selector.pixel_threshold( );
+        DrawCullConstants const constants{
+            .frustum_planes = make_frustum_planes( view_projection ),
+            .eye_lod_scale = glm::vec4{ lod_selector.eye( ), lod_selector.orthographic( ) ? -lod_scale : lod_scale },
+            .draw_base = static_cast<uint32_t>( draw_offset( view ) / sizeof( VkDrawIndexedIndirectCommand ) ),
+            .count_base = static_cast<uint32_t>( count_offset / sizeof( uint32_t ) ),
+            .mesh_count = mesh_count,
+            .lod_bias = lod_selector.lod_bias( )
+        };
+        command_op.push_constants( cull_pipeline, VK_SHADER_STAGE_COMPUTE_BIT, 0u, sizeof( DrawCullConstants ), &constants );
+        command_op.dispatch( ( mesh_count + DRAW_CULL_GROUP_SIZE - 1u ) / DRAW_CULL_GROUP_SIZE );
+
+        // 3. The indirect draws read the commands and counts.
+        VkMemoryBarrier2 const cull_barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+            .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+        };
+        command_op.insert_barrier( VkDependencyInfo{
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &cull_barrier
+        } );
+    }
+
+
+    bool Model::update_texture_streaming( glm::mat4 const& view, glm::mat4 const& projection, VkExtent2D const viewport,
+                                          uint32_t const frame_index )
+    {
+        if ( not streamer_ptr_ )
         {
-            log::loginfo<Model>( "create_texture_images", std::format( "texture being loaded twice: {}", path.string( ) ),
-                                 texture_paths.contains( path.string( ) ) );
-            texture_paths.insert( path.string( ) );
+            return false;
+        }
 
-            TextureImageCreateInfo create_info{ .path_to_img = path };
-            switch ( type )
+        // 1. Estimate the screen area of every material from the bounding spheres of its meshes. Spheres reaching the eye
+        // cover the whole viewport, spheres behind it nothing.
+        float const pixels_per_unit = std::abs( projection[1][1] ) * static_cast<float>( viewport.height ) * 0.5f;
+        auto const viewport_area    = static_cast<float>( viewport.width ) * static_cast<float>( viewport.height );
+
+        std::vector<float> material_areas( material_textures_.size( ), 0.f );
+        for ( Mesh const& mesh : meshes_ )
+        {
+            float const depth = -( view * glm::vec4{ mesh.bounds_center, 1.f } ).z;
+            if ( depth + mesh.bounds_radius <= 0.f || mesh.material_index >= material_areas.size( ) )
             {
-                case TextureType::BASE_COLOR:
-                case TextureType::METALNESS:
-                case TextureType::ROUGHNESS:
-                case TextureType::AO:
-                    create_info.image_format = VK_FORMAT_R8G8B8A8_SRGB;
-                    break;
-                case TextureType::NORMAL:
-                    create_info.image_format = VK_FORMAT_R8G8B8A8_UNORM;
-                    break;
-                default:
-                    throw std::runtime_error( "unsupported texture type" );
+                continue;
             }
-            textures_.emplace_back( device, cmd_pool, create_info );
+
+            float const radius = mesh.bounds_radius * pixels_per_unit / std::max( depth, mesh.bounds_radius );
+            float const area   = depth > mesh.bounds_radius ? std::numbers::pi_v<float> * radius * radius : viewport_area;
+            material_areas[mesh.material_index] += std::min( area, viewport_area );
         }
+
+        // 2. A texture covers the area of every material sampling it.
+        std::vector<float> texture_areas( textures_.size( ), 0.f );
+        for ( size_t material{}; material < material_textures_.size( ); ++material )
+        {
+            for ( uint32_t const texture_index : material_textures_[material] )
+            {
+                if ( texture_index < texture_areas.size( ) )
+                {
+                    texture_areas[texture_index] += material_areas[material];
+                }
+            }
+        }
+
+        streamer_ptr_->request( texture_areas );
+        return streamer_ptr_->update( textures_, frame_index );
     }
 
 
-    void Model::create_materials_buffer( DeviceSet const& device, CommandPool& cmd_pool,
-                                         std::span<SurfaceMap const> const materials )
+    void Model::create_texture_images( UploadContext& upload_context, std::span<TextureGroup const> textures,
+                                       ModelCreateInfo const& create_info )
     {
-        auto const buffer_size = materials.size_bytes( );
+        using clock_t = std::chrono::steady_clock;
+
+        bool const compress_textures = create_info.compress_textures &&
+                                       upload_context.device( ).has_feature( DeviceFeatureFlags::TEXTURE_COMPRESSION_BC );
 
-        Buffer staging_buffer = buffer::make_staging_buffer( device, buffer_size );
+        // 1. Decode every image into host memory concurrently, this is where most of the load time goes. Compressed
+        // textures are baked on the first load only, afterwards they are mapped straight from disk.
+        std::vector<std::unique_ptr<Ktx2ImageLoader>> baked_images( textures.size( ) );
+        std::vector<std::unique_ptr<StbImageLoader>> decoded_images( textures.size( ) );
+        std::atomic<int64_t> decode_time_ns{ 0 };
+        uint32_t used_threads{};
 
-        staging_buffer.map_memory( );
-        staging_buffer.write( materials.data( ), buffer_size );
-        staging_buffer.unmap_memory( );
+        auto const wall_start = clock_t::now( );
+        {
+            thread::WorkerPool workers{ create_info.decode_thread_count };
+            used_threads = workers.thread_count( );
+
+            workers.parallel_for( textures.size( ), [&]( size_t const index )
+                {
+                    auto const decode_start = clock_t::now( );
+
+                    auto const& [type, path] = textures[index];
+                    if ( compress_textures )
+                    {
+                        image::TextureBakeInfo const bake_info = to_bake_info( type );
+                        std::filesystem::path const baked_path = image::baked_texture_path( path, bake_info );
+
+                        bool baked = not image::is_bake_outdated( path, baked_path );
+                        if ( not baked )
+                        {
+                            log::loginfo<Model>( "create_texture_images",
+                                                 std::format( "baking texture: {}", baked_path.string( ) ) );
+                            baked = image::bake_texture( path, baked_path, bake_info );
+                        }
+                        if ( baked )
+                        {
+                            baked_images[index] = std::make_unique<Ktx2ImageLoader>( baked_path );
+                        }
+                    }
+
+                    // Fall back to the source image if compression is off or the bake could not be produced.
+                    if ( not baked_images[index] || not baked_images[index]->is_valid( ) )
+                    {
+                        baked_images[index].reset( );
+
+                        VkFormat const format = to_texture_format( type );
+                        decoded_images[index] = std::make_unique<StbImageLoader>(
+                            path, image::to_channel_count( format ), image::is_float_texel( format ) );
+                    }
+
+                    decode_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        clock_t::now( ) - decode_start ).count( );
+                } );
+        }
+        auto const wall_time_ms = std::chrono::duration<double, std::milli>( clock_t::now( ) - wall_start ).count( );
+        auto const cpu_time_ms  = static_cast<double>( decode_time_ns.load( ) ) / 1'000'000.0;
+
+        log::loginfo<Model>( "create_texture_images",
+                             std::format( "decoded {} textures on {} threads: {:.1f}ms wall, {:.1f}ms summed ({:.2f}x)",
+                                          textures.size( ), used_threads, wall_time_ms, cpu_time_ms,
+                                          wall_time_ms > 0.0 ? cpu_time_ms / wall_time_ms : 0.0 ) );
+
+        // 2. Record the uploads on the owning thread, the host copy is dropped once it has been staged. Streamed textures only
+        // record their smallest levels, the streamer keeps the baked file mapped for the rest.
+        if ( create_info.stream_textures && std::ranges::any_of( baked_images, []( auto const& ptr ) { return ptr != nullptr; } ) )
+        {
+            streamer_ptr_ = std::make_unique<TextureStreamer>( upload_context.device( ), create_info.streaming );
+        }
+
+        textures_.reserve( textures.size( ) );
+        for ( size_t i{}; i < textures.size( ); ++i )
+        {
+            if ( baked_images[i] && streamer_ptr_ )
+            {
+                textures_.push_back( streamer_ptr_->add( upload_context, static_cast<uint32_t>( i ), std::move( baked_images[i] ) ) );
+            }
+            else if ( baked_images[i] )
+            {
+                textures_.emplace_back( upload_context, *baked_images[i] );
+            }
+            else
+            {
+                textures_.emplace_back( upload_context, *decoded_images[i], to_texture_format( textures[i].type ) );
+            }
+            baked_images[i].reset( );
+            decoded_images[i].reset( );
+        }
+    }
+
+
+    void Model::create_index_buffer( UploadContext& upload_context, std::span<index_t const> const indices )
+    {
+        // Draw the 16-bit meshes first so a pass switches the bound index type once. Both widths share the buffer: the 16-bit
+        // range starts at 0 and the 32-bit range on the next 4 byte boundary, so every mesh binds the buffer at offset 0 and
+        // counts its index offsets in its own width.
+        std::ranges::stable_partition( meshes_, []( Mesh const& mesh ) { return mesh.index_type == VK_INDEX_TYPE_UINT16; } );
+
+        std::vector<uint16_t> short_indices{};
+        std::vector<uint32_t> wide_indices{};
+        for ( Mesh const& mesh : meshes_ )
+        {
+            if ( mesh.index_type != VK_INDEX_TYPE_UINT16 )
+            {
+                continue;
+            }
+            for ( auto const& [index_count, index_offset, error] : std::span{ mesh.lods }.first( mesh.lod_count ) )
+            {
+                std::ranges::transform( indices.subspan( index_offset, index_count ), std::back_inserter( short_indices ),
+                                        []( index_t const index ) { return static_cast<uint16_t>( index ); } );
+            }
+        }
+
+        VkDeviceSize const short_size = short_indices.size( ) * sizeof( uint16_t );
+        VkDeviceSize const wide_begin = ( short_size + sizeof( uint32_t ) - 1u ) & ~VkDeviceSize{ sizeof( uint32_t ) - 1u };
+
+        uint32_t short_offset{ 0u };
+        auto wide_offset = static_cast<uint32_t>( wide_begin / sizeof( uint32_t ) );
+        for ( Mesh& mesh : meshes_ )
+        {
+            for ( MeshLod& lod : std::span{ mesh.lods }.first( mesh.lod_count ) )
+            {
+                if ( mesh.index_type == VK_INDEX_TYPE_UINT16 )
+                {
+                    lod.index_offset = short_offset;
+                    short_offset += lod.index_count;
+                }
+                else
+                {
+                    auto const source = indices.subspan( lod.index_offset, lod.index_count );
+                    wide_indices.insert( wide_indices.end( ), source.begin( ), source.end( ) );
+                    lod.index_offset = wide_offset;
+                    wide_offset += lod.index_count;
+                }
+            }
+        }
+
+        VkDeviceSize const buffer_size = wide_begin + wide_indices.size( ) * sizeof( uint32_t );
+        std::vector<std::byte> data( buffer_size );
+        std::memcpy( data.data( ), short_indices.data( ), short_size );
+        std::memcpy( data.data( ) + wide_begin, wide_indices.data( ), wide_indices.size( ) * sizeof( uint32_t ) );
+
+        index_buffer_ptr_ = std::make_unique<Buffer>( upload_context.device( ), buffer_size,
+                                                      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+        upload_context.upload( *index_buffer_ptr_, data.data( ), buffer_size );
+
+        log::loginfo<Model>( "create_index_buffer",
+                             std::format( "{} indices: {:.1f} KiB, {:.1f} KiB saved over 32-bit indices",
+                                          indices.size( ), static_cast<double>( buffer_size ) / 1024.0,
+                                          static_cast<double>( indices.size_bytes( ) - buffer_size ) / 1024.0 ) );
+    }
+
+
+    void Model::create_draw_buffers( UploadContext& upload_context, uint32_t const view_count )
+    {
+        // 1. The index buffer sorted the meshes by index type, each type is one batch.
+        auto const short_count = static_cast<uint32_t>( std::ranges::count_if(
+            meshes_, []( Mesh const& mesh ) { return mesh.index_type == VK_INDEX_TYPE_UINT16; } ) );
+        auto const mesh_count = static_cast<uint32_t>( meshes_.size( ) );
+        if ( short_count > 0u )
+        {
+            draw_batches_.push_back( DrawBatch{ .index_type = VK_INDEX_TYPE_UINT16, .first_draw = 0u, .draw_count = short_count } );
+        }
+        if ( short_count < mesh_count )
+        {
+            draw_batches_.push_back( DrawBatch{
+                .index_type = VK_INDEX_TYPE_UINT32, .first_draw = short_count, .draw_count = mesh_count - short_count
+            } );
+        }
+
+        // 2. Only ever written by the culling shader, which clears the counts before every pass.
+        draw_view_count_ = std::max( view_count, 1u );
+        VkDeviceSize const draw_size = std::max<VkDeviceSize>(
+            static_cast<VkDeviceSize>( draw_view_count_ ) * mesh_count * sizeof( VkDrawIndexedIndirectCommand ),
+            sizeof( VkDrawIndexedIndirectCommand ) );
+        draw_buffer_ptr_ = std::make_unique<Buffer>( upload_context.device( ), draw_size,
+                                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+        VkDeviceSize const count_size = std::max<VkDeviceSize>(
+            static_cast<VkDeviceSize>( draw_view_count_ ) * draw_batches_.size( ) * sizeof( uint32_t ), sizeof( uint32_t ) );
+        draw_count_buffer_ptr_ = std::make_unique<Buffer>(
+            upload_context.device( ), count_size,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+        // 3. The culling shader reads everything it needs of a mesh from one entry.
+        std::vector<MeshCullData> cull_data( std::max( mesh_count, 1u ) );
+        for ( uint32_t batch{}; batch < draw_batches_.size( ); ++batch )
+        {
+            DrawBatch const& draw_batch = draw_batches_[batch];
+            for ( uint32_t i = draw_batch.first_draw; i < draw_batch.first_draw + draw_batch.draw_count; ++i )
+            {
+                Mesh const& mesh = meshes_[i];
+                MeshCullData& data = cull_data[i];
+                data.sphere           = glm::vec4{ mesh.bounds_center, mesh.bounds_radius };
+                data.aabb_min         = mesh.bounds_min;
+                data.aabb_max         = mesh.bounds_max;
+                data.lod_count        = mesh.lod_count;
+                data.vertex_offset    = mesh.vertex_offset;
+                data.material_index   = mesh.material_index;
+                data.batch            = batch;
+                data.batch_first_draw = draw_batch.first_draw;
+                for ( uint32_t lod{}; lod < mesh.lod_count; ++lod )
+                {
+                    data.lod_errors[lod]        = mesh.lods[lod].error;
+                    data.lod_index_counts[lod]  = mesh.lods[lod].index_count;
+                    data.lod_index_offsets[lod] = mesh.lods[lod].index_offset;
+                }
+            }
+        }
+
+        VkDeviceSize const cull_size = cull_data.size( ) * sizeof( MeshCullData );
+        mesh_cull_buffer_ptr_ = std::make_unique<Buffer>( upload_context.device( ), cull_size,
+                                                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+        upload_context.upload( *mesh_cull_buffer_ptr_, cull_data.data( ), cull_size );
+    }
+
+
+    void Model::create_vertex_buffer( UploadContext& upload_context, std::span<Vertex const> const vertices,
+                                      VertexLayout const layout )
+    {
+        vertex_layout_ = layout;
+        if ( layout == VertexLayout::PACKED )
+        {
+            std::vector<PackedVertex> packed_vertices( vertices.size( ) );
+            std::ranges::transform( vertices, packed_vertices.begin( ), &PackedVertex::pack );
+
+            vertex_buffer_ptr_ = std::make_unique<Buffer>(
+                buffer::make_vertex_buffer<PackedVertex>( upload_context, packed_vertices )
+            );
+        }
+        else
+        {
+            vertex_buffer_ptr_ = std::make_unique<Buffer>(
+                buffer::make_vertex_buffer<Vertex>( upload_context, vertices )
+            );
+        }
+
+        VkDeviceSize const full_size = vertices.size_bytes( );
+        VkDeviceSize const used_size = vertex_buffer_ptr_->buffer_size( );
+        log::loginfo<Model>( "create_vertex_buffer",
+                             std::format( "{} vertices: {:.1f} KiB ({} bytes per vertex), {:.1f} KiB saved over the full layout",
+                                          vertices.size( ), static_cast<double>( used_size ) / 1024.0,
+                                          vertices.empty( ) ? 0u : used_size / vertices.size( ),
+                                          static_cast<double>( full_size - used_size ) / 1024.0 ) );
+    }
+
+
+    void Model::create_materials_buffer( UploadContext& upload_context, std::span<SurfaceMap const> const materials )
+    {
+        material_textures_.reserve( materials.size( ) );
+        for ( SurfaceMap const& material : materials )
+        {
+            material_textures_.push_back( {
+                material.base.indices.x, material.base.indices.y, material.base.indices.z, material.base.indices.w,
+                material.extra.indices.x
+            } );
+        }
+
+        auto const buffer_size = materials.size_bytes( );
 
-        surface_buffer_ptr_ = std::make_unique<Buffer>( device, buffer_size,
+        surface_buffer_ptr_ = std::make_unique<Buffer>( upload_context.device( ), buffer_size,
                                                         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
 
-        staging_buffer.copy_to( *surface_buffer_ptr_, cmd_pool );
+        upload_context.upload( *surface_buffer_ptr_, materials.data( ), buffer_size );
     }
 
 
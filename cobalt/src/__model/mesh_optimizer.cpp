@@ -0,0 +1,321 @@
+#include <__model/mesh_optimizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+
+namespace cobalt::mesh
+{
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    // Tuning constants from Forsyth's "Linear-Speed Vertex Cache Optimisation".
+    static constexpr float CACHE_DECAY_POWER{ 1.5f };
+    static constexpr float LAST_TRIANGLE_SCORE{ 0.75f };
+    static constexpr float VALENCE_BOOST_SCALE{ 2.0f };
+    static constexpr float VALENCE_BOOST_POWER{ 0.5f };
+
+    static constexpr size_t NO_TRIANGLE{ std::numeric_limits<size_t>::max( ) };
+
+
+    [[nodiscard]] static float vertex_score( int32_t const cache_position, uint32_t const live_triangles )
+    {
+        if ( live_triangles == 0u )
+        {
+            return -1.0f;
+        }
+
+        float score{ 0.0f };
+        if ( cache_position >= 0 )
+        {
+            // The vertices of the last triangle get a fixed score, so the next one does not simply reuse its edge.
+            if ( cache_position < 3 )
+            {
+                score = LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                constexpr float scaler = 1.0f / static_cast<float>( VERTEX_CACHE_SIZE - 3u );
+                score = std::pow( 1.0f - static_cast<float>( cache_position - 3 ) * scaler, CACHE_DECAY_POWER );
+            }
+        }
+
+        // Vertices with few triangles left are boosted, finishing them early frees the cache.
+        score += VALENCE_BOOST_SCALE * std::pow( static_cast<float>( live_triangles ), -VALENCE_BOOST_POWER );
+        return score;
+    }
+
+
+    // +---------------------------+
+    // | OPTIMIZER                 |
+    // +---------------------------+
+    void optimize_vertex_cache( std::span<uint32_t> const indices, uint32_t const vertex_count )
+    {
+        size_t const triangle_count = indices.size( ) / 3u;
+        if ( triangle_count == 0u )
+        {
+            return;
+        }
+
+        // 1. Build the vertex to triangle adjacency as one flat table, the live triangles of a vertex are kept at the front
+        // of its range.
+        std::vector<uint32_t> live_triangles( vertex_count, 0u );
+        for ( uint32_t const index : indices )
+        {
+            assert( index < vertex_count && "mesh::optimize_vertex_cache: index out of range!" );
+            ++live_triangles[index];
+        }
+
+        std::vector<uint32_t> adjacency_offsets( vertex_count + 1u, 0u );
+        for ( uint32_t vertex{}; vertex < vertex_count; ++vertex )
+        {
+            adjacency_offsets[vertex + 1u] = adjacency_offsets[vertex] + live_triangles[vertex];
+        }
+
+        std::vector<uint32_t> adjacency( indices.size( ) );
+        {
+            std::vector<uint32_t> cursors( adjacency_offsets.begin( ), std::prev( adjacency_offsets.end( ) ) );
+            for ( size_t i{}; i < indices.size( ); ++i )
+            {
+                adjacency[cursors[indices[i]]++] = static_cast<uint32_t>( i / 3u );
+            }
+        }
+
+        // 2. Score every vertex outside of the cache and every triangle as the sum of its vertices.
+        std::vector<int32_t> cache_positions( vertex_count, -1 );
+        std::vector<float> vertex_scores( vertex_count );
+        for ( uint32_t vertex{}; vertex < vertex_count; ++vertex )
+        {
+            vertex_scores[vertex] = vertex_score( -1, live_triangles[vertex] );
+        }
+
+        std::vector<float> triangle_scores( triangle_count );
+        for ( size_t triangle{}; triangle < triangle_count; ++triangle )
+        {
+            triangle_scores[triangle] = vertex_scores[indices[triangle * 3u]] + vertex_scores[indices[triangle * 3u + 1u]] +
+                                        vertex_scores[indices[triangle * 3u + 2u]];
+        }
+
+        // 3. Greedily emit the best scoring triangle. Only triangles touching the cache are candidates after the first one,
+        // when none is left the scan resumes at the first triangle not emitted yet.
+        std::vector<uint32_t> output{};
+        output.reserve( indices.size( ) );
+        std::vector<bool> emitted( triangle_count, false );
+
+        std::array<uint32_t, VERTEX_CACHE_SIZE + 3u> cache{};
+        std::array<uint32_t, VERTEX_CACHE_SIZE + 3u> next_cache{};
+        uint32_t cache_count{ 0u };
+
+        size_t best_triangle = static_cast<size_t>(
+            std::distance( triangle_scores.begin( ), std::ranges::max_element( triangle_scores ) ) );
+        size_t scan_cursor{ 0u };
+
+        for ( size_t emitted_count{}; emitted_count < triangle_count; ++emitted_count )
+        {
+            if ( best_triangle == NO_TRIANGLE )
+            {
+                while ( emitted[scan_cursor] )
+                {
+                    ++scan_cursor;
+                }
+                best_triangle = scan_cursor;
+            }
+            emitted[best_triangle] = true;
+
+            // Emit the triangle, retire it from the adjacency of its vertices and move them to the front of the cache.
+            uint32_t next_count{ 0u };
+            for ( size_t corner{}; corner < 3u; ++corner )
+            {
+                uint32_t const vertex = indices[best_triangle * 3u + corner];
+                output.push_back( vertex );
+
+                auto const live_begin = std::next( adjacency.begin( ), adjacency_offsets[vertex] );
+                auto const live_end   = std::next( live_begin, live_triangles[vertex] );
+                std::iter_swap( std::find( live_begin, live_end, static_cast<uint32_t>( best_triangle ) ),
+                                std::prev( live_end ) );
+                --live_triangles[vertex];
+
+                if ( std::find( next_cache.begin( ), std::next( next_cache.begin( ), next_count ), vertex ) ==
+                     std::next( next_cache.begin( ), next_count ) )
+                {
+                    next_cache[next_count++] = vertex;
+                }
+            }
+            for ( uint32_t i{}; i < cache_count; ++i )
+            {
+                uint32_t const vertex = cache[i];
+                if ( std::find( next_cache.begin( ), std::next( next_cache.begin( ), next_count ), vertex ) ==
+                     std::next( next_cache.begin( ), next_count ) )
+                {
+                    next_cache[next_count++] = vertex;
+                }
+            }
+
+            // Rescore the touched vertices, including the ones just pushed out of the cache, and propagate the change to
+            // their live triangles.
+            for ( uint32_t i{}; i < next_count; ++i )
+            {
+                uint32_t const vertex = next_cache[i];
+                cache_positions[vertex] = i < VERTEX_CACHE_SIZE ? static_cast<int32_t>( i ) : -1;
+
+                float const score = vertex_score( cache_positions[vertex], live_triangles[vertex] );
+                float const delta = score - vertex_scores[vertex];
+                vertex_scores[vertex] = score;
+
+                for ( uint32_t live{}; live < live_triangles[vertex]; ++live )
+                {
+                    triangle_scores[adjacency[adjacency_offsets[vertex] + live]] += delta;
+                }
+            }
+            cache_count = std::min( next_count, VERTEX_CACHE_SIZE );
+            std::copy_n( next_cache.begin( ), cache_count, cache.begin( ) );
+
+            // Pick the next triangle among the ones sharing a cached vertex.
+            best_triangle = NO_TRIANGLE;
+            float best_score{ -std::numeric_limits<float>::max( ) };
+            for ( uint32_t i{}; i < cache_count; ++i )
+            {
+                uint32_t const vertex = cache[i];
+                for ( uint32_t live{}; live < live_triangles[vertex]; ++live )
+                {
+                    uint32_t const triangle = adjacency[adjacency_offsets[vertex] + live];
+                    if ( triangle_scores[triangle] > best_score )
+                    {
+                        best_score    = triangle_scores[triangle];
+                        best_triangle = triangle;
+                    }
+                }
+            }
+        }
+
+        std::ranges::copy( output, indices.begin( ) );
+    }
+
+
+    std::vector<uint32_t> optimize_vertex_fetch( std::span<uint32_t> const indices, uint32_t const vertex_count )
+    {
+        std::vector<uint32_t> remap( vertex_count, UNUSED_VERTEX );
+
+        uint32_t next_vertex{ 0u };
+        for ( uint32_t& index : indices )
+        {
+            assert( index < vertex_count && "mesh::optimize_vertex_fetch: index out of range!" );
+            if ( remap[index] == UNUSED_VERTEX )
+            {
+                remap[index] = next_vertex++;
+            }
+            index = remap[index];
+        }
+        return remap;
+    }
+
+
+    std::vector<uint32_t> simplify_clustered( std::span<uint32_t const> const indices, std::span<glm::vec3 const> const positions,
+                                              std::span<glm::vec3 const> const normals, float const cell_size )
+    {
+        assert( positions.size( ) == normals.size( ) && "mesh::simplify_clustered: attribute count mismatch!" );
+        assert( cell_size > 0.f && "mesh::simplify_clustered: cell size must be positive!" );
+
+        glm::vec3 min_position{ std::numeric_limits<float>::max( ) };
+        for ( glm::vec3 const& position : positions )
+        {
+            min_position = glm::min( min_position, position );
+        }
+
+        // 1. Assign every vertex to a cluster: 20 bits per grid axis and the dominant normal axis with its sign.
+        std::unordered_map<uint64_t, uint32_t> cluster_lookup{};
+        std::vector<uint32_t> vertex_clusters( positions.size( ) );
+        std::vector<glm::vec3> cluster_sums{};
+        for ( size_t vertex{}; vertex < positions.size( ); ++vertex )
+        {
+            glm::uvec3 const cell{ glm::min( ( positions[vertex] - min_position ) / cell_size, glm::vec3{ 1048575.f } ) };
+
+            glm::vec3 const normal = glm::abs( normals[vertex] );
+            uint64_t const axis    = normal.x >= normal.y && normal.x >= normal.z ? 0u : normal.y >= normal.z ? 1u : 2u;
+            uint64_t const facing  = axis * 2u + ( normals[vertex][static_cast<glm::length_t>( axis )] < 0.f ? 1u : 0u );
+
+            uint64_t const key = static_cast<uint64_t>( cell.x ) | static_cast<uint64_t>( cell.y ) << 20u |
+                                 static_cast<uint64_t>( cell.z ) << 40u | facing << 60u;
+
+            auto const [it, inserted] = cluster_lookup.try_emplace( key, static_cast<uint32_t>( cluster_sums.size( ) ) );
+            if ( inserted )
+            {
+                cluster_sums.emplace_back( 0.f );
+            }
+            vertex_clusters[vertex] = it->second;
+            cluster_sums[it->second] += positions[vertex];
+        }
+
+        // 2. Elect the vertex closest to the cluster mean, so the simplified surface stays on the original one.
+        std::vector<uint32_t> cluster_counts( cluster_sums.size( ), 0u );
+        for ( uint32_t const cluster : vertex_clusters )
+        {
+            ++cluster_counts[cluster];
+        }
+
+        std::vector<uint32_t> representatives( cluster_sums.size( ), UNUSED_VERTEX );
+        std::vector<float> best_distances( cluster_sums.size( ), std::numeric_limits<float>::max( ) );
+        for ( size_t vertex{}; vertex < positions.size( ); ++vertex )
+        {
+            uint32_t const cluster = vertex_clusters[vertex];
+            glm::vec3 const mean   = cluster_sums[cluster] / static_cast<float>( cluster_counts[cluster] );
+
+            glm::vec3 const delta = positions[vertex] - mean;
+            if ( float const distance = glm::dot( delta, delta ); distance < best_distances[cluster] )
+            {
+                best_distances[cluster]  = distance;
+                representatives[cluster] = static_cast<uint32_t>( vertex );
+            }
+        }
+
+        // 3. Keep the triangles whose corners still land in three different clusters.
+        std::vector<uint32_t> simplified{};
+        simplified.reserve( indices.size( ) );
+        for ( size_t corner{}; corner + 2u < indices.size( ); corner += 3u )
+        {
+            uint32_t const a = vertex_clusters[indices[corner]];
+            uint32_t const b = vertex_clusters[indices[corner + 1u]];
+            uint32_t const c = vertex_clusters[indices[corner + 2u]];
+            if ( a != b && b != c && a != c )
+            {
+                simplified.insert( simplified.end( ), { representatives[a], representatives[b], representatives[c] } );
+            }
+        }
+        return simplified;
+    }
+
+
+    bool fits_short_indices( uint32_t const vertex_count )
+    {
+        return vertex_count <= MAX_SHORT_INDEX_VERTEX_COUNT;
+    }
+
+
+    float calculate_acmr( std::span<uint32_t const> const indices, uint32_t const vertex_count, uint32_t const cache_size )
+    {
+        size_t const triangle_count = indices.size( ) / 3u;
+        if ( triangle_count == 0u )
+        {
+            return 0.0f;
+        }
+
+        // A vertex is cached while fewer than cache_size others have been inserted after it, which is a FIFO of that size.
+        std::vector<uint32_t> insertion_times( vertex_count, 0u );
+        uint32_t time{ cache_size + 1u };
+        uint32_t misses{ 0u };
+        for ( uint32_t const index : indices )
+        {
+            if ( time - insertion_times[index] > cache_size )
+            {
+                insertion_times[index] = time++;
+                ++misses;
+            }
+        }
+        return static_cast<float>( misses ) / static_cast<float>( triangle_count );
+    }
+
+}
@@ -0,0 +1,57 @@
+#include <__pipeline/ComputePipelineBuilder.h>
+
+#include <__pipeline/PipelineCache.h>
+
+#include <cassert>
+#include <utility>
+
+
+namespace cobalt::builder
+{
+    ComputePipelineBuilder& ComputePipelineBuilder::set_shader_module( shader::ShaderModule&& shader,
+                                                                       VkSpecializationInfo const* specialization_info,
+                                                                       char const* entry_point )
+    {
+        shader_module_.emplace( std::move( shader ) );
+        return set_shader_module( *shader_module_, specialization_info, entry_point );
+    }
+
+
+    ComputePipelineBuilder& ComputePipelineBuilder::set_shader_module( shader::ShaderModule const& shader,
+                                                                       VkSpecializationInfo const* specialization_info,
+                                                                       char const* entry_point )
+    {
+        assert( shader.stage( ) == VK_SHADER_STAGE_COMPUTE_BIT &&
+            "ComputePipelineBuilder::set_shader_module: shader is not a compute shader!" );
+
+        shader_stage_ = VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = shader.stage( ),
+            .module = shader.handle( ),
+            .pName = entry_point,
+            .pSpecializationInfo = specialization_info,
+        };
+
+        return *this;
+    }
+
+
+    Pipeline ComputePipelineBuilder::build( DeviceSet const& device, PipelineLayout const& layout,
+                                            PipelineCache const* cache ) const
+    {
+        assert( shader_stage_.module != VK_NULL_HANDLE && "ComputePipelineBuilder::build: no shader module set!" );
+
+        return Pipeline{
+            device, layout,
+            ComputePipelineCreateInfo{
+                .cache = cache ? cache->handle( ) : VK_NULL_HANDLE,
+                .create_info = VkComputePipelineCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                    .stage = shader_stage_,
+                    .layout = layout.handle( ),
+                }
+            }
+        };
+    }
+
+}
@@ -1,5 +1,11 @@
 #include <__pipeline/GraphicsPipelineBuilder.h>
 
+#include <__pipeline/PipelineCache.h>
+#include <__thread/WorkerPool.h>
+
+#include <algorithm>
+#include <future>
+
 
 namespace cobalt::builder
 {
@@ -132,6 +138,23 @@ namespace cobalt::builder
     }
 
 
+    GraphicsPipelineBuilder& GraphicsPipelineBuilder::add_shader_module( shader::ShaderModule const& shader,
+                                                                         VkSpecializationInfo const* specialization_info,
+                                                                         char const* entry_point )
+    {
+        shader_stages_.emplace_back(
+            VkPipelineShaderStageCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .stage = shader.stage( ),
+                .module = shader.handle( ),
+                .pName = entry_point,
+                .pSpecializationInfo = specialization_info,
+            } );
+
+        return *this;
+    }
+
+
     GraphicsPipelineBuilder& GraphicsPipelineBuilder::set_dynamic_state( std::span<VkDynamicState const> dynamic_states )
     {
         dynamic_states_ = std::vector<VkDynamicState>{ dynamic_states.begin( ), dynamic_states.end( ) };
@@ -151,8 +174,8 @@ namespace cobalt::builder
     }
 
 
-    Pipeline GraphicsPipelineBuilder::build(
-        DeviceSet const& device, PipelineLayout const& layout, VkPipelineBindPoint const bind_point ) const
+    Pipeline GraphicsPipelineBuilder::build( DeviceSet const& device, PipelineLayout const& layout,
+                                             VkPipelineBindPoint const bind_point, PipelineCache const* cache ) const
     {
         VkPipelineRenderingCreateInfo const pipeline_rendering_info{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
@@ -165,6 +188,7 @@ namespace cobalt::builder
             device, layout,
             PipelineCreateInfo{
                 .bind_point = bind_point,
+                .cache = cache ? cache->handle( ) : VK_NULL_HANDLE,
                 .create_info = VkGraphicsPipelineCreateInfo{
                     .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
                     .pNext = &pipeline_rendering_info,
@@ -187,4 +211,39 @@ namespace cobalt::builder
         };
     }
 
+
+
+    std::vector<Pipeline> build_pipelines( DeviceSet const& device, std::span<GraphicsPipelineBuild const> const builds,
+                                           PipelineCache const* cache, uint32_t const thread_count )
+    {
+        // Pipeline creation is thread-safe against a shared cache, the builders are only read.
+        uint32_t const workers_needed = std::min( static_cast<uint32_t>( builds.size( ) ),
+                                                  thread_count > 0u ? thread_count : thread::WorkerPool::default_thread_count( ) );
+        thread::WorkerPool workers{ std::max( workers_needed, 1u ) };
+
+        std::vector<std::future<Pipeline>> futures{};
+        futures.reserve( builds.size( ) );
+        for ( GraphicsPipelineBuild const& build : builds )
+        {
+            futures.push_back( workers.submit( [&device, &build, cache]
+                {
+                    return build.builder.build( device, build.layout, build.bind_point, cache );
+                } ) );
+        }
+
+        // Wait for every build before rethrowing, the workers still reference the builders.
+        for ( std::future<Pipeline> const& future : futures )
+        {
+            future.wait( );
+        }
+
+        std::vector<Pipeline> pipelines{};
+        pipelines.reserve( builds.size( ) );
+        for ( std::future<Pipeline>& future : futures )
+        {
+            pipelines.push_back( future.get( ) );
+        }
+        return pipelines;
+    }
+
 }
@@ -13,12 +13,24 @@ namespace cobalt
         , bind_point_{ create_info.bind_point }
     {
         validation::throw_on_bad_result(
-            vkCreateGraphicsPipelines( device_ref_.logical( ), VK_NULL_HANDLE, 1,
+            vkCreateGraphicsPipelines( device_ref_.logical( ), create_info.cache, 1,
                                        &create_info.create_info, nullptr, &pipeline_ ),
             "failed to create graphics pipeline!" );
     }
 
 
+    Pipeline::Pipeline( DeviceSet const& device, PipelineLayout const& layout, ComputePipelineCreateInfo const& create_info )
+        : device_ref_{ device }
+        , layout_ref_{ layout }
+        , bind_point_{ VK_PIPELINE_BIND_POINT_COMPUTE }
+    {
+        validation::throw_on_bad_result(
+            vkCreateComputePipelines( device_ref_.logical( ), create_info.cache, 1,
+                                      &create_info.create_info, nullptr, &pipeline_ ),
+            "failed to create compute pipeline!" );
+    }
+
+
     Pipeline::~Pipeline( ) noexcept
     {
         if ( pipeline_ != VK_NULL_HANDLE )
@@ -0,0 +1,171 @@
+#include <__pipeline/PipelineCache.h>
+
+#include <log.h>
+#include <__context/DeviceSet.h>
+#include <__io/MappedFile.h>
+#include <__io/hash.h>
+#include <__validation/result.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+
+namespace cobalt
+{
+    // +---------------------------+
+    // | BLOB LAYOUT               |
+    // +---------------------------+
+    // [stamp][driver cache data], the stamp identifies the device and driver the data was produced by.
+    static constexpr std::array<char, 4> PIPELINE_CACHE_MAGIC{ 'C', 'B', 'P', 'C' };
+    static constexpr uint32_t PIPELINE_CACHE_VERSION{ 1u };
+
+
+    struct PipelineCacheStamp
+    {
+        std::array<char, 4> magic{};
+        uint32_t version{};
+
+        uint32_t vendor_id{};
+        uint32_t device_id{};
+        uint32_t driver_version{};
+        uint32_t padding{};
+        std::array<uint8_t, VK_UUID_SIZE> driver_uuid{};
+        std::array<uint8_t, VK_UUID_SIZE> cache_uuid{};
+
+        uint64_t data_size{};
+        uint64_t data_hash{};
+    };
+
+
+    // +---------------------------+
+    // | HELPERS                   |
+    // +---------------------------+
+    [[nodiscard]] static PipelineCacheStamp stamp_device( VkPhysicalDevice const physical_device )
+    {
+        VkPhysicalDeviceIDProperties id_properties{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
+        VkPhysicalDeviceProperties2 properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &id_properties
+        };
+        vkGetPhysicalDeviceProperties2( physical_device, &properties );
+
+        PipelineCacheStamp stamp{
+            .magic = PIPELINE_CACHE_MAGIC,
+            .version = PIPELINE_CACHE_VERSION,
+            .vendor_id = properties.properties.vendorID,
+            .device_id = properties.properties.deviceID,
+            .driver_version = properties.properties.driverVersion,
+        };
+        std::memcpy( stamp.driver_uuid.data( ), id_properties.driverUUID, VK_UUID_SIZE );
+        std::memcpy( stamp.cache_uuid.data( ), properties.properties.pipelineCacheUUID, VK_UUID_SIZE );
+        return stamp;
+    }
+
+
+    [[nodiscard]] static bool is_same_device( PipelineCacheStamp const& lhs, PipelineCacheStamp const& rhs )
+    {
+        return lhs.magic == rhs.magic && lhs.version == rhs.version && lhs.vendor_id == rhs.vendor_id &&
+               lhs.device_id == rhs.device_id && lhs.driver_version == rhs.driver_version &&
+               lhs.driver_uuid == rhs.driver_uuid && lhs.cache_uuid == rhs.cache_uuid;
+    }
+
+
+    // +---------------------------+
+    // | PIPELINE CACHE            |
+    // +---------------------------+
+    PipelineCache::PipelineCache( DeviceSet const& device, std::filesystem::path cache_path )
+        : device_ref_{ device }
+        , cache_path_{ std::move( cache_path ) }
+    {
+        // 1. Only seed the cache with data this device and driver produced, anything else is at best ignored by the driver.
+        io::MappedFile const file{ cache_path_ };
+        std::span<std::byte const> initial_data{};
+        if ( file.is_open( ) && file.size( ) >= sizeof( PipelineCacheStamp ) )
+        {
+            PipelineCacheStamp stored{};
+            std::memcpy( &stored, file.data( ), sizeof( PipelineCacheStamp ) );
+
+            std::span<std::byte const> const payload = file.bytes( ).subspan( sizeof( PipelineCacheStamp ) );
+            if ( is_same_device( stored, stamp_device( device_ref_.physical( ) ) ) && stored.data_size == payload.size( ) &&
+                 stored.data_hash == io::hash_bytes( payload ) )
+            {
+                initial_data = payload;
+            }
+            else
+            {
+                log::loginfo<PipelineCache>( "PipelineCache",
+                                             std::format( "discarding stale pipeline cache: {}", cache_path_.string( ) ) );
+            }
+        }
+
+        // 2. Create the cache, empty if nothing usable was found.
+        VkPipelineCacheCreateInfo const create_info{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .initialDataSize = initial_data.size( ),
+            .pInitialData = initial_data.data( ),
+        };
+        validation::throw_on_bad_result(
+            vkCreatePipelineCache( device_ref_.logical( ), &create_info, nullptr, &pipeline_cache_ ),
+            "failed to create pipeline cache!" );
+
+        log::loginfo<PipelineCache>( "PipelineCache", std::format( "pipeline cache seeded with {} bytes", initial_data.size( ) ),
+                                     not initial_data.empty( ) );
+    }
+
+
+    PipelineCache::~PipelineCache( ) noexcept
+    {
+        save( );
+        vkDestroyPipelineCache( device_ref_.logical( ), pipeline_cache_, nullptr );
+    }
+
+
+    VkPipelineCache PipelineCache::handle( ) const
+    {
+        return pipeline_cache_;
+    }
+
+
+    void PipelineCache::save( ) const
+    {
+        // 1. Fetch the driver data behind the stamp.
+        size_t data_size{};
+        if ( vkGetPipelineCacheData( device_ref_.logical( ), pipeline_cache_, &data_size, nullptr ) != VK_SUCCESS )
+        {
+            return;
+        }
+
+        std::vector<std::byte> blob( sizeof( PipelineCacheStamp ) + data_size );
+        if ( vkGetPipelineCacheData( device_ref_.logical( ), pipeline_cache_, &data_size,
+                                     blob.data( ) + sizeof( PipelineCacheStamp ) ) != VK_SUCCESS )
+        {
+            return;
+        }
+        blob.resize( sizeof( PipelineCacheStamp ) + data_size );
+
+        PipelineCacheStamp stamp = stamp_device( device_ref_.physical( ) );
+        stamp.data_size = data_size;
+        stamp.data_hash = io::hash_bytes( std::span{ blob }.subspan( sizeof( PipelineCacheStamp ) ) );
+        std::memcpy( blob.data( ), &stamp, sizeof( PipelineCacheStamp ) );
+
+        // 2. Write to a temporary file first, a crash mid-write must never leave a truncated cache behind.
+        std::filesystem::path const temp_path{ cache_path_.string( ) + ".tmp" };
+        {
+            std::ofstream file{ temp_path, std::ios::binary | std::ios::trunc };
+            file.write( reinterpret_cast<char const*>( blob.data( ) ), static_cast<std::streamsize>( blob.size( ) ) );
+            if ( not file )
+            {
+                log::logerr<PipelineCache>( "save", std::format( "failed to write: {}", temp_path.string( ) ) );
+                return;
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename( temp_path, cache_path_, error );
+        log::logerr<PipelineCache>( "save", std::format( "failed to replace: {}", cache_path_.string( ) ),
+                                    static_cast<bool>( error ) );
+    }
+
+}
@@ -44,6 +44,18 @@ namespace cobalt::query
     }
 
 
+    bool supports_format_features( VkPhysicalDevice const physical_device, VkFormat const format, VkImageTiling const tiling,
+                                   VkFormatFeatureFlags const features )
+    {
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties( physical_device, format, &props );
+
+        VkFormatFeatureFlags const supported =
+                tiling == VK_IMAGE_TILING_LINEAR ? props.linearTilingFeatures : props.optimalTilingFeatures;
+        return ( supported & features ) == features;
+    }
+
+
     VkFormat find_depth_format( VkPhysicalDevice const physical_device )
     {
         return select_format(
@@ -1,6 +1,8 @@
 #include <__render/Renderer.h>
 
 #include <__buffer/CommandPool.h>
+#include <__buffer/StagingRing.h>
+#include <__cleanup/DeletionQueue.h>
 #include <__context/DeviceSet.h>
 #include <__render/Swapchain.h>
 
@@ -13,7 +15,18 @@ namespace cobalt
         , render_sync_{
             *create_info.device, *create_info.cmd_pool, create_info.max_frames_in_flight, create_info.swapchain->image_count( )
         }
-        , max_frames_in_flight_{ create_info.max_frames_in_flight } { }
+        , max_frames_in_flight_{ create_info.max_frames_in_flight }
+        , deletion_queue_ptr_{ create_info.deletion_queue }
+        , slot_deletion_frames_( create_info.max_frames_in_flight, 0u ) { }
+
+
+    void Renderer::wait_frames_in_flight( ) const
+    {
+        for ( uint32_t frame{}; frame < max_frames_in_flight_; ++frame )
+        {
+            render_sync_.frame_sync( frame ).in_flight_fence.wait( );
+        }
+    }
 
 
     void Renderer::set_record_command_buffer_fn( std::function<record_command_buffer_sig_t> record_fn ) noexcept
@@ -36,6 +49,15 @@ namespace cobalt
         // 1. Wait for the previous frame to finish. We wait for the fence.
         in_flight_fence.wait( );
 
+        // The GPU is done with the data streamed for this frame slot, its staging space can be reused.
+        device_ref_.staging_ring( ).retire_frame( static_cast<uint32_t>( current_frame_ ) );
+
+        // Likewise for the resources released up to the frame last submitted from this slot, frames complete in order.
+        if ( deletion_queue_ptr_ != nullptr && slot_deletion_frames_[current_frame_] != 0u )
+        {
+            deletion_queue_ptr_->collect( slot_deletion_frames_[current_frame_] );
+        }
+
         // 2. Acquire an image from the swapchain.
         uint32_t const image_index = swapchain_ref_.acquire_next_image( acquire_semaphore );
 
@@ -49,6 +71,13 @@ namespace cobalt
         // We reset the fence only if there's work to do, which is why we're doing it after the acquire image check. DEADLOCK warning!
         in_flight_fence.reset( );
 
+        // Resources released from here on may be used by this frame, they wait for its fence.
+        if ( deletion_queue_ptr_ != nullptr )
+        {
+            deletion_queue_ptr_->advance( deletion_queue_ptr_->current_frame( ) + 1u );
+            slot_deletion_frames_[current_frame_] = deletion_queue_ptr_->current_frame( );
+        }
+
         // 3. Record a command buffer which draws the scene onto that image.
         if ( record_command_buffer_fn_ )
         {
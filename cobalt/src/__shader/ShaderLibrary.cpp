@@ -0,0 +1,24 @@
+#include <__shader/ShaderLibrary.h>
+
+#include <format>
+
+
+namespace cobalt::shader
+{
+    ShaderLibrary::ShaderLibrary( DeviceSet const& device )
+        : device_ref_{ device } { }
+
+
+    ShaderModule const& ShaderLibrary::load( std::filesystem::path const& path, VkShaderStageFlagBits const stage )
+    {
+        std::string key = std::format( "{}|{}", path.lexically_normal( ).generic_string( ), static_cast<uint32_t>( stage ) );
+        if ( auto const it = modules_.find( key ); it != modules_.end( ) )
+        {
+            return *it->second;
+        }
+
+        auto module_ptr = std::make_unique<ShaderModule>( device_ref_, path, stage );
+        return *modules_.emplace( std::move( key ), std::move( module_ptr ) ).first->second;
+    }
+
+}
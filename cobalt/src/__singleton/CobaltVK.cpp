@@ -1,5 +1,9 @@
 #include <__singleton/CobaltVK.h>
 
+#include <algorithm>
+#include <functional>
+#include <ranges>
+
 
 namespace cobalt
 {
@@ -8,7 +12,8 @@ namespace cobalt
 
     CobaltVK::~CobaltVK( )
     {
-        log::logerr<CobaltVK>( "~CobaltVK", "instance has not been cleared!", not deletion_queue_.is_flushed( ) );
+        log::logerr<CobaltVK>( "~CobaltVK", "instance has not been cleared!",
+                               live_resource_count( ) > 0u || not deletion_queue_.is_flushed( ) );
     }
 
 
@@ -21,7 +26,41 @@ namespace cobalt
 
     void CobaltVK::reset_instance( )
     {
+        // 1. Nothing is in flight anymore, retired resources can go right away.
         deletion_queue_.flush( );
+
+        // 2. Resources depend on the ones created before them (e.g. everything on the context), gather them across pools.
+        std::vector<memory::LiveResource> live{};
+        for ( auto const& pool : pools_ | std::views::values )
+        {
+            pool->collect_live( live );
+        }
+        std::ranges::sort( live, std::greater{}, &memory::LiveResource::sequence );
+
+        // 3. Destroy newest first. Handles released by a destructor retire their resources, which are flushed right after it
+        // so that they still go before everything older. Destroy ignores what is already gone.
+        for ( auto const& [sequence, pool_ptr, info] : live )
+        {
+            pool_ptr->destroy( info );
+            deletion_queue_.flush( );
+        }
+    }
+
+
+    cleanup::DeletionQueue& CobaltVK::deletion_queue( )
+    {
+        return deletion_queue_;
+    }
+
+
+    size_t CobaltVK::live_resource_count( ) const
+    {
+        size_t count{ 0u };
+        for ( auto const& pool : pools_ | std::views::values )
+        {
+            count += pool->size( );
+        }
+        return count;
     }
 
 }
@@ -44,6 +44,12 @@ namespace cobalt::sync
     }
 
 
+    bool Fence::signaled( ) const noexcept
+    {
+        return vkGetFenceStatus( device_ref_.logical( ), fence_ ) == VK_SUCCESS;
+    }
+
+
     void Fence::wait( ) const noexcept
     {
         device_ref_.wait_for_fence( fence_ );
@@ -0,0 +1,118 @@
+#include <__thread/WorkerPool.h>
+
+#include <algorithm>
+#include <atomic>
+
+
+namespace cobalt::thread
+{
+    WorkerPool::WorkerPool( uint32_t const thread_count )
+    {
+        uint32_t const count = thread_count != 0u ? thread_count : default_thread_count( );
+
+        workers_.reserve( count );
+        for ( uint32_t i{}; i < count; ++i )
+        {
+            workers_.emplace_back( &WorkerPool::worker_loop, this );
+        }
+    }
+
+
+    WorkerPool::~WorkerPool( ) noexcept
+    {
+        {
+            std::lock_guard const lock{ queue_mutex_ };
+            stopping_ = true;
+        }
+        queue_cv_.notify_all( );
+
+        // Workers drain the queue before leaving, so no submitted future is left without a value.
+        for ( std::thread& worker : workers_ )
+        {
+            worker.join( );
+        }
+    }
+
+
+    uint32_t WorkerPool::thread_count( ) const
+    {
+        return static_cast<uint32_t>( workers_.size( ) );
+    }
+
+
+    void WorkerPool::parallel_for( size_t const count, std::function<void( size_t )> const& fn )
+    {
+        if ( count == 0u )
+        {
+            return;
+        }
+
+        // Indices are pulled from a shared counter instead of being split up front, so a few expensive items do not leave
+        // the remaining workers idle.
+        std::atomic<size_t> next_index{ 0u };
+        auto const drain = [&next_index, count, &fn]
+            {
+                for ( size_t index = next_index++; index < count; index = next_index++ )
+                {
+                    fn( index );
+                }
+            };
+
+        size_t const task_count = std::min<size_t>( count, workers_.size( ) );
+
+        std::vector<std::future<void>> futures{};
+        futures.reserve( task_count );
+        for ( size_t i{}; i < task_count; ++i )
+        {
+            futures.emplace_back( submit( drain ) );
+        }
+
+        // Wait for every task before rethrowing, the lambdas reference this stack frame.
+        for ( auto& future : futures )
+        {
+            future.wait( );
+        }
+        for ( auto& future : futures )
+        {
+            future.get( );
+        }
+    }
+
+
+    uint32_t WorkerPool::default_thread_count( )
+    {
+        return std::max( 1u, std::thread::hardware_concurrency( ) );
+    }
+
+
+    void WorkerPool::enqueue( std::function<void( )>&& task )
+    {
+        {
+            std::lock_guard const lock{ queue_mutex_ };
+            tasks_.push( std::move( task ) );
+        }
+        queue_cv_.notify_one( );
+    }
+
+
+    void WorkerPool::worker_loop( )
+    {
+        while ( true )
+        {
+            std::function<void( )> task{};
+            {
+                std::unique_lock lock{ queue_mutex_ };
+                queue_cv_.wait( lock, [this] { return stopping_ || not tasks_.empty( ); } );
+
+                if ( tasks_.empty( ) )
+                {
+                    return;
+                }
+                task = std::move( tasks_.front( ) );
+                tasks_.pop( );
+            }
+            task( );
+        }
+    }
+
+}
@@ -14,14 +14,7 @@ namespace cobalt::validation
     bool PhysicalDeviceSelector::select( VkPhysicalDevice const device ) const
     {
         // 1. fetch the physical device features and extensions
-        exe::ValidationData data{
-            .instance = &instance_ref_,
-            .device = device,
-            .features = { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 },
-            .extensions = {}
-        };
-        vkGetPhysicalDeviceFeatures2( device, &data.features );
-        get_extensions( device, data.extensions );
+        exe::ValidationData const data = query( device );
 
         // 2. cross-check with the validation map
         for ( auto const& [flag, command] : FEATURE_COMMAND_MAP )
@@ -36,6 +29,23 @@ namespace cobalt::validation
     }
 
 
+    DeviceFeatureFlags PhysicalDeviceSelector::supported( VkPhysicalDevice const device,
+                                                          DeviceFeatureFlags const features ) const
+    {
+        exe::ValidationData const data = query( device );
+
+        DeviceFeatureFlags supported_features{ DeviceFeatureFlags::NONE };
+        for ( auto const& [flag, command] : FEATURE_COMMAND_MAP )
+        {
+            if ( any( features & flag ) && command->validate( data ) )
+            {
+                supported_features = supported_features | flag;
+            }
+        }
+        return supported_features;
+    }
+
+
     exe::EnableData PhysicalDeviceSelector::require( ) const
     {
         exe::EnableData data{};
@@ -55,6 +65,20 @@ namespace cobalt::validation
     }
 
 
+    exe::ValidationData PhysicalDeviceSelector::query( VkPhysicalDevice const device ) const
+    {
+        exe::ValidationData data{
+            .instance = &instance_ref_,
+            .device = device,
+            .features = { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 },
+            .extensions = {}
+        };
+        vkGetPhysicalDeviceFeatures2( device, &data.features );
+        get_extensions( device, data.extensions );
+        return data;
+    }
+
+
     void PhysicalDeviceSelector::get_extensions( VkPhysicalDevice const device, std::vector<VkExtensionProperties>& dest )
     {
         // Check if the device supports the required extensions
@@ -0,0 +1,48 @@
+#ifndef COBALT_TEST_CHECK_H
+#define COBALT_TEST_CHECK_H
+
+#include <cstdio>
+#include <source_location>
+
+
+namespace cobalt::test
+{
+    inline int& failure_count( )
+    {
+        static int count{ 0 };
+        return count;
+    }
+
+
+    // Failures are counted instead of aborting, so one run reports every broken expectation.
+    inline bool check( bool const condition, char const* expression,
+                       std::source_location const location = std::source_location::current( ) )
+    {
+        if ( not condition )
+        {
+            std::fprintf( stderr, "%s:%u: check failed: %s\n", location.file_name( ), location.line( ), expression );
+            ++failure_count( );
+        }
+        return condition;
+    }
+
+
+    // Exit code of the test executable.
+    inline int result( )
+    {
+        if ( failure_count( ) == 0 )
+        {
+            std::printf( "all checks passed.\n" );
+            return 0;
+        }
+        std::fprintf( stderr, "%d check(s) failed.\n", failure_count( ) );
+        return 1;
+    }
+
+}
+
+
+#define COBALT_CHECK( expression ) ::cobalt::test::check( static_cast<bool>( expression ), #expression )
+
+
+#endif //!COBALT_TEST_CHECK_H
@@ -0,0 +1,217 @@
+// CPU side of the device memory allocator: the offset allocators of its blocks and its placement decisions.
+#include "check.h"
+
+#include <__memory/BuddyAllocator.h>
+#include <__memory/device_memory_policy.h>
+#include <__memory/LinearAllocator.h>
+
+#include <set>
+#include <stdexcept>
+
+
+namespace
+{
+    using namespace cobalt;
+    using namespace cobalt::memory;
+
+    constexpr VkDeviceSize MIB{ 1ull << 20u };
+
+
+    // Discrete GPU layout: a large device local heap, host memory and the small BAR heap that is both.
+    VkPhysicalDeviceMemoryProperties make_memory_properties( )
+    {
+        VkPhysicalDeviceMemoryProperties properties{};
+        properties.memoryHeapCount = 3u;
+        properties.memoryHeaps[0].size = 8192u * MIB;
+        properties.memoryHeaps[1].size = 16384u * MIB;
+        properties.memoryHeaps[2].size = 256u * MIB;
+
+        properties.memoryTypeCount = 3u;
+        properties.memoryTypes[0] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0u };
+        properties.memoryTypes[1] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1u };
+        properties.memoryTypes[2] = {
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 2u
+        };
+        return properties;
+    }
+
+
+    void test_buddy_split_and_merge( )
+    {
+        BuddyAllocator allocator{ 1024u, 64u };
+
+        // The first allocation splits the range down to a 64 byte node, leaving one free buddy per order.
+        auto const a = allocator.allocate( 64u, 1u );
+        auto const b = allocator.allocate( 64u, 1u );
+        auto const c = allocator.allocate( 128u, 1u );
+        COBALT_CHECK( a == 0u );
+        COBALT_CHECK( b == 64u );
+        COBALT_CHECK( c == 128u );
+        COBALT_CHECK( allocator.used( ) == 256u );
+
+        // Requests are rounded up to a power of two.
+        auto const d = allocator.allocate( 100u, 1u );
+        COBALT_CHECK( d == 256u );
+        COBALT_CHECK( allocator.used( ) == 384u );
+
+        // Once both halves are free they merge back, and the whole range fits again.
+        allocator.free( *b );
+        allocator.free( *a );
+        allocator.free( *d );
+        allocator.free( *c );
+        COBALT_CHECK( allocator.empty( ) );
+        COBALT_CHECK( allocator.used( ) == 0u );
+        COBALT_CHECK( allocator.allocate( 1024u, 1u ) == 0u );
+        COBALT_CHECK( not allocator.allocate( 64u, 1u ).has_value( ) );
+    }
+
+
+    void test_buddy_alignment( )
+    {
+        BuddyAllocator allocator{ 4096u, 64u };
+
+        // A small request with a large alignment takes a node as large as the alignment.
+        auto const small = allocator.allocate( 64u, 1u );
+        auto const aligned = allocator.allocate( 64u, 1024u );
+        COBALT_CHECK( small == 0u );
+        COBALT_CHECK( aligned.has_value( ) && *aligned % 1024u == 0u );
+        COBALT_CHECK( aligned != small );
+
+        std::set<uint64_t> offsets{};
+        while ( auto const offset = allocator.allocate( 256u, 256u ) )
+        {
+            COBALT_CHECK( *offset % 256u == 0u );
+            offsets.insert( *offset );
+        }
+        COBALT_CHECK( not offsets.empty( ) );
+        COBALT_CHECK( not allocator.allocate( 8192u, 1u ).has_value( ) );
+    }
+
+
+    void test_linear( )
+    {
+        LinearAllocator allocator{ 1024u };
+
+        COBALT_CHECK( allocator.allocate( 10u, 1u ) == 0u );
+        COBALT_CHECK( allocator.allocate( 10u, 256u ) == 256u );
+        COBALT_CHECK( allocator.used( ) == 266u );
+        COBALT_CHECK( not allocator.allocate( 800u, 1u ).has_value( ) );
+
+        // Only reclaimed once the last allocation is freed.
+        allocator.free( );
+        COBALT_CHECK( allocator.used( ) == 266u );
+        allocator.free( );
+        COBALT_CHECK( allocator.empty( ) );
+        COBALT_CHECK( allocator.allocate( 1024u, 1u ) == 0u );
+    }
+
+
+    void test_find_memory_type( )
+    {
+        VkPhysicalDeviceMemoryProperties const properties = make_memory_properties( );
+
+        COBALT_CHECK( find_memory_type( properties, 0b111u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) == 0u );
+        COBALT_CHECK( find_memory_type( properties, 0b111u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) == 1u );
+        COBALT_CHECK( find_memory_type( properties, 0b111u,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) == 2u );
+
+        // The filter of the resource wins over the order of the types.
+        COBALT_CHECK( find_memory_type( properties, 0b100u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) == 2u );
+
+        bool thrown{ false };
+        try
+        {
+            static_cast<void>( find_memory_type( properties, 0b001u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) );
+        }
+        catch ( std::runtime_error const& )
+        {
+            thrown = true;
+        }
+        COBALT_CHECK( thrown );
+    }
+
+
+    void test_pool_separation( )
+    {
+        // Linear and optimal resources never share a block, which is what keeps them bufferImageGranularity apart. Every
+        // memory type, resource kind and lifetime maps to a pool of its own.
+        std::set<uint32_t> indices{};
+        for ( uint32_t memory_type{}; memory_type < VK_MAX_MEMORY_TYPES; ++memory_type )
+        {
+            for ( bool const linear : { true, false } )
+            {
+                for ( auto const lifetime : { AllocationLifetime::PERSISTENT, AllocationLifetime::TRANSIENT } )
+                {
+                    uint32_t const index = pool_index( memory_type, AllocationRequest{
+                        .linear_resource = linear, .lifetime = lifetime
+                    } );
+                    COBALT_CHECK( index < VK_MAX_MEMORY_TYPES * DeviceAllocator::POOLS_PER_MEMORY_TYPE );
+                    indices.insert( index );
+                }
+            }
+        }
+        COBALT_CHECK( indices.size( ) == VK_MAX_MEMORY_TYPES * DeviceAllocator::POOLS_PER_MEMORY_TYPE );
+
+        COBALT_CHECK( pool_index( 0u, AllocationRequest{ .linear_resource = true } ) !=
+            pool_index( 0u, AllocationRequest{ .linear_resource = false } ) );
+    }
+
+
+    void test_block_size_clamping( )
+    {
+        VkPhysicalDeviceMemoryProperties const properties = make_memory_properties( );
+        DeviceAllocatorCreateInfo const create_info{};
+
+        // Large heaps take the requested sizes.
+        COBALT_CHECK( pool_block_size( properties, create_info, 0u, AllocationLifetime::PERSISTENT ) == create_info.block_size );
+        COBALT_CHECK( pool_block_size( properties, create_info, 1u, AllocationLifetime::TRANSIENT ) ==
+            create_info.transient_block_size );
+
+        // The 256MiB BAR heap is clamped to an eighth of it.
+        COBALT_CHECK( pool_block_size( properties, create_info, 2u, AllocationLifetime::PERSISTENT ) == 32u * MIB );
+        COBALT_CHECK( pool_block_size( properties, create_info, 2u, AllocationLifetime::TRANSIENT ) ==
+            create_info.transient_block_size );
+
+        // Heaps that are not a power of two round down, tiny ones never go below the allocation granularity.
+        VkPhysicalDeviceMemoryProperties odd = properties;
+        odd.memoryHeaps[2].size = 200u * MIB;
+        COBALT_CHECK( pool_block_size( odd, create_info, 2u, AllocationLifetime::PERSISTENT ) == 16u * MIB );
+        odd.memoryHeaps[2].size = 1024u;
+        COBALT_CHECK( pool_block_size( odd, create_info, 2u, AllocationLifetime::PERSISTENT ) ==
+            create_info.min_allocation_size );
+    }
+
+
+    void test_dedicated_fallback( )
+    {
+        VkPhysicalDeviceMemoryProperties const properties = make_memory_properties( );
+        DeviceAllocatorCreateInfo const create_info{};
+
+        // More than half a block goes dedicated, relative to the clamped block of small heaps.
+        VkDeviceSize const block_size = pool_block_size( properties, create_info, 0u, AllocationLifetime::PERSISTENT );
+        COBALT_CHECK( not requires_dedicated( block_size / 2u, block_size ) );
+        COBALT_CHECK( requires_dedicated( block_size / 2u + 1u, block_size ) );
+
+        VkDeviceSize const bar_block_size = pool_block_size( properties, create_info, 2u, AllocationLifetime::PERSISTENT );
+        COBALT_CHECK( requires_dedicated( 20u * MIB, bar_block_size ) );
+        COBALT_CHECK( not requires_dedicated( 20u * MIB, block_size ) );
+
+        // Whatever is not dedicated fits in a fresh block of its pool.
+        BuddyAllocator block{ bar_block_size, create_info.min_allocation_size };
+        COBALT_CHECK( block.allocate( bar_block_size / 2u, 4096u ).has_value( ) );
+    }
+
+}
+
+
+int main( )
+{
+    test_buddy_split_and_merge( );
+    test_buddy_alignment( );
+    test_linear( );
+    test_find_memory_type( );
+    test_pool_separation( );
+    test_block_size_clamping( );
+    test_dedicated_fallback( );
+    return cobalt::test::result( );
+}
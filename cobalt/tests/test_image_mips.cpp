@@ -0,0 +1,124 @@
+// Mip chain extents and the per level layout tracking behind the barriers of mip generation.
+#include "check.h"
+
+#include <__image/Image.h>
+#include <__image/SubresourceLayouts.h>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+
+
+    bool equals( LayoutRun const& run, uint32_t const base, uint32_t const count, VkImageLayout const old_layout )
+    {
+        return run.base_mip_level == base && run.level_count == count && run.old_layout == old_layout;
+    }
+
+
+    void test_mip_levels( )
+    {
+        COBALT_CHECK( image::calculate_mip_levels( { 1u, 1u } ) == 1u );
+        COBALT_CHECK( image::calculate_mip_levels( { 2u, 1u } ) == 2u );
+        COBALT_CHECK( image::calculate_mip_levels( { 256u, 256u } ) == 9u );
+        COBALT_CHECK( image::calculate_mip_levels( { 300u, 100u } ) == 9u );
+        COBALT_CHECK( image::calculate_mip_levels( { 1u, 1024u } ) == 11u );
+        COBALT_CHECK( image::calculate_mip_levels( { 1920u, 1080u } ) == 11u );
+    }
+
+
+    void test_mip_extents( )
+    {
+        // Non power of two and non square: levels round down and the short side stops at 1.
+        VkExtent2D const extent{ 300u, 100u };
+        std::vector<VkExtent2D> const expected{
+            { 300u, 100u }, { 150u, 50u }, { 75u, 25u }, { 37u, 12u }, { 18u, 6u }, { 9u, 3u }, { 4u, 1u }, { 2u, 1u }, { 1u, 1u }
+        };
+
+        uint32_t const levels = image::calculate_mip_levels( extent );
+        COBALT_CHECK( levels == expected.size( ) );
+        for ( uint32_t level{}; level < levels; ++level )
+        {
+            VkExtent2D const mip = image::calculate_mip_extent( extent, level );
+            COBALT_CHECK( mip.width == expected[level].width && mip.height == expected[level].height );
+        }
+
+        // Past the chain the extent stays 1x1.
+        VkExtent2D const past = image::calculate_mip_extent( extent, levels + 2u );
+        COBALT_CHECK( past.width == 1u && past.height == 1u );
+    }
+
+
+    // The transitions of a texture upload followed by Image::generate_mipmaps, one barrier per run of levels.
+    void test_mip_generation_barriers( )
+    {
+        constexpr uint32_t level_count{ 9u };
+        SubresourceLayouts layouts{ level_count };
+
+        // 1. The upload takes the whole chain to TRANSFER_DST in one barrier.
+        auto runs = layouts.transition( 0u, VK_REMAINING_MIP_LEVELS, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+        COBALT_CHECK( runs.size( ) == 1u && equals( runs[0], 0u, level_count, VK_IMAGE_LAYOUT_UNDEFINED ) );
+
+        // 2. Each blit turns the level above into a source, the destination is already in place.
+        for ( uint32_t level{ 1u }; level < level_count; ++level )
+        {
+            runs = layouts.transition( level - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+            COBALT_CHECK( runs.size( ) == 1u && equals( runs[0], level - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ) );
+
+            runs = layouts.transition( level, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+            COBALT_CHECK( runs.empty( ) );
+        }
+
+        // 3. Every level but the last was a source, the final transition needs one barrier for each.
+        runs = layouts.transition( 0u, VK_REMAINING_MIP_LEVELS, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        COBALT_CHECK( runs.size( ) == 2u );
+        if ( runs.size( ) == 2u )
+        {
+            COBALT_CHECK( equals( runs[0], 0u, level_count - 1u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ) );
+            COBALT_CHECK( equals( runs[1], level_count - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ) );
+        }
+
+        for ( uint32_t level{}; level < level_count; ++level )
+        {
+            COBALT_CHECK( layouts.layout( level ) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        }
+        COBALT_CHECK( layouts.transition( 0u, VK_REMAINING_MIP_LEVELS, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ).empty( ) );
+    }
+
+
+    void test_partial_transitions( )
+    {
+        SubresourceLayouts layouts{ 4u };
+
+        // Counts past the end are clamped to the chain.
+        auto runs = layouts.transition( 2u, 5u, VK_IMAGE_LAYOUT_GENERAL );
+        COBALT_CHECK( runs.size( ) == 1u && equals( runs[0], 2u, 2u, VK_IMAGE_LAYOUT_UNDEFINED ) );
+        COBALT_CHECK( layouts.layout( 1u ) == VK_IMAGE_LAYOUT_UNDEFINED );
+        COBALT_CHECK( layouts.layout( 3u ) == VK_IMAGE_LAYOUT_GENERAL );
+
+        // Alternating layouts split into a run each.
+        static_cast<void>( layouts.transition( 1u, 1u, VK_IMAGE_LAYOUT_GENERAL ) );
+        static_cast<void>( layouts.transition( 2u, 1u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ) );
+        runs = layouts.transition( 0u, VK_REMAINING_MIP_LEVELS, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+        COBALT_CHECK( runs.size( ) == 4u );
+
+        // Discarding the contents starts over from UNDEFINED.
+        layouts.reset( );
+        runs = layouts.transition( 0u, VK_REMAINING_MIP_LEVELS, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+        COBALT_CHECK( runs.size( ) == 1u && equals( runs[0], 0u, 4u, VK_IMAGE_LAYOUT_UNDEFINED ) );
+    }
+
+}
+
+
+int main( )
+{
+    test_mip_levels( );
+    test_mip_extents( );
+    test_mip_generation_barriers( );
+    test_partial_transitions( );
+    return cobalt::test::result( );
+}
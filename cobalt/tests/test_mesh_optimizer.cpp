@@ -0,0 +1,155 @@
+// Vertex cache and fetch optimization on a known mesh, and the choice of 16-bit indices.
+#include "check.h"
+
+#include <__model/mesh_optimizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+
+    constexpr uint32_t GRID_SIZE{ 64u };
+    constexpr uint32_t GRID_VERTEX_COUNT{ ( GRID_SIZE + 1u ) * ( GRID_SIZE + 1u ) };
+
+
+    // Regular grid of GRID_SIZE x GRID_SIZE quads, two triangles each, emitted row by row.
+    std::vector<uint32_t> make_grid( )
+    {
+        std::vector<uint32_t> indices{};
+        for ( uint32_t y{}; y < GRID_SIZE; ++y )
+        {
+            for ( uint32_t x{}; x < GRID_SIZE; ++x )
+            {
+                uint32_t const corner = y * ( GRID_SIZE + 1u ) + x;
+                uint32_t const below  = corner + GRID_SIZE + 1u;
+                indices.insert( indices.end( ), { corner, below, corner + 1u, corner + 1u, below, below + 1u } );
+            }
+        }
+        return indices;
+    }
+
+
+    // Same triangles in random order, the worst case the cache optimizer has to recover from.
+    std::vector<uint32_t> shuffle_triangles( std::vector<uint32_t> const& indices )
+    {
+        std::vector<std::array<uint32_t, 3u>> triangles{};
+        for ( size_t i{}; i < indices.size( ); i += 3u )
+        {
+            triangles.push_back( { indices[i], indices[i + 1u], indices[i + 2u] } );
+        }
+        std::ranges::shuffle( triangles, std::mt19937{ 42u } );
+
+        std::vector<uint32_t> shuffled{};
+        for ( auto const& triangle : triangles )
+        {
+            shuffled.insert( shuffled.end( ), triangle.begin( ), triangle.end( ) );
+        }
+        return shuffled;
+    }
+
+
+    // Triangles as sorted vertex triplets, to compare meshes regardless of triangle order and winding rotation.
+    std::vector<std::array<uint32_t, 3u>> sorted_triangles( std::vector<uint32_t> const& indices )
+    {
+        std::vector<std::array<uint32_t, 3u>> triangles{};
+        for ( size_t i{}; i < indices.size( ); i += 3u )
+        {
+            std::array<uint32_t, 3u> triangle{ indices[i], indices[i + 1u], indices[i + 2u] };
+            std::ranges::sort( triangle );
+            triangles.push_back( triangle );
+        }
+        std::ranges::sort( triangles );
+        return triangles;
+    }
+
+
+    void check_cache_optimization( char const* name, std::vector<uint32_t> indices )
+    {
+        std::vector<uint32_t> const original = indices;
+        float const acmr_before = mesh::calculate_acmr( indices, GRID_VERTEX_COUNT );
+
+        mesh::optimize_vertex_cache( indices, GRID_VERTEX_COUNT );
+        float const acmr_after = mesh::calculate_acmr( indices, GRID_VERTEX_COUNT );
+        std::printf( "%s: ACMR %.3f -> %.3f\n", name, acmr_before, acmr_after );
+
+        COBALT_CHECK( acmr_after <= acmr_before );
+        COBALT_CHECK( sorted_triangles( indices ) == sorted_triangles( original ) );
+
+        // Every vertex is transformed at least once, a grid cannot go below that.
+        COBALT_CHECK( acmr_after >= static_cast<float>( GRID_VERTEX_COUNT ) / static_cast<float>( original.size( ) / 3u ) );
+    }
+
+
+    void test_vertex_cache( )
+    {
+        std::vector<uint32_t> const grid = make_grid( );
+        check_cache_optimization( "row order", grid );
+        check_cache_optimization( "shuffled", shuffle_triangles( grid ) );
+
+        // A shuffled grid misses on nearly every vertex, the optimizer must get it well below one miss per triangle.
+        std::vector<uint32_t> shuffled = shuffle_triangles( grid );
+        COBALT_CHECK( mesh::calculate_acmr( shuffled, GRID_VERTEX_COUNT ) > 2.f );
+        mesh::optimize_vertex_cache( shuffled, GRID_VERTEX_COUNT );
+        COBALT_CHECK( mesh::calculate_acmr( shuffled, GRID_VERTEX_COUNT ) < .8f );
+    }
+
+
+    void test_vertex_fetch( )
+    {
+        std::vector<uint32_t> indices = shuffle_triangles( make_grid( ) );
+        mesh::optimize_vertex_cache( indices, GRID_VERTEX_COUNT );
+        std::vector<uint32_t> const before = indices;
+        float const acmr_before = mesh::calculate_acmr( indices, GRID_VERTEX_COUNT );
+
+        // One unused vertex past the grid must be dropped by the remap.
+        std::vector<uint32_t> const remap = mesh::optimize_vertex_fetch( indices, GRID_VERTEX_COUNT + 1u );
+        COBALT_CHECK( remap[GRID_VERTEX_COUNT] == mesh::UNUSED_VERTEX );
+
+        // Renumbering keeps the triangles and their order, so the cache behaves the same.
+        bool remapped{ true };
+        for ( size_t i{}; i < indices.size( ); ++i )
+        {
+            remapped &= indices[i] == remap[before[i]];
+        }
+        COBALT_CHECK( remapped );
+        COBALT_CHECK( mesh::calculate_acmr( indices, GRID_VERTEX_COUNT ) == acmr_before );
+
+        // Vertices are numbered in the order they are first referenced.
+        uint32_t next_vertex{ 0u };
+        bool sequential{ true };
+        for ( uint32_t const index : indices )
+        {
+            sequential &= index <= next_vertex;
+            next_vertex = std::max( next_vertex, index + 1u );
+        }
+        COBALT_CHECK( sequential );
+        COBALT_CHECK( next_vertex == GRID_VERTEX_COUNT );
+    }
+
+
+    void test_short_indices( )
+    {
+        // Below 65,536 vertices every index fits in 16 bits without reaching the primitive restart value.
+        COBALT_CHECK( mesh::fits_short_indices( 0u ) );
+        COBALT_CHECK( mesh::fits_short_indices( 3u ) );
+        COBALT_CHECK( mesh::fits_short_indices( 65'535u ) );
+        COBALT_CHECK( not mesh::fits_short_indices( 65'536u ) );
+        COBALT_CHECK( not mesh::fits_short_indices( 1'000'000u ) );
+    }
+
+}
+
+
+int main( )
+{
+    test_vertex_cache( );
+    test_vertex_fetch( );
+    test_short_indices( );
+    return cobalt::test::result( );
+}
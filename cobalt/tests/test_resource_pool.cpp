@@ -0,0 +1,225 @@
+// Stale handles must throw instead of being dereferenced, validation is on for the whole test. Debug builds of the library
+// already define it.
+#ifndef COBALT_ENABLE_HANDLE_VALIDATION
+#define COBALT_ENABLE_HANDLE_VALIDATION
+#endif
+
+#include "check.h"
+
+#include <__cleanup/DeletionQueue.h>
+#include <__memory/handle/ResourceHandle.h>
+#include <__memory/handle/ResourcePool.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+
+    struct Tracked
+    {
+        static inline int live_count{ 0 };
+
+        int value{ 0 };
+
+        explicit Tracked( int const value )
+            : value{ value }
+        {
+            ++live_count;
+        }
+
+        ~Tracked( )
+        {
+            --live_count;
+        }
+
+        Tracked( Tracked const& )            = delete;
+        Tracked& operator=( Tracked const& ) = delete;
+    };
+
+
+    struct Entry
+    {
+        memory::RedirectionInfo info{};
+        int value{ 0 };
+    };
+
+
+    template <typename exception_t>
+    bool throws_on_at( memory::ResourcePool<Tracked> const& pool, memory::RedirectionInfo const& info )
+    {
+        try
+        {
+            static_cast<void>( pool.at( info ) );
+        }
+        catch ( exception_t const& )
+        {
+            return true;
+        }
+        return false;
+    }
+
+
+    void test_emplace_and_retire( )
+    {
+        memory::ResourcePool<Tracked> pool{};
+
+        auto const first  = pool.emplace( 0u, 1 );
+        auto const second = pool.emplace( 1u, 2 );
+        COBALT_CHECK( pool.size( ) == 2u );
+        COBALT_CHECK( pool.at( first ).value == 1 );
+        COBALT_CHECK( pool.at( second ).value == 2 );
+
+        // Without a deletion queue retiring destroys right away, and the slot is reused under a new generation.
+        pool.retire( first );
+        COBALT_CHECK( Tracked::live_count == 1 );
+        COBALT_CHECK( not pool.alive( first ) );
+        COBALT_CHECK( throws_on_at<std::runtime_error>( pool, first ) );
+
+        auto const third = pool.emplace( 2u, 3 );
+        COBALT_CHECK( third.index == first.index );
+        COBALT_CHECK( third.generation != first.generation );
+        COBALT_CHECK( pool.at( third ).value == 3 );
+        COBALT_CHECK( throws_on_at<std::runtime_error>( pool, first ) );
+
+        COBALT_CHECK( throws_on_at<std::out_of_range>( pool, memory::RedirectionInfo{ .index = 1000u, .generation = 0u } ) );
+    }
+
+
+    void test_deferred_destruction( )
+    {
+        cleanup::DeletionQueue queue{};
+        memory::ResourcePool<Tracked> pool{ &queue };
+
+        queue.advance( 1u );
+        auto const info = pool.emplace( 0u, 7 );
+        pool.retire( info );
+
+        // Stale right away, but only destroyed once its frame has completed.
+        COBALT_CHECK( not pool.alive( info ) );
+        COBALT_CHECK( throws_on_at<std::runtime_error>( pool, info ) );
+        COBALT_CHECK( Tracked::live_count == 1 );
+
+        queue.collect( 0u );
+        COBALT_CHECK( Tracked::live_count == 1 );
+        queue.collect( 1u );
+        COBALT_CHECK( Tracked::live_count == 0 );
+        COBALT_CHECK( pool.size( ) == 0u );
+    }
+
+
+    void test_handle_ownership( )
+    {
+        memory::ResourcePool<Tracked> pool{};
+
+        ResourceHandle<Tracked> handle{ pool, pool.emplace( 0u, 5 ) };
+        {
+            ResourceHandle<Tracked> copy{ handle };
+            COBALT_CHECK( copy->value == 5 );
+            // Assigning a handle to itself must not drop its only other owner.
+            ResourceHandle<Tracked> const& alias = copy;
+            copy = alias;
+            COBALT_CHECK( copy.valid( ) );
+        }
+        COBALT_CHECK( handle.valid( ) );
+
+        ResourceHandle<Tracked> other{ handle };
+        handle.reset( );
+        COBALT_CHECK( other.valid( ) );
+        COBALT_CHECK( Tracked::live_count == 1 );
+
+        // Releasing retires regardless of the remaining owners, which go stale.
+        ResourceHandle<Tracked> last{ other };
+        other.release( );
+        COBALT_CHECK( not last.valid( ) );
+        COBALT_CHECK( Tracked::live_count == 0 );
+    }
+
+
+    // Random interleaving of creation, retiring and lookups, checked against a plain list of what should be alive.
+    void test_randomized( )
+    {
+        cleanup::DeletionQueue queue{};
+        memory::ResourcePool<Tracked> pool{ &queue };
+
+        std::mt19937 rng{ 1234u };
+        std::vector<Entry> live{};
+        std::vector<memory::RedirectionInfo> stale{};
+
+        int next_value{ 0 };
+        uint64_t frame{ 0u };
+        for ( int step{}; step < 100'000; ++step )
+        {
+            switch ( rng( ) % 8u )
+            {
+                case 0:
+                case 1:
+                case 2:
+                    live.push_back( Entry{ .info = pool.emplace( static_cast<uint64_t>( step ), next_value ), .value = next_value } );
+                    ++next_value;
+                    break;
+
+                case 3:
+                case 4:
+                    if ( not live.empty( ) )
+                    {
+                        size_t const pick = rng( ) % live.size( );
+                        pool.retire( live[pick].info );
+                        stale.push_back( live[pick].info );
+                        live[pick] = live.back( );
+                        live.pop_back( );
+                    }
+                    break;
+
+                case 5:
+                    // Two frames in flight, the one before last has completed.
+                    queue.advance( ++frame );
+                    if ( frame >= 2u )
+                    {
+                        queue.collect( frame - 2u );
+                    }
+                    break;
+
+                default:
+                    if ( not live.empty( ) )
+                    {
+                        Entry const& entry = live[rng( ) % live.size( )];
+                        COBALT_CHECK( pool.alive( entry.info ) );
+                        COBALT_CHECK( pool.at( entry.info ).value == entry.value );
+                    }
+                    if ( not stale.empty( ) )
+                    {
+                        auto const& info = stale[rng( ) % stale.size( )];
+                        COBALT_CHECK( not pool.alive( info ) );
+                        COBALT_CHECK( throws_on_at<std::runtime_error>( pool, info ) );
+                    }
+                    break;
+            }
+            // Retired resources are counted until they are destroyed.
+            COBALT_CHECK( pool.size( ) >= live.size( ) );
+        }
+
+        for ( auto const& [info, value] : live )
+        {
+            COBALT_CHECK( pool.at( info ).value == value );
+        }
+
+        queue.flush( );
+        COBALT_CHECK( pool.size( ) == live.size( ) );
+        COBALT_CHECK( Tracked::live_count == static_cast<int>( live.size( ) ) );
+    }
+
+}
+
+
+int main( )
+{
+    test_emplace_and_retire( );
+    test_deferred_destruction( );
+    test_handle_ownership( );
+    test_randomized( );
+    return cobalt::test::result( );
+}
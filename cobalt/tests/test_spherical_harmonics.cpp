@@ -0,0 +1,190 @@
+// SH9 irradiance against the convolution the irradiance cubemap stores, on synthetic equirectangular environments.
+#include "check.h"
+
+#include <__image/SphericalHarmonics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+
+    constexpr uint32_t ENVIRONMENT_WIDTH{ 512u };
+    constexpr uint32_t ENVIRONMENT_HEIGHT{ 256u };
+    constexpr float PI{ std::numbers::pi_v<float> };
+
+    using radiance_fn_t = std::function<glm::vec3( glm::vec3 const& )>;
+
+
+    struct Environment
+    {
+        std::vector<float> rgba{};
+
+        // Nearest texel in the direction, the same mapping as sample_spherical_map in the shaders.
+        [[nodiscard]] glm::vec3 sample( glm::vec3 const& direction ) const
+        {
+            float const u = std::atan2( direction.z, direction.x ) / ( 2.f * PI ) + .5f;
+            float const v = std::asin( std::clamp( direction.y, -1.f, 1.f ) ) / PI + .5f;
+            auto const x = std::min( static_cast<uint32_t>( u * ENVIRONMENT_WIDTH ), ENVIRONMENT_WIDTH - 1u );
+            auto const y = std::min( static_cast<uint32_t>( v * ENVIRONMENT_HEIGHT ), ENVIRONMENT_HEIGHT - 1u );
+            float const* texel = rgba.data( ) + ( static_cast<size_t>( y ) * ENVIRONMENT_WIDTH + x ) * 4u;
+            return glm::vec3{ texel[0], texel[1], texel[2] };
+        }
+    };
+
+
+    Environment make_environment( radiance_fn_t const& radiance )
+    {
+        Environment environment{ .rgba = std::vector<float>( ENVIRONMENT_WIDTH * ENVIRONMENT_HEIGHT * 4u ) };
+        for ( uint32_t y{}; y < ENVIRONMENT_HEIGHT; ++y )
+        {
+            float const elevation = ( ( static_cast<float>( y ) + .5f ) / ENVIRONMENT_HEIGHT - .5f ) * PI;
+            for ( uint32_t x{}; x < ENVIRONMENT_WIDTH; ++x )
+            {
+                float const azimuth = ( ( static_cast<float>( x ) + .5f ) / ENVIRONMENT_WIDTH - .5f ) * 2.f * PI;
+                glm::vec3 const direction{
+                    std::cos( elevation ) * std::cos( azimuth ), std::sin( elevation ), std::cos( elevation ) * std::sin( azimuth )
+                };
+                glm::vec3 const value = radiance( direction );
+
+                float* texel = environment.rgba.data( ) + ( static_cast<size_t>( y ) * ENVIRONMENT_WIDTH + x ) * 4u;
+                texel[0] = value.x;
+                texel[1] = value.y;
+                texel[2] = value.z;
+                texel[3] = 1.f;
+            }
+        }
+        return environment;
+    }
+
+
+    // The hemisphere integration of irradiance_sampling.frag, with the same step, sampling the environment directly.
+    glm::vec3 convolve_irradiance( Environment const& environment, glm::vec3 const& normal )
+    {
+        glm::vec3 const up = std::abs( normal.z ) < .999f ? glm::vec3{ 0.f, 0.f, 1.f } : glm::vec3{ 0.f, 1.f, 0.f };
+        glm::vec3 const tangent   = glm::normalize( glm::cross( up, normal ) );
+        glm::vec3 const bitangent = glm::cross( normal, tangent );
+
+        constexpr float sample_delta{ .025f };
+        glm::vec3 irradiance{ 0.f };
+        float sample_count{ 0.f };
+        for ( float phi{ 0.f }; phi < 2.f * PI; phi += sample_delta )
+        {
+            for ( float theta{ 0.f }; theta < .5f * PI; theta += sample_delta )
+            {
+                glm::vec3 const direction = tangent * ( std::sin( theta ) * std::cos( phi ) ) +
+                                            bitangent * ( std::sin( theta ) * std::sin( phi ) ) +
+                                            normal * std::cos( theta );
+                irradiance += environment.sample( glm::normalize( direction ) ) * ( std::cos( theta ) * std::sin( theta ) );
+                ++sample_count;
+            }
+        }
+        return irradiance * ( PI / sample_count );
+    }
+
+
+    // Evenly spread over the sphere, plus the axes where the cubemap faces are centered.
+    std::vector<glm::vec3> make_normals( )
+    {
+        std::vector<glm::vec3> normals{
+            { 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f }
+        };
+        constexpr uint32_t fibonacci_count{ 58u };
+        float const golden_angle = PI * ( 3.f - std::sqrt( 5.f ) );
+        for ( uint32_t i{}; i < fibonacci_count; ++i )
+        {
+            float const y = 1.f - 2.f * ( static_cast<float>( i ) + .5f ) / fibonacci_count;
+            float const radius = std::sqrt( 1.f - y * y );
+            float const angle = golden_angle * static_cast<float>( i );
+            normals.emplace_back( radius * std::cos( angle ), y, radius * std::sin( angle ) );
+        }
+        return normals;
+    }
+
+
+    struct Error
+    {
+        float max_relative{ 0.f };
+        float mean_relative{ 0.f };
+    };
+
+
+    // Errors per channel, relative to the largest irradiance of the environment so dark directions do not dominate.
+    Error compare( radiance_fn_t const& radiance )
+    {
+        Environment const environment = make_environment( radiance );
+        image::SH9Irradiance const sh = image::project_irradiance_sh9( environment.rgba, ENVIRONMENT_WIDTH, ENVIRONMENT_HEIGHT );
+
+        std::vector<glm::vec3> const normals = make_normals( );
+        std::vector<glm::vec3> expected{};
+        float peak{ 0.f };
+        for ( glm::vec3 const& normal : normals )
+        {
+            expected.push_back( convolve_irradiance( environment, normal ) );
+            peak = std::max( { peak, expected.back( ).x, expected.back( ).y, expected.back( ).z } );
+        }
+
+        Error error{};
+        for ( size_t i{}; i < normals.size( ); ++i )
+        {
+            glm::vec3 const difference = glm::abs( image::evaluate_irradiance_sh9( sh, normals[i] ) - expected[i] ) / peak;
+            float const worst = std::max( { difference.x, difference.y, difference.z } );
+            error.max_relative = std::max( error.max_relative, worst );
+            error.mean_relative += ( difference.x + difference.y + difference.z ) / 3.f;
+        }
+        error.mean_relative /= static_cast<float>( normals.size( ) );
+
+        std::printf( "max error %.4f, mean error %.4f\n", error.max_relative, error.mean_relative );
+        return error;
+    }
+
+
+    void test_constant( )
+    {
+        Error const error = compare( []( glm::vec3 const& ) { return glm::vec3{ 1.f, .5f, .25f }; } );
+        COBALT_CHECK( error.max_relative < .01f );
+    }
+
+
+    void test_low_frequency( )
+    {
+        // Bands 0 to 2 only, which SH9 represents exactly: what is left is the discretization of either side.
+        Error const error = compare( []( glm::vec3 const& d )
+            {
+                float const value = .6f + .3f * d.y + .2f * d.x + .25f * d.x * d.z + .15f * ( 3.f * d.y * d.y - 1.f );
+                return glm::vec3{ value, value * .8f, .5f + .4f * d.z };
+            } );
+        COBALT_CHECK( error.max_relative < .01f );
+    }
+
+
+    void test_sun_and_sky( )
+    {
+        // A small bright source is where the truncation to 9 coefficients shows, irradiance still stays close on average.
+        glm::vec3 const sun = glm::normalize( glm::vec3{ .3f, .8f, .5f } );
+        Error const error = compare( [sun]( glm::vec3 const& d )
+            {
+                float const sky = .2f + .3f * std::max( d.y, 0.f );
+                float const disc = std::pow( std::max( glm::dot( d, sun ), 0.f ), 64.f ) * 20.f;
+                return glm::vec3{ sky + disc, sky + disc * .9f, sky * 1.5f + disc * .7f };
+            } );
+        COBALT_CHECK( error.max_relative < .06f );
+        COBALT_CHECK( error.mean_relative < .025f );
+    }
+
+}
+
+
+int main( )
+{
+    test_constant( );
+    test_low_frequency( );
+    test_sun_and_sky( );
+    return cobalt::test::result( );
+}
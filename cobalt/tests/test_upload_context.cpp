@@ -0,0 +1,298 @@
+// Batched uploads through UploadContext on a real device, read back and compared with what was staged, mip levels with
+// a CPU box filter. Needs a Vulkan 1.3 device and a display for the window surface, e.g. lavapipe under xvfb-run.
+#include "check.h"
+
+#include <__buffer/Buffer.h>
+#include <__buffer/CommandBuffer.h>
+#include <__buffer/CommandOperator.h>
+#include <__buffer/CommandPool.h>
+#include <__buffer/StagingRing.h>
+#include <__buffer/UploadContext.h>
+#include <__context/DeviceSet.h>
+#include <__context/Queue.h>
+#include <__context/VkContext.h>
+#include <__context/Window.h>
+#include <__image/Image.h>
+#include <__synchronization/SubmitInfo.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    using namespace cobalt;
+
+    constexpr VkExtent2D IMAGE_EXTENT{ 64u, 64u };
+
+    // Linear blits may round each channel either way, more than this is a wrong filter or a wrong region.
+    constexpr uint32_t MIP_CHANNEL_TOLERANCE{ 1u };
+
+
+    Buffer make_destination_buffer( DeviceSet const& device, VkDeviceSize const size )
+    {
+        return Buffer{
+            device, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        };
+    }
+
+
+    Image make_destination_image( DeviceSet const& device, uint32_t const mip_levels )
+    {
+        return Image{
+            device, ImageCreateInfo{
+                .extent = IMAGE_EXTENT,
+                .format = VK_FORMAT_R8G8B8A8_UNORM,
+                .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mip_levels = mip_levels
+            }
+        };
+    }
+
+
+    std::vector<uint32_t> make_payload( size_t const count, uint32_t const seed )
+    {
+        std::vector<uint32_t> payload( count );
+        std::iota( payload.begin( ), payload.end( ), seed );
+        return payload;
+    }
+
+
+    // Gradients along both axes and a product term, so every 2x2 block averages to something else and shifting a blit
+    // region by a texel changes the result.
+    std::vector<uint32_t> make_texels( VkExtent2D const extent )
+    {
+        std::vector<uint32_t> texels( extent.width * extent.height );
+        for ( uint32_t y{}; y < extent.height; ++y )
+        {
+            for ( uint32_t x{}; x < extent.width; ++x )
+            {
+                uint32_t const r = x * 8u & 0xffu;
+                uint32_t const g = y * 4u & 0xffu;
+                uint32_t const b = x * y * 7u & 0xffu;
+                texels[y * extent.width + x] = 0xff'00'00'00u | b << 16u | g << 8u | r;
+            }
+        }
+        return texels;
+    }
+
+
+    // CPU reference of the next level: every channel averaged over each 2x2 block, which is what a linear blit to half
+    // the extent samples.
+    std::vector<uint32_t> box_filter( std::vector<uint32_t> const& texels, VkExtent2D const extent )
+    {
+        VkExtent2D const half{ std::max( extent.width / 2u, 1u ), std::max( extent.height / 2u, 1u ) };
+        std::vector<uint32_t> filtered( half.width * half.height );
+        for ( uint32_t y{}; y < half.height; ++y )
+        {
+            for ( uint32_t x{}; x < half.width; ++x )
+            {
+                uint32_t const x0 = std::min( x * 2u, extent.width - 1u );
+                uint32_t const x1 = std::min( x * 2u + 1u, extent.width - 1u );
+                uint32_t const y0 = std::min( y * 2u, extent.height - 1u );
+                uint32_t const y1 = std::min( y * 2u + 1u, extent.height - 1u );
+
+                uint32_t texel{};
+                for ( uint32_t shift{}; shift < 32u; shift += 8u )
+                {
+                    uint32_t const sum = ( texels[y0 * extent.width + x0] >> shift & 0xffu ) +
+                                         ( texels[y0 * extent.width + x1] >> shift & 0xffu ) +
+                                         ( texels[y1 * extent.width + x0] >> shift & 0xffu ) +
+                                         ( texels[y1 * extent.width + x1] >> shift & 0xffu );
+                    texel |= ( sum + 2u ) / 4u << shift;
+                }
+                filtered[y * half.width + x] = texel;
+            }
+        }
+        return filtered;
+    }
+
+
+    bool texels_match( std::vector<uint32_t> const& actual, std::vector<uint32_t> const& expected,
+                       uint32_t const tolerance )
+    {
+        if ( actual.size( ) != expected.size( ) )
+        {
+            return false;
+        }
+        for ( size_t index{}; index < actual.size( ); ++index )
+        {
+            for ( uint32_t shift{}; shift < 32u; shift += 8u )
+            {
+                auto const lhs = static_cast<int32_t>( actual[index] >> shift & 0xffu );
+                auto const rhs = static_cast<int32_t>( expected[index] >> shift & 0xffu );
+                if ( static_cast<uint32_t>( std::abs( lhs - rhs ) ) > tolerance )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+
+    std::vector<uint32_t> read_back( DeviceSet const& device, CommandPool& cmd_pool, Buffer const& src )
+    {
+        Buffer readback = buffer::make_readback_buffer( device, src.buffer_size( ) );
+        src.copy_to( readback, cmd_pool );
+
+        std::vector<uint32_t> data( src.buffer_size( ) / sizeof( uint32_t ) );
+        readback.map_memory( );
+        readback.read( data.data( ), data.size( ) * sizeof( uint32_t ) );
+        readback.unmap_memory( );
+        return data;
+    }
+
+
+    std::vector<uint32_t> read_back( DeviceSet const& device, CommandPool& cmd_pool, Image& src, uint32_t const mip_level )
+    {
+        VkExtent2D const extent = image::calculate_mip_extent( src.extent( ), mip_level );
+        Buffer readback = buffer::make_readback_buffer( device, extent.width * extent.height * sizeof( uint32_t ) );
+
+        // 1. Record the copy of the level into the host visible buffer.
+        auto const& cmd_buffer = cmd_pool.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+        cmd_buffer.reset( 0 );
+        {
+            auto const cmd_operator = cmd_buffer.command_operator( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT );
+            src.transition_layout( { VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL }, cmd_operator );
+            VkBufferImageCopy const region{
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = mip_level,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+                .imageExtent = { extent.width, extent.height, 1 }
+            };
+            cmd_operator.copy_image_to_buffer( src, readback, { &region, 1u } );
+        }
+
+        // 2. Submit and wait, then pull the texels out.
+        device.graphics_queue( ).submit_and_wait( sync::SubmitInfo{ device.device_index( ) }.execute( cmd_buffer ) );
+        cmd_buffer.unlock( );
+
+        std::vector<uint32_t> data( extent.width * extent.height );
+        readback.map_memory( );
+        readback.read( data.data( ), data.size( ) * sizeof( uint32_t ) );
+        readback.unmap_memory( );
+        return data;
+    }
+
+
+    // One batch mixing ring staged buffers, a payload too large for the ring and a mip mapped texture.
+    void test_batched_upload( DeviceSet const& device, CommandPool& cmd_pool )
+    {
+        size_t const large_count = device.staging_ring( ).capacity( ) / sizeof( uint32_t ) + 1024u;
+        std::vector<uint32_t> const small_payload = make_payload( 4096u, 1u );
+        std::vector<uint32_t> const other_payload = make_payload( 1000u, 1'000'000u );
+        std::vector<uint32_t> const large_payload = make_payload( large_count, 7u );
+        std::vector<uint32_t> const texels = make_texels( IMAGE_EXTENT );
+
+        Buffer const small_buffer = make_destination_buffer( device, small_payload.size( ) * sizeof( uint32_t ) );
+        Buffer const other_buffer = make_destination_buffer( device, other_payload.size( ) * sizeof( uint32_t ) );
+        Buffer const large_buffer = make_destination_buffer( device, large_payload.size( ) * sizeof( uint32_t ) );
+        uint32_t const mip_levels = image::calculate_mip_levels( IMAGE_EXTENT );
+        Image texture = make_destination_image( device, mip_levels );
+
+        UploadTicket ticket = [&]
+        {
+            UploadContext upload_context{ device, cmd_pool };
+            upload_context.upload( small_buffer, small_payload.data( ), small_buffer.buffer_size( ) );
+            upload_context.upload( other_buffer, other_payload.data( ), other_buffer.buffer_size( ) );
+            upload_context.upload( large_buffer, large_payload.data( ), large_buffer.buffer_size( ) );
+            upload_context.upload( texture, texels.data( ), texels.size( ) * sizeof( uint32_t ) );
+            return upload_context.submit( );
+        }( );
+        ticket.wait( );
+        COBALT_CHECK( ticket.ready( ) );
+
+        COBALT_CHECK( read_back( device, cmd_pool, small_buffer ) == small_payload );
+        COBALT_CHECK( read_back( device, cmd_pool, other_buffer ) == other_payload );
+        COBALT_CHECK( read_back( device, cmd_pool, large_buffer ) == large_payload );
+
+        // Level 0 holds the upload, every other level is compared with a box filter of the level above as read back. A
+        // skipped level, a nearest filter or a blit region off by a texel all land outside the tolerance.
+        std::vector<uint32_t> expected = texels;
+        for ( uint32_t level{}; level < mip_levels; ++level )
+        {
+            VkExtent2D const extent = image::calculate_mip_extent( IMAGE_EXTENT, level );
+            COBALT_CHECK( extent.width == std::max( IMAGE_EXTENT.width >> level, 1u ) );
+            COBALT_CHECK( extent.height == std::max( IMAGE_EXTENT.height >> level, 1u ) );
+
+            std::vector<uint32_t> const actual = read_back( device, cmd_pool, texture, level );
+            COBALT_CHECK( texels_match( actual, expected, level == 0u ? 0u : MIP_CHANNEL_TOLERANCE ) );
+            expected = box_filter( actual, extent );
+        }
+    }
+
+
+    // Batches in flight together hold their own ring regions, the space is only reclaimed once both are waited on.
+    void test_overlapping_batches( DeviceSet const& device, CommandPool& cmd_pool )
+    {
+        std::vector<uint32_t> const first_payload  = make_payload( 1u << 20u, 3u );
+        std::vector<uint32_t> const second_payload = make_payload( 1u << 20u, 5u );
+        Buffer const first_buffer  = make_destination_buffer( device, first_payload.size( ) * sizeof( uint32_t ) );
+        Buffer const second_buffer = make_destination_buffer( device, second_payload.size( ) * sizeof( uint32_t ) );
+
+        std::vector<UploadTicket> tickets{};
+        for ( auto const& [buffer, payload] : { std::pair{ &first_buffer, &first_payload },
+                                                std::pair{ &second_buffer, &second_payload } } )
+        {
+            UploadContext upload_context{ device, cmd_pool };
+            upload_context.upload( *buffer, payload->data( ), buffer->buffer_size( ) );
+            tickets.push_back( upload_context.submit( ) );
+        }
+        for ( UploadTicket& ticket : tickets )
+        {
+            ticket.wait( );
+        }
+
+        COBALT_CHECK( read_back( device, cmd_pool, first_buffer ) == first_payload );
+        COBALT_CHECK( read_back( device, cmd_pool, second_buffer ) == second_payload );
+    }
+
+
+    // Optional features do not rule the device out, they are enabled exactly when it supports them.
+    void test_optional_features( DeviceSet const& device )
+    {
+        VkPhysicalDeviceFeatures features{};
+        vkGetPhysicalDeviceFeatures( device.physical( ), &features );
+        COBALT_CHECK( device.has_feature( DeviceFeatureFlags::TEXTURE_COMPRESSION_BC ) ==
+                      ( features.textureCompressionBC == VK_TRUE ) );
+    }
+
+}
+
+
+int main( )
+{
+    constexpr VkApplicationInfo app_info{
+        .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pApplicationName = "test_upload_context",
+        .applicationVersion = VK_MAKE_VERSION( 1, 0, 0 ),
+        .pEngineName = "Cobalt",
+        .engineVersion = VK_MAKE_VERSION( 1, 0, 0 ),
+        .apiVersion = VK_API_VERSION_1_3
+    };
+
+    Window const window{ IMAGE_EXTENT.width, IMAGE_EXTENT.height, "test_upload_context" };
+    VkContext const context{
+        ContextWizard{ { &window, app_info } }
+        .with<DeviceFeatureFlags>( DeviceFeatureFlags::SYNCHRONIZATION_2_EXT )
+        .with<OptionalDeviceFeatures>( OptionalDeviceFeatures{ DeviceFeatureFlags::TEXTURE_COMPRESSION_BC } )
+    };
+    test_optional_features( context.device( ) );
+    {
+        CommandPool cmd_pool{ context, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT };
+        test_batched_upload( context.device( ), cmd_pool );
+        test_overlapping_batches( context.device( ), cmd_pool );
+        context.device( ).wait_idle( );
+    }
+    return cobalt::test::result( );
+}